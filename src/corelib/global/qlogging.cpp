@@ -21,6 +21,8 @@
 #include "qdatetime.h"
 #include "qcoreapplication.h"
 #include "qthread.h"
+#include "qwaitcondition.h"
+#include "private/qbinarylog_p.h"
 #include "private/qloggingregistry_p.h"
 #include "private/qcoreapplication_p.h"
 #include <qtcore_tracepoints_p.h>
@@ -121,6 +123,7 @@ static QT_PREPEND_NAMESPACE(qint64) qt_gettid()
 
 #include <cstdlib>
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -172,6 +175,9 @@ Q_NORETURN
 #endif
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, String &&message);
 static void qt_message_print(QtMsgType, const QMessageLogContext &context, const QString &message);
+static void qt_message_print_text(QtMsgType, const QMessageLogContext &context, const QString &message);
+static bool qt_message_write_binary(QtMsgType msgType, const QMessageLogContext &context,
+                                    const char *msg, va_list ap);
 static void preformattedMessageHandler(QtMsgType type, const QMessageLogContext &context,
                                        const QString &formattedMessage);
 static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str);
@@ -375,6 +381,17 @@ static inline void convert_to_wchar_t_elided(wchar_t *d, size_t space, const cha
 Q_NEVER_INLINE
 static void qt_message(QtMsgType msgType, const QMessageLogContext &context, const char *msg, va_list ap)
 {
+    if (qt_message_write_binary(msgType, context, msg, ap)) {
+        if (isFatal(msgType)) {
+            // made fatal by QT_FATAL_WARNINGS or QT_FATAL_CRITICALS: print it
+            // like the fatal messages, so that the reason for aborting is seen
+            QString buf = QString::vasprintf(msg, ap);
+            qt_message_print_text(msgType, context, buf);
+            qt_message_fatal(msgType, context, buf);
+        }
+        return;
+    }
+
     QString buf = QString::vasprintf(msg, ap);
     qt_message_print(msgType, context, buf);
 
@@ -1985,6 +2002,350 @@ static void stderr_message_handler(QtMsgType type, const QMessageLogContext &con
     fflush(stderr);
 }
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+namespace {
+/*
+    The asynchronous output to stderr, enabled by setting QT_LOGGING_ASYNC.
+
+    Every thread writes its formatted messages into a ring buffer of its own,
+    without taking any lock, and a writer thread drains all the buffers in the
+    order the messages were logged. When a thread logs faster than the writer
+    can output, its messages are dropped and counted rather than blocking it.
+*/
+class AsyncMessageSink
+{
+public:
+    static constexpr size_t BufferSize = 64 * 1024;     // per thread
+
+    static AsyncMessageSink *instance();
+
+    bool post(const QByteArray &message);
+    bool flush(QDeadlineTimer deadline = QDeadlineTimer::Forever);
+
+    std::atomic<quint64> dropped = 0;
+
+private:
+    struct Record
+    {
+        quint64 sequence;
+        quint32 size;
+    };
+
+    // A single-producer, single-consumer ring buffer of Records followed by
+    // their messages. The consumer is whoever holds the drainMutex.
+    struct Ring
+    {
+        void copyIn(size_t position, const void *src, size_t size) noexcept;
+        void copyOut(size_t position, void *dst, size_t size) const noexcept;
+
+        char data[BufferSize];
+        std::atomic<size_t> head = 0;       // written by the producer
+        std::atomic<size_t> tail = 0;       // written by the consumer
+        std::atomic<quint64> dropped = 0;
+        std::atomic<bool> orphaned = false; // the thread exited
+        Ring *next = nullptr;
+    };
+
+    struct ThreadRing
+    {
+        ~ThreadRing()
+        {
+            if (ring)
+                ring->orphaned.store(true, std::memory_order_release);
+            ring = nullptr;
+            finished = true;
+        }
+        Ring *ring = nullptr;
+        bool finished = false;
+    };
+
+    Ring *threadRing();
+    void wake();
+    void run();
+    bool drain(bool force);
+
+    std::atomic<quint64> sequence = 0;
+    std::atomic<bool> pending = false;
+
+    QMutex ringsMutex;
+    Ring *rings = nullptr;
+
+    QMutex drainMutex;
+    quint64 nextSequence = 0;           // guarded by drainMutex
+    QMutex wakeMutex;
+    QWaitCondition wakeCondition;
+    QThread *writer = nullptr;
+};
+
+Q_CONSTINIT static QBasicAtomicInt asyncMessageOutput = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+void AsyncMessageSink::Ring::copyIn(size_t position, const void *src, size_t size) noexcept
+{
+    const size_t offset = position % BufferSize;
+    const size_t first = qMin(size, BufferSize - offset);
+    memcpy(data + offset, src, first);
+    memcpy(data, static_cast<const char *>(src) + first, size - first);
+}
+
+void AsyncMessageSink::Ring::copyOut(size_t position, void *dst, size_t size) const noexcept
+{
+    const size_t offset = position % BufferSize;
+    const size_t first = qMin(size, BufferSize - offset);
+    memcpy(dst, data + offset, first);
+    memcpy(static_cast<char *>(dst) + first, data, size - first);
+}
+
+/*
+    Returns the sink if the asynchronous output is enabled, and nullptr
+    otherwise. The sink is never destroyed, as the writer thread may still be
+    running when the process exits; the pending messages are written out when
+    static objects are destroyed instead.
+*/
+AsyncMessageSink *AsyncMessageSink::instance()
+{
+    int enabled = asyncMessageOutput.loadRelaxed();
+    if (Q_UNLIKELY(enabled == -1)) {
+        enabled = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC") > 0;
+        if (!asyncMessageOutput.testAndSetRelaxed(-1, enabled))
+            enabled = asyncMessageOutput.loadRelaxed();
+    }
+    if (Q_LIKELY(!enabled))
+        return nullptr;
+
+    static AsyncMessageSink *sink = new AsyncMessageSink;
+    static struct FlushAtExit {
+        ~FlushAtExit()
+        {
+            // the writer thread may have been terminated while draining
+            if (sink->flush(QDeadlineTimer(1000)))
+                asyncMessageOutput.storeRelaxed(0);
+        }
+    } flushAtExit;
+    return sink;
+}
+
+/*
+    Queues \a message, which must end with a newline, for output. Returns
+    \c false if the caller must write it out itself.
+*/
+bool AsyncMessageSink::post(const QByteArray &message)
+{
+    Ring *ring = threadRing();
+    const size_t needed = sizeof(Record) + message.size();
+    if (!ring || needed > BufferSize)
+        return false;
+
+    const size_t head = ring->head.load(std::memory_order_relaxed);
+    const size_t tail = ring->tail.load(std::memory_order_acquire);
+    if (BufferSize - (head - tail) < needed) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        wake();
+        return true;
+    }
+
+    const Record record = { sequence.fetch_add(1, std::memory_order_relaxed),
+                            quint32(message.size()) };
+    ring->copyIn(head, &record, sizeof(record));
+    ring->copyIn(head + sizeof(record), message.constData(), message.size());
+    ring->head.store(head + needed, std::memory_order_release);
+    wake();
+    return true;
+}
+
+AsyncMessageSink::Ring *AsyncMessageSink::threadRing()
+{
+    Q_CONSTINIT static thread_local ThreadRing threadRing;
+    if (Q_LIKELY(threadRing.ring))
+        return threadRing.ring;
+    if (threadRing.finished)
+        return nullptr;
+
+    Ring *ring = new Ring;
+    {
+        QMutexLocker locker(&ringsMutex);
+        ring->next = rings;
+        rings = ring;
+        if (!writer) {
+            writer = QThread::create([this] { run(); });
+            writer->setObjectName("QtLogging"_L1);
+            writer->start();
+        }
+    }
+    threadRing.ring = ring;
+    return ring;
+}
+
+void AsyncMessageSink::wake()
+{
+    if (!pending.exchange(true, std::memory_order_acq_rel)) {
+        QMutexLocker locker(&wakeMutex);
+        wakeCondition.wakeOne();
+    }
+}
+
+void AsyncMessageSink::run()
+{
+    for (;;) {
+        {
+            QMutexLocker locker(&wakeMutex);
+            while (!pending.exchange(false, std::memory_order_acq_rel))
+                wakeCondition.wait(&wakeMutex);
+        }
+        // the thread holding back the rest wakes us up once it queued its message
+        QMutexLocker locker(&drainMutex);
+        drain(false);
+    }
+}
+
+/*
+    Writes out the messages queued by all the threads so far, in the order
+    they were logged. Returns \c false if another thread didn't finish doing
+    the same before \a deadline. If a thread still hasn't queued a message it
+    has started logging when \a deadline expires, the messages logged after it
+    are written out of order instead of being held back.
+*/
+bool AsyncMessageSink::flush(QDeadlineTimer deadline)
+{
+    if (!drainMutex.tryLock(deadline))
+        return false;
+    const auto unlock = qScopeGuard([this] { drainMutex.unlock(); });
+
+    while (!drain(deadline.hasExpired()))
+        QThread::yieldCurrentThread();
+    return true;
+}
+
+/*
+    Writes out the queued messages in the order of their sequence numbers.
+    A thread takes its sequence number before it queues the message, so
+    there may be a gap in the sequence numbers queued so far: unless \a force
+    is \c true, only the messages before the first gap are written, and the
+    rest are left in the rings. Returns \c true if nothing was left.
+
+    Must be called with the drainMutex locked.
+*/
+bool AsyncMessageSink::drain(bool force)
+{
+    struct Pending
+    {
+        quint64 sequence;
+        qsizetype ring;
+        size_t position;
+        quint32 size;
+    };
+    QVarLengthArray<Pending, 256> messages;
+    QVarLengthArray<std::pair<Ring *, size_t>, 16> tails;
+    quint64 droppedNow = 0;
+    {
+        QMutexLocker locker(&ringsMutex);
+        for (Ring **link = &rings; *link; ) {
+            Ring *ring = *link;
+            const bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+            const size_t head = ring->head.load(std::memory_order_acquire);
+            size_t position = ring->tail.load(std::memory_order_relaxed);
+            if (orphaned && position == head) {
+                *link = ring->next;
+                delete ring;
+                continue;
+            }
+            tails.append({ ring, position });
+            while (position != head) {
+                Record record;
+                ring->copyOut(position, &record, sizeof(record));
+                messages.append({ record.sequence, tails.size() - 1, position, record.size });
+                position += sizeof(record) + record.size;
+            }
+            droppedNow += ring->dropped.exchange(0, std::memory_order_relaxed);
+            link = &ring->next;
+        }
+    }
+
+    std::sort(messages.begin(), messages.end(), [](const Pending &a, const Pending &b) {
+        return a.sequence < b.sequence;
+    });
+    // The messages of each ring are in the order of their sequence numbers,
+    // so the ones written out are always at the start of their ring
+    QByteArray output;
+    qsizetype written = 0;
+    for (const Pending &message : std::as_const(messages)) {
+        if (message.sequence > nextSequence && !force)
+            break;
+        auto &[ring, tail] = tails[message.ring];
+        const qsizetype size = output.size();
+        output.resize(size + message.size);
+        ring->copyOut(message.position + sizeof(Record), output.data() + size, message.size);
+        tail = message.position + sizeof(Record) + message.size;
+        nextSequence = qMax(nextSequence, message.sequence + 1);
+        ++written;
+    }
+    if (droppedNow) {
+        dropped.fetch_add(droppedNow, std::memory_order_relaxed);
+        output += "QT_LOGGING_ASYNC: dropped " + QByteArray::number(droppedNow)
+                + " messages because the output couldn't keep up\n";
+    }
+    if (!output.isEmpty()) {
+        fwrite(output.constData(), 1, output.size(), stderr);
+        fflush(stderr);
+    }
+
+    // only now can the producers reuse the space
+    for (const auto &[ring, tail] : std::as_const(tails))
+        ring->tail.store(tail, std::memory_order_release);
+    return written == messages.size();
+}
+} // unnamed namespace
+
+static void stderr_message_output(const QString &formattedMessage)
+{
+    if (formattedMessage.isNull())
+        return;
+    if (AsyncMessageSink *sink = AsyncMessageSink::instance()) {
+        QByteArray message = formattedMessage.toLocal8Bit();
+        message += '\n';
+        if (sink->post(message))
+            return;
+        // keep the order of the messages already queued
+        sink->flush();
+    }
+    stderr_message_handler(QtDebugMsg, QMessageLogContext(), formattedMessage);
+}
+
+static void flushAsyncMessages()
+{
+    if (AsyncMessageSink *sink = AsyncMessageSink::instance())
+        sink->flush();
+}
+
+void QtPrivate::setAsyncMessageOutput(bool enable)
+{
+    flushAsyncMessages();
+    asyncMessageOutput.storeRelaxed(enable);
+}
+
+quint64 QtPrivate::droppedAsyncMessages()
+{
+    if (AsyncMessageSink *sink = AsyncMessageSink::instance())
+        return sink->dropped.load(std::memory_order_relaxed);
+    return 0;
+}
+
+void QtPrivate::flushAsyncMessageOutput()
+{
+    flushAsyncMessages();
+}
+#else
+static void stderr_message_output(const QString &formattedMessage)
+{
+    stderr_message_handler(QtDebugMsg, QMessageLogContext(), formattedMessage);
+}
+
+static void flushAsyncMessages() { }
+
+void QtPrivate::setAsyncMessageOutput(bool) { }
+quint64 QtPrivate::droppedAsyncMessages() { return 0; }
+void QtPrivate::flushAsyncMessageOutput() { }
+#endif // QT_CONFIG(thread) && !QT_BOOTSTRAPPED
+
 namespace {
 struct SystemMessageSink
 {
@@ -2025,7 +2386,7 @@ QT_WARNING_DISABLE_GCC("-Waddress") // "the address of ~~ will never be NULL
         return;
 QT_WARNING_POP
 
-    stderr_message_handler(type, context, formattedMessage);
+    stderr_message_output(formattedMessage);
 }
 
 /*!
@@ -2038,6 +2399,15 @@ static void qDefaultMessageHandler(QtMsgType type, const QMessageLogContext &con
     // optionally formatting the message if the latter, and returns true if the sink
     // handled stderr output as well, which will shortcut our default stderr output.
 
+#ifndef QT_BOOTSTRAPPED
+    // fatal messages are written to the binary log and to the usual output
+    if (QBinaryLogWriter::isActive()
+            && QBinaryLogWriter::writeText(type, context, qt_gettid(), message)
+            && type != QtFatalMsg) {
+        return;
+    }
+#endif
+
     if (systemMessageSink.messageIsUnformatted) {
         if (systemMessageSink.sink(type, context, message))
             return;
@@ -2074,18 +2444,82 @@ static bool grabMessageHandler() { return true; }
 static void ungrabMessageHandler() { }
 #endif // (Q_COMPILER_THREAD_LOCAL)
 
-static void qt_message_print(QtMsgType msgType, const QMessageLogContext &context, const QString &message)
-{
 #ifndef QT_BOOTSTRAPPED
-    Q_TRACE(qt_message_print, msgType, context.category, context.function, context.file, context.line, message);
-
+static bool isMessageEnabled(QtMsgType msgType, const QMessageLogContext &context)
+{
     // qDebug, qWarning, ... macros do not check whether category is enabledgc
     if (msgType != QtFatalMsg && isDefaultCategory(context.category)) {
-        if (QLoggingCategory *defaultCategory = QLoggingCategory::defaultCategory()) {
-            if (!defaultCategory->isEnabled(msgType))
-                return;
+        if (QLoggingCategory *defaultCategory = QLoggingCategory::defaultCategory())
+            return defaultCategory->isEnabled(msgType);
+    }
+    return true;
+}
+#endif
+
+/*!
+    \internal
+
+    Writes the printf-style message \a msg with its arguments \a ap to the
+    binary log without formatting it, if the log is active and no message
+    handler was installed. Returns \c false if the message must be formatted
+    and printed as usual.
+*/
+static bool qt_message_write_binary(QtMsgType msgType, const QMessageLogContext &context,
+                                    const char *msg, va_list ap)
+{
+#ifndef QT_BOOTSTRAPPED
+    if (msgType == QtFatalMsg || messageHandler.loadAcquire() || !QBinaryLogWriter::isActive())
+        return false;
+    if (!isMessageEnabled(msgType, context))
+        return true;
+
+    // avoid a system call per message
+    Q_CONSTINIT static thread_local quint64 threadId = 0;
+    if (Q_UNLIKELY(!threadId))
+        threadId = quint64(qt_gettid());
+
+    va_list copy;
+    va_copy(copy, ap);
+    const bool written = QBinaryLogWriter::writeMessage(msgType, context, threadId, msg, copy);
+    va_end(copy);
+    return written;
+#else
+    Q_UNUSED(msgType);
+    Q_UNUSED(context);
+    Q_UNUSED(msg);
+    Q_UNUSED(ap);
+    return false;
+#endif
+}
+
+/*!
+    \internal
+
+    Prints \a message to the usual output of the default message handler,
+    bypassing the binary log.
+*/
+static void qt_message_print_text(QtMsgType msgType, const QMessageLogContext &context,
+                                  const QString &message)
+{
+    if (grabMessageHandler()) {
+        const auto ungrab = qScopeGuard([]{ ungrabMessageHandler(); });
+        if (systemMessageSink.messageIsUnformatted
+                && systemMessageSink.sink(msgType, context, message)) {
+            return;
         }
+        preformattedMessageHandler(msgType, context, formatLogMessage(msgType, context, message));
+    } else {
+        stderr_message_handler(msgType, context, message);
     }
+}
+
+static void qt_message_print(QtMsgType msgType, const QMessageLogContext &context, const QString &message)
+{
+#ifndef QT_BOOTSTRAPPED
+    Q_TRACE(qt_message_print, msgType, context.category, context.function, context.file, context.line, message);
+
+    if (!isMessageEnabled(msgType, context))
+        return;
 #endif
 
     // prevent recursion in case the message handler generates messages
@@ -2123,6 +2557,8 @@ static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, Strin
     Q_UNUSED(context);
 #endif
 
+    flushAsyncMessages();
+
     if constexpr (std::is_class_v<String> && !std::is_const_v<String>)
         message.clear();
     else
@@ -2200,6 +2636,23 @@ void qErrnoWarning(int code, const char *msg, ...)
     to assume full control, and for instance log messages to the
     file system.
 
+    When the standard message handler writes to \c stderr, it does so on the
+    thread that logs the message, which then waits for the output. Setting
+    the \c QT_LOGGING_ASYNC environment variable to \c 1 makes it queue the
+    formatted messages instead, and write them out from a separate thread.
+    Each thread can queue up to 64 KiB of messages; when the output can't keep
+    up, further messages are dropped and their number is reported. Messages
+    still queued are written out when the application exits or a fatal
+    message is logged, but not if it crashes.
+
+    Setting the \c QT_LOGGING_BINARY environment variable to the path of a
+    file makes the standard message handler write the messages to that file
+    in a binary format instead. Messages logged with a printf-style format
+    string are stored with their raw arguments and formatted only when the
+    file is decoded with the \c qlogdecode tool, which keeps logging cheap on
+    the threads that log. The file is memory-mapped, so the messages logged
+    before a crash are kept. Fatal messages are also printed as usual.
+
     Note that Qt supports \l{QLoggingCategory}{logging categories} for
     grouping related messages in semantic categories. You can use these
     to enable or disable logging per category and \l{QtMsgType}{message type}.
@@ -39,6 +39,10 @@ namespace QtPrivate {
 
 Q_CORE_EXPORT bool shouldLogToStderr();
 
+Q_AUTOTEST_EXPORT void setAsyncMessageOutput(bool enable);
+Q_AUTOTEST_EXPORT quint64 droppedAsyncMessages();
+Q_AUTOTEST_EXPORT void flushAsyncMessageOutput();
+
 }
 
 class QInternalMessageLogContext : public QMessageLogContext
@@ -13,3 +13,12 @@
 
 #include <forkfd.h>
 #include "../../3rdparty/forkfd/forkfd.c"
+
+#ifdef __linux__
+// Tells QProcess whether forkfd's descriptors are pidfds, in which case a
+// pidfd obtained some other way can be passed to forkfd_wait4() too.
+int qt_forkfd_uses_pidfd(void)
+{
+    return system_forkfd_availability() > 0;
+}
+#endif
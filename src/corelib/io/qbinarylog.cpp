@@ -0,0 +1,659 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qbinarylog_p.h"
+
+#include <qcoreapplication.h>
+#include <qdatetime.h>
+#include <qelapsedtimer.h>
+#include <qfile.h>
+#include <qmetatype.h>
+#include <qmutex.h>
+#include <qscopeguard.h>
+#include <qvarlengtharray.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The binary log is a sequence of records following a FileHeader. Each record
+    starts with its size and kind:
+
+    - StringRecord: a format string or category name, identified by a number
+      in the records that follow.
+    - MessageRecord: a message logged with a printf-style format string,
+      stored as the identifier of its format string followed by its
+      arguments. Each argument is a QMetaType::Type, followed by eight bytes
+      for numbers and pointers, or the size and the UTF-8 contents of a
+      string.
+    - TextRecord: a message that was formatted when it was logged, like the
+      ones streamed into a QDebug.
+
+    The file grows in chunks, which are mapped into memory. A record whose
+    size is zero ends the log, like the unused end of the last chunk if the
+    process crashed before truncating the file.
+*/
+
+namespace {
+constexpr char Magic[8] = { 'Q', 'T', 'B', 'I', 'N', 'L', 'O', 'G' };
+constexpr quint32 Version = 1;
+constexpr qint64 ChunkSize = 1024 * 1024;
+
+enum RecordKind : quint8 {
+    StringRecord = 1,
+    MessageRecord,
+    TextRecord,
+};
+
+struct FileHeader
+{
+    char magic[sizeof(Magic)];
+    quint32 version;
+    quint32 size;
+    qint64 startMSecsSinceEpoch;
+    qint64 pid;
+};
+
+struct StringHeader
+{
+    quint32 size;
+    quint8 kind;
+    quint8 reserved[3];
+    quint32 id;
+};
+
+struct MessageHeader
+{
+    quint32 size;
+    quint8 kind;
+    quint8 type;
+    quint16 argumentCount;
+    quint32 categoryId;
+    quint32 formatId;       // 0 for TextRecord
+    qint64 timestamp;
+    quint64 threadId;
+};
+
+template <typename T> void appendRaw(QVarLengthArray<char, 512> &buffer, const T &value)
+{
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> T readRaw(const char *data)
+{
+    T value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// A conversion specification of a format string, as parsed by QString::vasprintf()
+struct Conversion
+{
+    enum Length { None, hh, h, l, ll, L, j, z, t };
+
+    QByteArrayView flags;
+    int width = -1;
+    int precision = -1;
+    bool widthArgument = false;
+    bool precisionArgument = false;
+    Length length = None;
+    char conversion = 0;
+};
+
+enum class ParseResult { Conversion, End, Unsupported };
+
+/*
+    Finds the next conversion in \a format from \a position, appending the
+    text before it to \a text if it's not null. Returns Unsupported for the
+    conversions the binary log can't defer, which must be formatted right away.
+*/
+ParseResult nextConversion(QByteArrayView format, qsizetype &position, Conversion *conversion,
+                           QString *text)
+{
+    const char *c = format.data() + position;
+    const char *end = format.data() + format.size();
+    for (;;) {
+        const char *literal = c;
+        while (c != end && *c != '%')
+            ++c;
+        if (text)
+            text->append(QUtf8StringView(literal, c - literal));
+        if (c == end) {
+            position = format.size();
+            return ParseResult::End;
+        }
+        ++c;
+        if (c != end && *c == '%') {
+            if (text)
+                text->append(u'%');
+            ++c;
+            continue;
+        }
+        break;
+    }
+
+    *conversion = {};
+    const char *flags = c;
+    while (c != end && strchr("#0- +'", *c))
+        ++c;
+    conversion->flags = QByteArrayView(flags, c - flags);
+
+    auto parseNumber = [&](int *value, bool *fromArgument) {
+        if (c != end && *c == '*') {
+            *fromArgument = true;
+            ++c;
+        } else if (c != end && *c >= '0' && *c <= '9') {
+            *value = 0;
+            while (c != end && *c >= '0' && *c <= '9')
+                *value = qMin(*value * 10 + (*c++ - '0'), 0xffff);
+        }
+    };
+    parseNumber(&conversion->width, &conversion->widthArgument);
+    if (c != end && *c == '.') {
+        ++c;
+        conversion->precision = 0;
+        parseNumber(&conversion->precision, &conversion->precisionArgument);
+    }
+
+    if (c != end) {
+        switch (*c++) {
+        case 'h':
+            conversion->length = (c != end && *c == 'h') ? (++c, Conversion::hh) : Conversion::h;
+            break;
+        case 'l':
+            conversion->length = (c != end && *c == 'l') ? (++c, Conversion::ll) : Conversion::l;
+            break;
+        case 'L': conversion->length = Conversion::L; break;
+        case 'j': conversion->length = Conversion::j; break;
+        case 'z':
+        case 'Z': conversion->length = Conversion::z; break;
+        case 't': conversion->length = Conversion::t; break;
+        default: --c; break;
+        }
+    }
+    if (c == end)
+        return ParseResult::Unsupported;
+
+    conversion->conversion = *c++;
+    position = c - format.data();
+    switch (conversion->conversion) {
+    case 'd': case 'i':
+        return conversion->length == Conversion::L ? ParseResult::Unsupported
+                                                   : ParseResult::Conversion;
+    case 'o': case 'u': case 'x': case 'X':
+        return conversion->length == Conversion::L || conversion->length == Conversion::j
+                ? ParseResult::Unsupported : ParseResult::Conversion;
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+    case 'c': case 's': case 'p':
+        return ParseResult::Conversion;
+    }
+    return ParseResult::Unsupported;
+}
+
+class BinaryLogFile
+{
+public:
+    bool open(const QString &fileName);
+    void close();
+    bool append(QVarLengthArray<char, 512> &record, const char *format, const char *category);
+
+    QElapsedTimer timer;
+
+private:
+    quint32 intern(const char *string);
+    bool write(const char *data, qsizetype size);
+
+    QMutex mutex;
+    QFile file;
+    uchar *chunk = nullptr;
+    qint64 chunkOffset = 0;
+    qint64 chunkSize = 0;
+    qint64 chunkUsed = 0;
+    QHash<const void *, std::pair<quint32, QByteArray>> stringIds;
+    quint32 nextStringId = 1;
+};
+
+bool BinaryLogFile::open(const QString &fileName)
+{
+    QMutexLocker locker(&mutex);
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+        return false;
+
+    timer.start();
+    FileHeader header;
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.size = sizeof(FileHeader);
+    header.startMSecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+    header.pid = QCoreApplication::applicationPid();
+    if (!write(reinterpret_cast<const char *>(&header), sizeof(header))) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+void BinaryLogFile::close()
+{
+    QMutexLocker locker(&mutex);
+    if (!file.isOpen())
+        return;
+    if (chunk)
+        file.unmap(chunk);
+    chunk = nullptr;
+    file.resize(chunkOffset + chunkUsed);
+    file.close();
+}
+
+quint32 BinaryLogFile::intern(const char *string)
+{
+    if (!string)
+        return 0;
+    // the same pointer may not point to the same string if it isn't a literal
+    auto it = stringIds.find(string);
+    if (it != stringIds.end() && qstrcmp(it->second, string) == 0)
+        return it->first;
+
+    const quint32 id = nextStringId++;
+    const QByteArray contents(string);
+    StringHeader header = {};
+    header.size = quint32(sizeof(header) + contents.size());
+    header.kind = StringRecord;
+    header.id = id;
+    if (!write(reinterpret_cast<const char *>(&header), sizeof(header))
+            || !write(contents.constData(), contents.size())) {
+        return 0;
+    }
+    stringIds.insert(string, { id, contents });
+    return id;
+}
+
+bool BinaryLogFile::append(QVarLengthArray<char, 512> &record, const char *format,
+                           const char *category)
+{
+    // the warnings of QFile while writing a record are printed as usual
+    static thread_local bool writing = false;
+    if (writing)
+        return false;
+    writing = true;
+    auto resetWriting = qScopeGuard([] { writing = false; });
+
+    QMutexLocker locker(&mutex);
+    if (!file.isOpen())
+        return false;
+
+    // the strings must precede the first record that uses them
+    MessageHeader header = readRaw<MessageHeader>(record.constData());
+    header.categoryId = intern(category);
+    if (format)
+        header.formatId = intern(format);
+    memcpy(record.data(), &header, sizeof(header));
+    return write(record.constData(), record.size());
+}
+
+bool BinaryLogFile::write(const char *data, qsizetype size)
+{
+    if (chunkUsed + size > chunkSize) {
+        if (chunk)
+            file.unmap(chunk);
+        chunkOffset += chunkUsed;
+        chunkSize = qMax(ChunkSize, qint64(size));
+        chunkUsed = 0;
+        chunk = nullptr;
+        if (file.resize(chunkOffset + chunkSize))
+            chunk = file.map(chunkOffset, chunkSize);
+        if (!chunk) {
+            file.resize(chunkOffset);
+            file.close();
+            return false;
+        }
+    }
+    memcpy(chunk + chunkUsed, data, size);
+    chunkUsed += size;
+    return true;
+}
+
+Q_CONSTINIT QBasicAtomicPointer<BinaryLogFile> activeLogFile = Q_BASIC_ATOMIC_INITIALIZER(nullptr);
+Q_CONSTINIT QBasicAtomicInt environmentChecked = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+BinaryLogFile *logFile()
+{
+    if (Q_UNLIKELY(!environmentChecked.loadAcquire())) {
+        // anything logged while opening the file isn't written to it
+        if (environmentChecked.testAndSetAcquire(0, 1)) {
+            const QString fileName = qEnvironmentVariable("QT_LOGGING_BINARY");
+            if (!fileName.isEmpty())
+                QBinaryLogWriter::open(fileName);
+        }
+    }
+    return activeLogFile.loadAcquire();
+}
+
+QVarLengthArray<char, 512> messageRecord(RecordKind kind, QtMsgType type, quint64 threadId,
+                                         qint64 timestamp)
+{
+    QVarLengthArray<char, 512> record;
+    MessageHeader header = {};
+    header.kind = kind;
+    header.type = quint8(type);
+    header.timestamp = timestamp;
+    header.threadId = threadId;
+    appendRaw(record, header);
+    return record;
+}
+
+void finishRecord(QVarLengthArray<char, 512> &record, quint16 argumentCount)
+{
+    MessageHeader header = readRaw<MessageHeader>(record.constData());
+    header.size = quint32(record.size());
+    header.argumentCount = argumentCount;
+    memcpy(record.data(), &header, sizeof(header));
+}
+} // unnamed namespace
+
+bool QBinaryLogWriter::isActive() noexcept
+{
+    return logFile() != nullptr;
+}
+
+/*
+    Starts writing the log to \a fileName, replacing its contents. The file
+    stays open until close() is called or the application exits.
+*/
+bool QBinaryLogWriter::open(const QString &fileName)
+{
+    environmentChecked.storeRelease(1);
+    close();
+
+    // never deleted, as other threads may still be writing to it
+    auto file = new BinaryLogFile;
+    if (!file->open(fileName)) {
+        delete file;
+        return false;
+    }
+    activeLogFile.storeRelease(file);
+
+    static struct CloseAtExit {
+        ~CloseAtExit() { QBinaryLogWriter::close(); }
+    } closeAtExit;
+    return true;
+}
+
+void QBinaryLogWriter::close()
+{
+    if (BinaryLogFile *file = activeLogFile.fetchAndStoreAcquire(nullptr))
+        file->close();
+}
+
+/*
+    Writes a message with the printf-style \a format and its arguments \a ap
+    to the log. Returns \c false if the log isn't active, or if the format uses
+    conversions that must be formatted right away.
+*/
+bool QBinaryLogWriter::writeMessage(QtMsgType type, const QMessageLogContext &context,
+                                    quint64 threadId, const char *format, va_list ap)
+{
+    BinaryLogFile *file = logFile();
+    if (!file || !format)
+        return false;
+
+    auto record = messageRecord(MessageRecord, type, threadId, file->timer.nsecsElapsed());
+    quint16 argumentCount = 0;
+    auto appendNumber = [&](QMetaType::Type metaType, auto value) {
+        appendRaw(record, quint16(metaType));
+        appendRaw(record, value);
+        ++argumentCount;
+    };
+    auto appendString = [&](QByteArrayView string) {
+        appendRaw(record, quint16(QMetaType::QByteArray));
+        appendRaw(record, quint32(string.size()));
+        record.append(string.data(), string.size());
+        ++argumentCount;
+    };
+
+    const QByteArrayView formatView(format);
+    qsizetype position = 0;
+    Conversion conversion;
+    for (;;) {
+        const ParseResult result = nextConversion(formatView, position, &conversion, nullptr);
+        if (result == ParseResult::End)
+            break;
+        if (result == ParseResult::Unsupported)
+            return false;
+
+        if (conversion.widthArgument)
+            appendNumber(QMetaType::Int, qint64(va_arg(ap, int)));
+        int precision = conversion.precision;
+        if (conversion.precisionArgument) {
+            precision = va_arg(ap, int);
+            appendNumber(QMetaType::Int, qint64(precision));
+        }
+
+        // read the arguments the same way QString::vasprintf() does
+        switch (conversion.conversion) {
+        case 'd':
+        case 'i': {
+            qint64 i;
+            switch (conversion.length) {
+            case Conversion::l: i = va_arg(ap, long int); break;
+            case Conversion::ll: i = va_arg(ap, qint64); break;
+            case Conversion::j: i = va_arg(ap, long int); break;
+            case Conversion::z:
+            case Conversion::t: i = va_arg(ap, qsizetype); break;
+            default: i = va_arg(ap, int); break;
+            }
+            appendNumber(QMetaType::LongLong, i);
+            break;
+        }
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X': {
+            quint64 u;
+            switch (conversion.length) {
+            case Conversion::l: u = va_arg(ap, ulong); break;
+            case Conversion::ll: u = va_arg(ap, quint64); break;
+            case Conversion::z:
+            case Conversion::t: u = va_arg(ap, size_t); break;
+            default: u = va_arg(ap, uint); break;
+            }
+            appendNumber(QMetaType::ULongLong, u);
+            break;
+        }
+        case 'c':
+            appendNumber(QMetaType::Int, qint64(va_arg(ap, int)));
+            break;
+        case 's':
+            if (conversion.length == Conversion::l) {
+                const char16_t *string = va_arg(ap, const char16_t *);
+                qsizetype size = 0;
+                while ((precision < 0 || size < precision) && string[size])
+                    ++size;
+                appendString(QStringView(string, size).toUtf8());
+            } else {
+                const char *string = va_arg(ap, const char *);
+                appendString(precision < 0 ? QByteArrayView(string)
+                                           : QByteArrayView(string, qstrnlen(string, precision)));
+            }
+            break;
+        case 'p':
+            appendNumber(QMetaType::VoidStar, quint64(quintptr(va_arg(ap, void *))));
+            break;
+        default:
+            if (conversion.length == Conversion::L)
+                appendNumber(QMetaType::Double, double(va_arg(ap, long double)));
+            else
+                appendNumber(QMetaType::Double, va_arg(ap, double));
+            break;
+        }
+    }
+
+    finishRecord(record, argumentCount);
+    return file->append(record, format, context.category);
+}
+
+/*
+    Writes the already formatted \a message to the log. Returns \c false if
+    the log isn't active or the message couldn't be written.
+*/
+bool QBinaryLogWriter::writeText(QtMsgType type, const QMessageLogContext &context,
+                                 quint64 threadId, const QString &message)
+{
+    BinaryLogFile *file = logFile();
+    if (!file)
+        return false;
+
+    auto record = messageRecord(TextRecord, type, threadId, file->timer.nsecsElapsed());
+    const QByteArray text = message.toUtf8();
+    record.append(text.constData(), text.size());
+    finishRecord(record, 0);
+    return file->append(record, nullptr, context.category);
+}
+
+/*!
+    \class QBinaryLogReader
+    \internal
+
+    Decodes a binary log written by QBinaryLogWriter from \a data.
+*/
+QBinaryLogReader::QBinaryLogReader(QByteArrayView data)
+    : data(data)
+{
+    if (data.size() < qsizetype(sizeof(FileHeader)))
+        return;
+    const auto header = readRaw<FileHeader>(data.data());
+    if (memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version
+            || header.size < sizeof(FileHeader) || header.size > quint64(data.size())) {
+        return;
+    }
+    startMSecsSinceEpoch = header.startMSecsSinceEpoch;
+    pid = header.pid;
+    position = header.size;
+    valid = true;
+}
+
+/*
+    Reads the next message into \a message. Returns \c false at the end of
+    the log, or if the rest of it is corrupt.
+*/
+bool QBinaryLogReader::readNext(Message *message)
+{
+    while (valid && data.size() - position >= qsizetype(sizeof(StringHeader))) {
+        const char *record = data.data() + position;
+        const quint32 size = readRaw<quint32>(record);
+        if (size < sizeof(StringHeader) || size > quint64(data.size() - position))
+            return false;
+        position += size;
+
+        const quint8 kind = readRaw<quint8>(record + sizeof(quint32));
+        if (kind == StringRecord) {
+            const auto header = readRaw<StringHeader>(record);
+            strings.insert(header.id, QByteArray(record + sizeof(header), size - sizeof(header)));
+            continue;
+        }
+        if ((kind != MessageRecord && kind != TextRecord) || size < sizeof(MessageHeader))
+            return false;
+
+        const auto header = readRaw<MessageHeader>(record);
+        const QByteArrayView payload(record + sizeof(header), size - sizeof(header));
+        message->type = QtMsgType(header.type);
+        message->category = strings.value(header.categoryId);
+        message->timestamp = header.timestamp;
+        message->threadId = header.threadId;
+        if (kind == TextRecord)
+            message->text = QString::fromUtf8(payload);
+        else
+            message->text = format(strings.value(header.formatId), payload, header.argumentCount);
+        return true;
+    }
+    return false;
+}
+
+QString QBinaryLogReader::format(QByteArrayView format, QByteArrayView arguments,
+                                 quint16 argumentCount) const
+{
+    qsizetype argumentPosition = 0;
+    auto nextArgument = [&](quint64 *number, QByteArray *string) {
+        if (!argumentCount || arguments.size() - argumentPosition < qsizetype(sizeof(quint16)))
+            return false;
+        --argumentCount;
+        const auto metaType = readRaw<quint16>(arguments.data() + argumentPosition);
+        argumentPosition += sizeof(quint16);
+        if (metaType == QMetaType::QByteArray) {
+            if (arguments.size() - argumentPosition < qsizetype(sizeof(quint32)))
+                return false;
+            const auto size = readRaw<quint32>(arguments.data() + argumentPosition);
+            argumentPosition += sizeof(quint32);
+            if (size > quint64(arguments.size() - argumentPosition))
+                return false;
+            *string = QByteArray(arguments.data() + argumentPosition, size);
+            argumentPosition += size;
+        } else {
+            if (arguments.size() - argumentPosition < qsizetype(sizeof(quint64)))
+                return false;
+            *number = readRaw<quint64>(arguments.data() + argumentPosition);
+            argumentPosition += sizeof(quint64);
+        }
+        return true;
+    };
+
+    QString result;
+    qsizetype position = 0;
+    Conversion conversion;
+    while (nextConversion(format, position, &conversion, &result) == ParseResult::Conversion) {
+        quint64 number = 0;
+        QByteArray string;
+        int width = conversion.width;
+        int precision = conversion.precision;
+        if (conversion.widthArgument && nextArgument(&number, &string))
+            width = int(number);
+        if (conversion.precisionArgument && nextArgument(&number, &string))
+            precision = int(number);
+        if (!nextArgument(&number, &string))
+            break;
+
+        // let QString::asprintf() format each argument as it would have
+        QByteArray spec = '%' + conversion.flags.toByteArray();
+        if (width >= 0)
+            spec += QByteArray::number(width);
+        if (precision >= 0 && conversion.conversion != 's')
+            spec += '.' + QByteArray::number(precision);
+        if (strchr("diouxX", conversion.conversion))
+            spec += "ll";
+        else if (conversion.conversion == 'c' && conversion.length == Conversion::l)
+            spec += 'l';
+        spec += conversion.conversion;
+
+        switch (conversion.conversion) {
+        case 'd':
+        case 'i':
+            result += QString::asprintf(spec.constData(), qint64(number));
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            result += QString::asprintf(spec.constData(), number);
+            break;
+        case 'c':
+            result += QString::asprintf(spec.constData(), int(number));
+            break;
+        case 's':
+            result += QString::asprintf(spec.constData(), string.constData());
+            break;
+        case 'p':
+            result += QString::asprintf(spec.constData(),
+                                        reinterpret_cast<void *>(quintptr(number)));
+            break;
+        default:
+            result += QString::asprintf(spec.constData(),
+                                        readRaw<double>(reinterpret_cast<const char *>(&number)));
+            break;
+        }
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
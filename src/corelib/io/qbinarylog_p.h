@@ -0,0 +1,77 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QBINARYLOG_P_H
+#define QBINARYLOG_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlogging.h>
+#include <QtCore/qstring.h>
+
+#include <stdarg.h>
+
+QT_BEGIN_NAMESPACE
+
+// The binary log, enabled by setting QT_LOGGING_BINARY to the path of the
+// file to write. Messages are stored with their format string and raw
+// arguments, and formatted only when the log is decoded.
+class Q_CORE_EXPORT QBinaryLogWriter
+{
+public:
+    static bool isActive() noexcept;
+    static bool open(const QString &fileName);
+    static void close();
+
+    static bool writeMessage(QtMsgType type, const QMessageLogContext &context, quint64 threadId,
+                             const char *format, va_list ap);
+    static bool writeText(QtMsgType type, const QMessageLogContext &context, quint64 threadId,
+                          const QString &message);
+};
+
+class Q_CORE_EXPORT QBinaryLogReader
+{
+public:
+    struct Message
+    {
+        QtMsgType type = QtDebugMsg;
+        QByteArray category;
+        qint64 timestamp = 0;       // nanoseconds since startTime()
+        quint64 threadId = 0;
+        QString text;
+    };
+
+    explicit QBinaryLogReader(QByteArrayView data);
+
+    bool isValid() const noexcept { return valid; }
+    qint64 startTime() const noexcept { return startMSecsSinceEpoch; }
+    qint64 processId() const noexcept { return pid; }
+
+    bool readNext(Message *message);
+
+private:
+    QString format(QByteArrayView format, QByteArrayView arguments, quint16 argumentCount) const;
+
+    QByteArrayView data;
+    qsizetype position = 0;
+    qint64 startMSecsSinceEpoch = 0;
+    qint64 pid = 0;
+    QHash<quint32, QByteArray> strings;
+    bool valid = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QBINARYLOG_P_H
@@ -19,6 +19,7 @@
 #include "qfilesystementry_p.h"
 #include "qfilesystemmetadata_p.h"
 #include "qfilesystemengine_p.h"
+#include "qfileinfo_p.h"
 #include <qstringbuilder.h>
 
 #ifndef QT_BOOTSTRAPPED
@@ -306,6 +307,13 @@ inline void QDirPrivate::sortFileList(QDir::SortFlags sort, const QFileInfoList
                 names->append(fi.fileName());
         }
     } else {
+        // read what the comparisons need for all the entries at once
+        const QDir::SortFlags sortBy = sort & QDir::SortByMask;
+        if (sortBy == QDir::Time)
+            QFileInfoPrivate::fillMetaData(l, QFileSystemMetaData::Times);
+        else if (sortBy == QDir::Size)
+            QFileInfoPrivate::fillMetaData(l, QFileSystemMetaData::SizeAttribute);
+
         QVarLengthArray<QDirSortItem, 64> si;
         si.reserve(n);
         for (qsizetype i = 0; i < n; ++i)
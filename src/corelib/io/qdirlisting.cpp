@@ -291,7 +291,10 @@ void QDirListingPrivate::pushDirectory(QDirEntryInfo &entryInfo)
             fentry = &entryInfo.fileInfoOpt->d_ptr->fileEntry;
         else
             fentry = &entryInfo.entry;
-        nativeIterators.emplace_back(std::make_unique<QFileSystemIterator>(*fentry, iteratorFlags));
+        if (useLegacyFilters)
+            nativeIterators.emplace_back(std::make_unique<QFileSystemIterator>(*fentry, legacyDirFilters));
+        else
+            nativeIterators.emplace_back(std::make_unique<QFileSystemIterator>(*fentry, iteratorFlags));
 #else
         qWarning("Qt was built with -no-feature-filesystemiterator: no files/plugins will be found!");
 #endif
@@ -18,6 +18,15 @@
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
+#if QT_CONFIG(future)
+# include "qfuture.h"
+# include "qpromise.h"
+# include "qsavefile.h"
+# include "qthreadpool.h"
+
+# include <limits>
+# include <optional>
+#endif
 
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
@@ -827,24 +836,34 @@ QFile::copy(const QString &newName)
                     out.close();
                     close();
                 } else {
-                    if (!d->engine()->cloneTo(out.d_func()->engine())) {
-                        char block[4096];
+                    if (d->engine()->cloneTo(out.d_func()->engine())) {
+                        if (d->copyProgress)
+                            (*d->copyProgress)(size(), size());
+                    } else {
+                        // blocks bigger than the buffers of QIODevice bypass them
+                        QByteArray block(64 * 1024, Qt::Uninitialized);
                         qint64 totalRead = 0;
                         while (!atEnd()) {
-                            qint64 in = read(block, sizeof(block));
+                            qint64 in = read(block.data(), block.size());
                             if (in <= 0)
                                 break;
                             totalRead += in;
-                            if (in != out.write(block, in)) {
+                            if (in != out.write(block.data(), in)) {
                                 close();
                                 d->setError(QFile::CopyError, tr("Failure to write block: %1")
                                             .arg(out.errorString()));
                                 error = true;
                                 break;
                             }
+                            if (d->copyProgress && !(*d->copyProgress)(totalRead, size())) {
+                                close();
+                                d->setError(QFile::CopyError, tr("Copying canceled"));
+                                error = true;
+                                break;
+                            }
                         }
 
-                        if (totalRead != size()) {
+                        if (!error && totalRead != size()) {
                             // Unable to read from the source. The error string is
                             // already set from read().
                             error = true;
@@ -901,6 +920,228 @@ QFile::copy(const QString &fileName, const QString &newName)
     return QFile(fileName).copy(newName);
 }
 
+#if QT_CONFIG(future)
+namespace {
+// Runs the blocking I/O of the asynchronous QFile functions, separately from
+// QThreadPool::globalInstance(), so that it neither waits for nor delays
+// CPU-bound tasks.
+class QFileIOThreadPool : public QThreadPool
+{
+public:
+    QFileIOThreadPool()
+    {
+        setObjectName("QFile I/O"_L1);
+        setMaxThreadCount(4);
+    }
+};
+
+// The asynchronous functions work in blocks of this size, between which they
+// report progress and check for cancellation.
+constexpr qint64 AsyncBlockSize = 1024 * 1024;
+
+// Progress is reported in bytes, scaled down to fit in an int for large files
+template <typename T>
+class AsyncProgress
+{
+public:
+    AsyncProgress(QPromise<T> &promise, qint64 total)
+        : promise(promise), total(qMax(total, qint64(0))),
+          range(int(qMin(this->total, qint64(std::numeric_limits<int>::max()))))
+    {
+        promise.setProgressRange(0, range);
+    }
+
+    void setValue(qint64 done)
+    {
+        if (total == 0 || (done < last + AsyncBlockSize && done < total))
+            return;
+        last = done;
+        promise.setProgressValue(int(qMin(done, total) * double(range) / total));
+    }
+
+private:
+    QPromise<T> &promise;
+    const qint64 total;
+    const int range;
+    qint64 last = 0;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QFileIOThreadPool, fileIOThreadPool)
+
+/*!
+    \since 6.9
+
+    Reads up to \a maxSize bytes from the file named \a fileName, starting at
+    \a offset, on a separate thread. If \a maxSize is negative, the file is
+    read until its end. Returns a QFuture that provides the data read, or a
+    null QByteArray if the file cannot be opened or read.
+
+    The file is read in blocks, between which the progress of the QFuture is
+    updated with the number of bytes read, and cancellation is checked. A
+    canceled QFuture has no result.
+
+    \note You need to include \c{<QFuture>} to use the returned QFuture.
+
+    \sa writeAsync(), copyAsync(), QIODevice::read()
+*/
+QFuture<QByteArray> QFile::readAsync(const QString &fileName, qint64 offset, qint64 maxSize)
+{
+    QPromise<QByteArray> promise;
+    QFuture<QByteArray> future = promise.future();
+    promise.start();
+    fileIOThreadPool()->start([=, promise = std::move(promise)]() mutable {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly) || (offset != 0 && !file.seek(offset))) {
+            promise.addResult(QByteArray());
+            promise.finish();
+            return;
+        }
+
+        // sequential files and files in /proc may not know their size
+        qint64 expected = qMax(file.size() - file.pos(), qint64(0));
+        if (maxSize >= 0)
+            expected = qMin(expected, maxSize);
+        AsyncProgress progress(promise, expected);
+
+        QByteArray data(""_ba);
+        if (expected > 0) {
+            if (expected > QByteArray::maxSize()) {
+                promise.addResult(QByteArray());
+                promise.finish();
+                return;
+            }
+            data.reserve(expected);
+        }
+
+        bool ok = true;
+        while (!promise.isCanceled()) {
+            qint64 blockSize = AsyncBlockSize;
+            if (maxSize >= 0)
+                blockSize = qMin(blockSize, maxSize - data.size());
+            blockSize = qMin(blockSize, qint64(QByteArray::maxSize() - data.size()));
+            if (blockSize <= 0)
+                break;
+
+            const qsizetype size = data.size();
+            data.resize(size + blockSize);
+            const qint64 n = file.read(data.data() + size, blockSize);
+            data.resize(size + qMax(n, qint64(0)));
+            if (n < 0)
+                ok = false;
+            if (n <= 0)
+                break;
+            progress.setValue(data.size());
+        }
+
+        if (!promise.isCanceled())
+            promise.addResult(ok ? std::move(data) : QByteArray());
+        promise.finish();
+    });
+    return future;
+}
+
+/*!
+    \since 6.9
+
+    Replaces the contents of the file named \a fileName with \a data on a
+    separate thread, creating the file if needed. Returns a QFuture that
+    provides the number of bytes written, or -1 if an error occurred.
+
+    The data is written in blocks, between which the progress of the QFuture
+    is updated with the number of bytes written, and cancellation is checked.
+    A canceled QFuture has no result. When QSaveFile is available, the data is
+    written to it, so that the file is only replaced if all of \a data was
+    written, and is left unchanged if an error occurs or the QFuture is
+    canceled.
+
+    \note You need to include \c{<QFuture>} to use the returned QFuture.
+
+    \sa readAsync(), copyAsync(), QIODevice::write()
+*/
+QFuture<qint64> QFile::writeAsync(const QString &fileName, const QByteArray &data)
+{
+    QPromise<qint64> promise;
+    QFuture<qint64> future = promise.future();
+    promise.start();
+    fileIOThreadPool()->start([=, promise = std::move(promise)]() mutable {
+#if QT_CONFIG(temporaryfile)
+        QSaveFile file(fileName);
+#else
+        QFile file(fileName);
+#endif
+        qint64 written = 0;
+        if (file.open(QIODevice::WriteOnly)) {
+            AsyncProgress progress(promise, data.size());
+            while (written < data.size() && !promise.isCanceled()) {
+                const qint64 blockSize = qMin(AsyncBlockSize, data.size() - written);
+                const qint64 n = file.write(data.constData() + written, blockSize);
+                if (n <= 0)
+                    break;
+                written += n;
+                progress.setValue(written);
+            }
+#if QT_CONFIG(temporaryfile)
+            if (written != data.size() || promise.isCanceled())
+                file.cancelWriting();
+            if (!file.commit())
+                written = -1;
+#else
+            file.close();
+            if (file.error() != QFileDevice::NoError)
+                written = -1;
+#endif
+        } else {
+            written = -1;
+        }
+
+        if (!promise.isCanceled())
+            promise.addResult(written == data.size() ? written : -1);
+        promise.finish();
+    });
+    return future;
+}
+
+/*!
+    \since 6.9
+
+    Copies the file named \a fileName to \a newName on a separate thread,
+    like copy() does. Returns a QFuture that provides \c true if the file was
+    copied, and \c false otherwise.
+
+    When the file is copied in blocks, the progress of the QFuture is updated
+    with the number of bytes copied, and cancellation is checked between them.
+    A canceled QFuture has no result, and \a newName is not created.
+
+    \note You need to include \c{<QFuture>} to use the returned QFuture.
+
+    \sa readAsync(), writeAsync(), copy()
+*/
+QFuture<bool> QFile::copyAsync(const QString &fileName, const QString &newName)
+{
+    QPromise<bool> promise;
+    QFuture<bool> future = promise.future();
+    promise.start();
+    fileIOThreadPool()->start([=, promise = std::move(promise)]() mutable {
+        QFile file(fileName);
+        std::optional<AsyncProgress<bool>> progress;
+        auto reportProgress = [&](qint64 done, qint64 total) {
+            if (!progress)
+                progress.emplace(promise, total);
+            progress->setValue(done);
+            return !promise.isCanceled();
+        };
+        qxp::function_ref<bool(qint64, qint64)> copyProgress(reportProgress);
+        file.d_func()->copyProgress = &copyProgress;
+        const bool ok = !promise.isCanceled() && file.copy(newName);
+        if (!promise.isCanceled())
+            promise.addResult(ok);
+        promise.finish();
+    });
+    return future;
+}
+#endif // QT_CONFIG(future)
+
 /*!
     Opens the file using OpenMode \a mode, returning true if successful;
     otherwise false.
@@ -938,7 +1179,7 @@ bool QFile::open(OpenMode mode)
 
     // QIODevice provides the buffering, so there's no need to request it from the file engine.
     if (d->engine()->open(mode | QIODevice::Unbuffered)) {
-        QIODevice::open(mode);
+        QIODevice::open(d->setUpReadMapping(mode));
         if (mode & Append)
             seek(size());
         return true;
@@ -983,7 +1224,7 @@ bool QFile::open(OpenMode mode, QFile::Permissions permissions)
 
     // QIODevice provides the buffering, so there's no need to request it from the file engine.
     if (d->engine()->open(mode | QIODevice::Unbuffered, permissions)) {
-        QIODevice::open(mode);
+        QIODevice::open(d->setUpReadMapping(mode));
         if (mode & Append)
             seek(size());
         return true;
@@ -1051,6 +1292,9 @@ bool QFile::open(FILE *fh, OpenMode mode, FileHandleFlags handleFlags)
         return false;
     }
 
+    // Adopted handles are never mapped, see QIODevice::MemoryMapped
+    mode &= ~MemoryMapped;
+
     // QIODevice provides the buffering, so request unbuffered file engines
     if (d->openExternalFile(mode | Unbuffered, fh, handleFlags)) {
         QIODevice::open(mode);
@@ -1103,6 +1347,9 @@ bool QFile::open(int fd, OpenMode mode, FileHandleFlags handleFlags)
         return false;
     }
 
+    // Adopted handles are never mapped, see QIODevice::MemoryMapped
+    mode &= ~MemoryMapped;
+
     // QIODevice provides the buffering, so request unbuffered file engines
     if (d->openExternalFile(mode | Unbuffered, fd, handleFlags)) {
         QIODevice::open(mode);
@@ -81,6 +81,9 @@ using ForceFilesystemPath = typename std::enable_if_t<std::is_same_v<std::filesy
 
 class QTemporaryFile;
 class QFilePrivate;
+#if QT_CONFIG(future) || defined(Q_QDOC)
+template <typename T> class QFuture;
+#endif
 
 // ### Qt 7: remove this, and make constructors always explicit.
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)) || defined(QT_EXPLICIT_QFILE_CONSTRUCTION_FROM_PATH)
@@ -283,6 +286,13 @@ public:
     }
 #endif // QT_CONFIG(cxx17_filesystem)
 
+#if QT_CONFIG(future) || defined(Q_QDOC)
+    static QFuture<QByteArray> readAsync(const QString &fileName, qint64 offset = 0,
+                                         qint64 maxSize = -1);
+    static QFuture<qint64> writeAsync(const QString &fileName, const QByteArray &data);
+    static QFuture<bool> copyAsync(const QString &fileName, const QString &newName);
+#endif
+
     QFILE_MAYBE_NODISCARD bool open(OpenMode flags) override;
     QFILE_MAYBE_NODISCARD bool open(OpenMode flags, Permissions permissions);
     QFILE_MAYBE_NODISCARD bool open(FILE *f, OpenMode ioFlags, FileHandleFlags handleFlags=DontCloseHandle);
@@ -18,6 +18,8 @@
 #include "qfile.h"
 #include "private/qfiledevice_p.h"
 
+#include <QtCore/qxpfunctional.h>
+
 QT_BEGIN_NAMESPACE
 
 class QTemporaryFile;
@@ -37,6 +39,10 @@ protected:
     QAbstractFileEngine *engine() const override;
 
     QString fileName;
+
+    // called by QFile::copy() with the bytes copied and the total; returning
+    // false cancels the copy
+    qxp::function_ref<bool(qint64, qint64)> *copyProgress = nullptr;
 };
 
 QT_END_NAMESPACE
@@ -6,6 +6,13 @@
 #include "qfiledevice_p.h"
 #include "qfsfileengine_p.h"
 
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#endif
+
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
 #endif
@@ -50,6 +57,94 @@ void QFileDevicePrivate::setError(QFileDevice::FileError err, int errNum)
     errorString = qt_error_string(errNum);
 }
 
+// How far ahead of the read position the kernel is asked to fault in pages
+// of a QIODevice::MemoryMapped file. Must be a multiple of the page size.
+static constexpr qint64 ReadAheadWindow = 4 * 1024 * 1024;
+
+/*!
+    \internal
+
+    Maps the just opened file for QIODevice::MemoryMapped reading. Returns
+    the mode to open the QIODevice with: MemoryMapped and Unbuffered are set
+    if the mapping is in place, MemoryMapped is cleared otherwise.
+*/
+QIODevice::OpenMode QFileDevicePrivate::setUpReadMapping(QIODevice::OpenMode mode)
+{
+    if (!(mode & QIODevice::MemoryMapped))
+        return mode;
+    mode &= ~QIODevice::MemoryMapped;
+    if ((mode & QIODevice::WriteOnly) || fileEngine->isSequential())
+        return mode;
+
+    const qint64 size = fileEngine->size();
+    if (size <= 0)
+        return mode;
+    uchar *address = fileEngine->map(0, size, QFileDevice::NoOptions);
+    if (!address)
+        return mode;
+
+    readMap = address;
+    readMapSize = size;
+    readMapPos = 0;
+    readAheadPos = 0;
+#ifdef Q_OS_UNIX
+#  ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fileEngine->handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#  endif
+#  ifdef MADV_SEQUENTIAL
+    ::madvise(address, size_t(size), MADV_SEQUENTIAL);
+#  endif
+#endif
+    adviseReadAhead(0);
+    return mode | QIODevice::MemoryMapped | QIODevice::Unbuffered;
+}
+
+/*!
+    \internal
+
+    Copies up to \a maxSize bytes from the read mapping at the current
+    position to \a data, stopping after the first newline if \a stopAtNewline
+    is true. Returns the number of bytes copied, which is 0 once the end of the
+    mapping has been reached.
+*/
+qint64 QFileDevicePrivate::readFromMap(char *data, qint64 maxSize, bool stopAtNewline)
+{
+    qint64 n = qMin(maxSize, readMapSize - readMapPos);
+    if (n <= 0)
+        return 0;
+    const uchar *from = readMap + readMapPos;
+    if (stopAtNewline) {
+        if (const void *newline = std::memchr(from, '\n', size_t(n)))
+            n = static_cast<const uchar *>(newline) - from + 1;
+    }
+    adviseReadAhead(readMapPos + n);
+    std::memcpy(data, from, size_t(n));
+    readMapPos += n;
+    return n;
+}
+
+/*!
+    \internal
+
+    Asks the kernel to fault in the mapped pages between one and two
+    read-ahead windows past \a end, so that sequential reads find them
+    resident.
+*/
+void QFileDevicePrivate::adviseReadAhead(qint64 end)
+{
+#if defined(Q_OS_UNIX) && defined(MADV_WILLNEED)
+    const qint64 windowStart = end & ~(ReadAheadWindow - 1);
+    const qint64 target = qMin(windowStart + 2 * ReadAheadWindow, readMapSize);
+    if (readAheadPos >= target)
+        return;
+    const qint64 start = qMax(readAheadPos, windowStart);
+    ::madvise(readMap + start, size_t(target - start), MADV_WILLNEED);
+    readAheadPos = target;
+#else
+    Q_UNUSED(end);
+#endif
+}
+
 /*!
     \enum QFileDevice::FileError
 
@@ -338,6 +433,12 @@ void QFileDevice::close()
     // reset cached size
     d->cachedSize = 0;
 
+    if (d->readMap) {
+        d->fileEngine->unmap(d->readMap);
+        d->readMap = nullptr;
+        d->readMapSize = 0;
+    }
+
     // keep earlier error from flush
     if (d->fileEngine->close() && flushed)
         unsetError();
@@ -418,7 +519,11 @@ bool QFileDevice::seek(qint64 off)
     if (!d->ensureFlushed())
         return false;
 
-    if (!d->fileEngine->seek(off) || !QIODevice::seek(off)) {
+    // reads from a mapping don't use the engine's file position
+    const bool engineSeeked = d->readMap ? off >= 0 : d->fileEngine->seek(off);
+    if (d->readMap && engineSeeked)
+        d->readMapPos = off;
+    if (!engineSeeked || !QIODevice::seek(off)) {
         QFileDevice::FileError err = d->fileEngine->error();
         if (err == QFileDevice::UnspecifiedError)
             err = QFileDevice::PositionError;
@@ -438,9 +543,38 @@ qint64 QFileDevice::readLineData(char *data, qint64 maxlen)
     if (!d->ensureFlushed())
         return -1;
 
+    qint64 mapped = 0;
+    if (d->readMap) {
+        mapped = d->readFromMap(data, maxlen, true);
+        if (mapped == maxlen || (mapped && data[mapped - 1] == '\n'))
+            return mapped;
+        // Past the end of the mapping, as in readData(): the rest of the line
+        // comes from regular reads at the same position.
+        data += mapped;
+        maxlen -= mapped;
+        if (!d->fileEngine->seek(d->readMapPos))
+            return mapped ? mapped : -1;
+    }
+
     qint64 read;
     if (d->fileEngine->supportsExtension(QAbstractFileEngine::FastReadLineExtension)) {
         read = d->fileEngine->readLine(data, maxlen);
+        if (d->readMap && read > 0)
+            d->readMapPos += read;
+    } else if (d->readMap) {
+        // Not QIODevice's implementation, which reads through read() and so
+        // would leave the part of the line read from the mapping out of pos()
+        read = 0;
+        while (read < maxlen) {
+            const qint64 r = readData(data + read, 1);
+            if (r != 1) {
+                if (r < 0 && !read)
+                    read = -1;
+                break;
+            }
+            if (data[read++] == '\n')
+                break;
+        }
     } else {
         // Fall back to QIODevice's readLine implementation if the engine
         // cannot do it faster.
@@ -452,7 +586,7 @@ qint64 QFileDevice::readLineData(char *data, qint64 maxlen)
         d->cachedSize = 0;
     }
 
-    return read;
+    return mapped && read < 0 ? mapped : mapped + read;
 }
 
 /*!
@@ -467,6 +601,19 @@ qint64 QFileDevice::readData(char *data, qint64 len)
     if (!d->ensureFlushed())
         return -1;
 
+    qint64 mapped = 0;
+    if (d->readMap) {
+        mapped = d->readFromMap(data, len, false);
+        if (mapped == len)
+            return mapped;
+        // Past the end of the mapping; the file may have grown since it was
+        // opened, so continue with regular reads from the same position.
+        data += mapped;
+        len -= mapped;
+        if (!d->fileEngine->seek(d->readMapPos))
+            return mapped ? mapped : -1;
+    }
+
     const qint64 read = d->fileEngine->read(data, len);
     if (read < 0) {
         QFileDevice::FileError err = d->fileEngine->error();
@@ -480,7 +627,9 @@ qint64 QFileDevice::readData(char *data, qint64 len)
         d->cachedSize = 0;
     }
 
-    return read;
+    if (d->readMap && read > 0)
+        d->readMapPos += read;
+    return mapped && read < 0 ? mapped : mapped + read;
 }
 
 /*!
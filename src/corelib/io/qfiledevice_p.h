@@ -55,9 +55,19 @@ protected:
     void setError(QFileDevice::FileError err, const QString &errorString);
     void setError(QFileDevice::FileError err, int errNum);
 
+    QIODevice::OpenMode setUpReadMapping(QIODevice::OpenMode mode);
+    qint64 readFromMap(char *data, qint64 maxSize, bool stopAtNewline);
+    void adviseReadAhead(qint64 end);
+
     mutable std::unique_ptr<QAbstractFileEngine> fileEngine;
     mutable qint64 cachedSize;
 
+    // QIODevice::MemoryMapped reads
+    uchar *readMap = nullptr;
+    qint64 readMapSize = 0;
+    qint64 readMapPos = 0;
+    qint64 readAheadPos = 0;
+
     QFileDevice::FileHandleFlags handleFlags;
     QFileDevice::FileError error;
 
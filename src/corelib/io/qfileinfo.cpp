@@ -7,6 +7,11 @@
 #include "qdir.h"
 #include "qfileinfo_p.h"
 #include "qdebug.h"
+#include "qscopeguard.h"
+
+#ifdef Q_OS_LINUX
+#  include <private/qcore_unix_p.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -186,6 +191,60 @@ QDateTime &QFileInfoPrivate::getFileTime(QFile::FileTime request) const
     return fileTimes[request];
 }
 
+/*
+    Reads the \a what metadata of the \a infos that don't have it cached yet.
+    On Linux, the stat(2) metadata of the entries of a directory is read
+    relative to a file descriptor for the directory, which saves resolving its
+    path again for each of them.
+*/
+void QFileInfoPrivate::fillMetaData(const QFileInfoList &infos,
+                                    QFileSystemMetaData::MetaDataFlags what)
+{
+#ifdef Q_OS_LINUX
+    constexpr QFileSystemMetaData::MetaDataFlags BulkFlags = QFileSystemMetaData::PosixStatFlags
+            | QFileSystemMetaData::LinkType | QFileSystemMetaData::ExistsAttribute;
+    bool bulk = (what & ~BulkFlags) == 0;
+#  ifdef QT_FILESYSTEMMETADATACACHE
+    // the shared cache is cheaper than any system call
+    if (QFileSystemMetaDataCache::isEnabled())
+        bulk = false;
+#  endif
+    QString directory;
+    int directoryFd = -1;
+    auto closeDirectory = qScopeGuard([&] {
+        if (directoryFd != -1)
+            qt_safe_close(directoryFd);
+    });
+#endif
+
+    for (const QFileInfo &info : infos) {
+        const QFileInfoPrivate *d = get(&info);
+        if (d->isDefaultConstructed || d->fileEngine || !d->cache_enabled
+                || d->metaData.hasFlags(what)) {
+            continue;
+        }
+#ifdef Q_OS_LINUX
+        if (bulk) {
+            QString path = d->fileEntry.path();
+            if (path != directory) {
+                if (directoryFd != -1)
+                    qt_safe_close(directoryFd);
+                directoryFd = qt_safe_open(QFile::encodeName(path).constData(),
+                                           O_RDONLY | O_DIRECTORY | O_PATH);
+                directory = std::move(path);
+            }
+            if (directoryFd != -1) {
+                QFileSystemEngine::fillMetaData(directoryFd,
+                                                QFile::encodeName(d->fileEntry.fileName()),
+                                                d->metaData);
+                continue;
+            }
+        }
+#endif
+        fillMetaData(d->fileEntry, d->metaData, what);
+    }
+}
+
 //************* QFileInfo
 
 /*!
@@ -319,6 +378,16 @@ QDateTime &QFileInfoPrivate::getFileTime(QFile::FileTime request) const
     at construction. To make sure that all information is read from the file
     system immediately, use the stat() member function.
 
+    On Linux, the information can also be shared between all the QFileInfo
+    objects of the process by setting the \c QT_FILEINFO_SHARED_CACHE
+    environment variable. QFileInfo then watches the directories of the
+    entries it has read with inotify, and reads from the file system again
+    only the entries that have changed since. This only applies to absolute
+    paths on local file systems, and not to directories, symlinks or paths
+    that go through a symlink. Changes made through hard links in other
+    directories are not noticed, so this should not be used with files that
+    are modified that way.
+
     \l{birthTime()}, \l{fileTime()}, \l{lastModified()}, \l{lastRead()},
     and \l{metadataChangeTime()} return times in \e{local time} by default.
     Since native file system API typically uses UTC, this requires a conversion.
@@ -724,7 +793,7 @@ bool QFileInfo::exists() const
         return false;
     if (d->fileEngine == nullptr) {
         if (!d->cache_enabled || !d->metaData.hasFlags(QFileSystemMetaData::ExistsAttribute))
-            QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::ExistsAttribute);
+            QFileInfoPrivate::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::ExistsAttribute);
         return d->metaData.exists();
     }
     return d->getFileFlags(QAbstractFileEngine::ExistsFlag);
@@ -752,7 +821,7 @@ bool QFileInfo::exists(const QString &path)
     if (auto engine = QFileSystemEngine::createLegacyEngine(entry, data))
         return QFileInfo(new QFileInfoPrivate(entry, data, std::move(engine))).exists();
 
-    QFileSystemEngine::fillMetaData(entry, data, QFileSystemMetaData::ExistsAttribute);
+    QFileInfoPrivate::fillMetaData(entry, data, QFileSystemMetaData::ExistsAttribute);
     return data.exists();
 }
 
@@ -1741,7 +1810,7 @@ void QFileInfo::setCaching(bool enable)
 void QFileInfo::stat()
 {
     Q_D(QFileInfo);
-    QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::AllMetaDataFlags);
+    QFileInfoPrivate::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::AllMetaDataFlags);
 }
 
 /*!
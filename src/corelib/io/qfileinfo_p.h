@@ -24,6 +24,7 @@
 #include <QtCore/private/qabstractfileengine_p.h>
 #include <QtCore/private/qfilesystementry_p.h>
 #include <QtCore/private/qfilesystemmetadata_p.h>
+#include <QtCore/private/qfilesystemmetadatacache_p.h>
 
 #include <memory>
 
@@ -46,6 +47,7 @@ public:
     };
 
     static QFileInfoPrivate *get(QFileInfo *fi) { return fi->d_func(); }
+    static const QFileInfoPrivate *get(const QFileInfo *fi) { return fi->d_func(); }
 
     inline QFileInfoPrivate()
         : QSharedData(), fileEngine(nullptr),
@@ -147,6 +149,19 @@ public:
     inline void setCachedFlag(uint c) const
     { if (cache_enabled) cachedFlags |= c; }
 
+    // Uses the shared cache, if enabled, for the file systems that support it
+    static bool fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                             QFileSystemMetaData::MetaDataFlags what)
+    {
+#ifdef QT_FILESYSTEMMETADATACACHE
+        if (QFileSystemMetaDataCache::isEnabled())
+            return QFileSystemMetaDataCache::fillMetaData(entry, data, what);
+#endif
+        return QFileSystemEngine::fillMetaData(entry, data, what);
+    }
+
+    static void fillMetaData(const QFileInfoList &infos, QFileSystemMetaData::MetaDataFlags what);
+
     template <typename Ret, typename FSLambda, typename EngineLambda>
     Ret checkAttribute(Ret defaultValue, QFileSystemMetaData::MetaDataFlags fsFlags,
                        FSLambda fsLambda, EngineLambda engineLambda) const
@@ -156,7 +171,7 @@ public:
         if (fileEngine)
             return engineLambda();
         if (!cache_enabled || !metaData.hasFlags(fsFlags)) {
-            QFileSystemEngine::fillMetaData(fileEntry, metaData, fsFlags);
+            fillMetaData(fileEntry, metaData, fsFlags);
             // ignore errors, fillMetaData will have cleared the flags
         }
         return fsLambda();
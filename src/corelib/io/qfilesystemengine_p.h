@@ -88,6 +88,9 @@ public:
 #if defined(Q_OS_UNIX)
     static bool cloneFile(int srcfd, int dstfd, const QFileSystemMetaData &knownData);
     static bool fillMetaData(int fd, QFileSystemMetaData &data); // what = PosixStatFlags
+#  if defined(Q_OS_LINUX)
+    static bool fillMetaData(int directoryFd, const QByteArray &name, QFileSystemMetaData &data);
+#  endif
     static QByteArray id(int fd);
     static bool setFileTime(int fd, const QDateTime &newDate,
                             QFile::FileTime whatTime, QSystemError &error);
@@ -62,6 +62,8 @@
 #if defined(Q_OS_LINUX)
 #  include <sys/ioctl.h>
 #  include <sys/sendfile.h>
+#  include <sys/syscall.h>
+#  include <linux/falloc.h>
 #  include <linux/fs.h>
 
 // in case linux/fs.h is too old and doesn't define it:
@@ -360,6 +362,9 @@ inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffe
     groupId_ = statxBuffer.stx_gid;
 }
 #else
+[[maybe_unused]] static int qt_real_statx(int, const char *, int, struct statx *)
+{ return -ENOSYS; }
+
 static int qt_statx(const char *, struct statx *)
 { return -ENOSYS; }
 
@@ -429,6 +434,61 @@ bool QFileSystemEngine::fillMetaData(int fd, QFileSystemMetaData &data)
     return false;
 }
 
+#ifdef Q_OS_LINUX
+/*!
+    \internal
+
+    Fills the PosixStatFlags, LinkType and ExistsAttribute metadata of the
+    entry \a name of the directory \a directoryFd. Reading the metadata of many
+    entries of a directory this way saves resolving the directory's path for
+    each of them. Like fillMetaData(), symlinks are described by their target.
+*/
+//static
+bool QFileSystemEngine::fillMetaData(int directoryFd, const QByteArray &name,
+                                     QFileSystemMetaData &data)
+{
+    data.entryFlags &= ~(QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType
+                         | QFileSystemMetaData::ExistsAttribute);
+    data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType
+            | QFileSystemMetaData::ExistsAttribute;
+
+    struct statx statxBuffer;
+    int ret = qt_real_statx(directoryFd, name.constData(), AT_SYMLINK_NOFOLLOW, &statxBuffer);
+    if (ret != -ENOSYS) {
+        if (ret == 0 && S_ISLNK(statxBuffer.stx_mode)) {
+            data.entryFlags |= QFileSystemMetaData::LinkType;
+            ret = qt_real_statx(directoryFd, name.constData(), 0, &statxBuffer);
+        }
+        if (ret == 0) {
+            data.fillFromStatxBuf(statxBuffer);
+            return true;
+        }
+    } else {
+        QT_STATBUF statBuffer;
+        ret = ::fstatat64(directoryFd, name.constData(), &statBuffer, AT_SYMLINK_NOFOLLOW);
+        if (ret == 0 && S_ISLNK(statBuffer.st_mode)) {
+            data.entryFlags |= QFileSystemMetaData::LinkType;
+            ret = ::fstatat64(directoryFd, name.constData(), &statBuffer, 0);
+        }
+        if (ret == 0) {
+            data.fillFromStatBuf(statBuffer);
+            return true;
+        }
+    }
+
+    // the entry or, for a broken symlink, its target doesn't exist: report
+    // the same as fillMetaData() does for the path
+    data.birthTime_ = 0;
+    data.metadataChangeTime_ = 0;
+    data.modificationTime_ = 0;
+    data.accessTime_ = 0;
+    data.size_ = 0;
+    data.userId_ = (uint) -2;
+    data.groupId_ = (uint) -2;
+    return false;
+}
+#endif // Q_OS_LINUX
+
 #if defined(_DEXTRA_FIRST)
 static void fillStat64fromStat32(struct stat64 *statBuf64, const struct stat &statBuf32)
 {
@@ -1089,28 +1149,56 @@ bool QFileSystemEngine::cloneFile(int srcfd, int dstfd, const QFileSystemMetaDat
     if (::ioctl(dstfd, FICLONE, srcfd) == 0)
         return true;
 
-    // Second, try sendfile (it can send to some special types too).
-    // sendfile(2) is limited in the kernel to 2G - 4k
-    const size_t SendfileSize = 0x7ffff000;
+    // If the data has to be copied, reserve the space for it first, so that
+    // the copy doesn't fragment the file and ENOSPC is detected early. This
+    // fails on file systems that don't support it, which is fine.
+    if (QT_FSTAT(srcfd, &statBuffer) == 0 && statBuffer.st_size > 0)
+        ::fallocate(dstfd, FALLOC_FL_KEEP_SIZE, 0, statBuffer.st_size);
+
+    // uh oh, this is probably a real error (like ENOSPC), but we have no way
+    // to notify QFile of partial success, so just erase any work done
+    // (hopefully we won't get any errors, because there's nothing we can do
+    // about them)
+    auto undoPartialCopy = [=] {
+        [[maybe_unused]] int n = ftruncate(dstfd, 0);
+        n = lseek(srcfd, 0, SEEK_SET);
+        n = lseek(dstfd, 0, SEEK_SET);
+        return false;
+    };
+
+    // Both copy_file_range(2) and sendfile(2) are limited in the kernel to 2G - 4k
+    const size_t MaxCopySize = 0x7ffff000;
+
+#  if defined(__NR_copy_file_range) && !defined(Q_OS_ANDROID)
+    // Second, try copy_file_range, which copies within the kernel, and can
+    // use server-side copies on network file systems. It only copies between
+    // different file systems since Linux 5.3.
+    ssize_t copied = ::syscall(__NR_copy_file_range, srcfd, nullptr, dstfd, nullptr,
+                               MaxCopySize, 0);
+    if (copied > 0) {
+        while (copied) {
+            copied = ::syscall(__NR_copy_file_range, srcfd, nullptr, dstfd, nullptr,
+                               MaxCopySize, 0);
+            if (copied == -1)
+                return undoPartialCopy();
+        }
+        return true;
+    }
+    // Otherwise, it's unsupported for these files, or the file is empty or
+    // doesn't report its size (like files in /proc): fall back to sendfile.
+#  endif
 
-    ssize_t n = ::sendfile(dstfd, srcfd, nullptr, SendfileSize);
+    // Third, try sendfile (it can send to some special types too).
+    ssize_t n = ::sendfile(dstfd, srcfd, nullptr, MaxCopySize);
     if (n == -1) {
         // if we got an error here, give up and try at an upper layer
         return false;
     }
 
     while (n) {
-        n = ::sendfile(dstfd, srcfd, nullptr, SendfileSize);
-        if (n == -1) {
-            // uh oh, this is probably a real error (like ENOSPC), but we have
-            // no way to notify QFile of partial success, so just erase any work
-            // done (hopefully we won't get any errors, because there's nothing
-            // we can do about them)
-            n = ftruncate(dstfd, 0);
-            n = lseek(srcfd, 0, SEEK_SET);
-            n = lseek(dstfd, 0, SEEK_SET);
-            return false;
-        }
+        n = ::sendfile(dstfd, srcfd, nullptr, MaxCopySize);
+        if (n == -1)
+            return undoPartialCopy();
     }
 
     return true;
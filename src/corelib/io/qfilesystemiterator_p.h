@@ -31,6 +31,13 @@
 
 #include <memory>
 
+#if defined(Q_OS_LINUX) && defined(QT_LARGEFILE_SUPPORT) \
+        && defined(QT_USE_XOPEN_LFS_EXTENSIONS) && !defined(QT_NO_READDIR64)
+// QT_DIRENT is struct dirent64, which has the layout of the records that
+// getdents64(2) returns, so we can read the directory in large batches.
+#  define QT_FILESYSTEMITERATOR_GETDENTS64
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QFileSystemIterator
@@ -54,6 +61,17 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#elif defined(QT_FILESYSTEMITERATOR_GETDENTS64)
+    static void fillFromStatAt(int dirFd, const char *name, unsigned char type,
+                               QFileSystemMetaData &metaData);
+
+    int dirFd = -1;
+    bool statUntypedEntries = true;
+    std::unique_ptr<char[]> direntBuffer;
+    qsizetype direntBufferSize = 0;
+    qsizetype direntBufferOffset = 0;
+    int lastError = 0;
+    QStringDecoder toUtf16;
 #else
     struct DirStreamCloser {
         void operator()(QT_DIR *dir) { if (dir) QT_CLOSEDIR(dir); }
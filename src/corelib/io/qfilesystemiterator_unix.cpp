@@ -8,6 +8,11 @@
 
 #include <qvarlengtharray.h>
 
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS64
+#  include <private/qcore_unix_p.h>
+#  include <sys/syscall.h>
+#endif
+
 #include <memory>
 
 #include <stdlib.h>
@@ -15,6 +20,70 @@
 
 QT_BEGIN_NAMESPACE
 
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS64
+// getdents64(2) returns as many entries as fit into the buffer; glibc's
+// readdir() uses 32 kB, a bigger buffer saves system calls on large
+// directories. Stay below malloc's default mmap threshold, though.
+static constexpr qsizetype DirentBufferSize = 64 * 1024;
+
+/*
+    Native filesystem iterator for Linux, which reads the directory
+    represented by \a entry with the getdents64() system call directly into a
+    large buffer, and stats entries relative to the directory file descriptor
+    when their type isn't known from the directory entry itself and the
+    filters need it.
+*/
+QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry)
+    : dirPath(entry.filePath()),
+      toUtf16(QStringDecoder::Utf8)
+{
+    dirFd = qt_safe_open(entry.nativeFilePath().constData(), O_RDONLY | O_DIRECTORY);
+    if (dirFd == -1) {
+        lastError = errno;
+    } else {
+        direntBuffer.reset(new char[DirentBufferSize]);
+        if (!dirPath.endsWith(u'/'))
+            dirPath.append(u'/');
+    }
+}
+
+QFileSystemIterator::~QFileSystemIterator()
+{
+    if (dirFd != -1)
+        qt_safe_close(dirFd);
+}
+
+/*
+    Fills \a metaData for the entry \a name of the directory \a dirFd, whose
+    type \a type as reported by getdents64() is either unknown or a symlink.
+    Symlinks are described by their target, like QFileSystemEngine::fillMetaData()
+    does.
+*/
+void QFileSystemIterator::fillFromStatAt(int dirFd, const char *name, unsigned char type,
+                                         QFileSystemMetaData &metaData)
+{
+    QT_STATBUF statBuffer;
+    if (type == DT_UNKNOWN) {
+        if (::fstatat64(dirFd, name, &statBuffer, AT_SYMLINK_NOFOLLOW) != 0)
+            return; // leave it to QFileSystemEngine::fillMetaData()
+        if (!S_ISLNK(statBuffer.st_mode)) {
+            metaData.fillFromStatBuf(statBuffer);
+            metaData.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags
+                    | QFileSystemMetaData::ExistsAttribute
+                    | QFileSystemMetaData::LinkType;
+            return;
+        }
+        metaData.entryFlags = QFileSystemMetaData::LinkType;
+        metaData.knownFlagsMask = QFileSystemMetaData::LinkType;
+    }
+
+    // a dangling symlink exists as an entry, but not as a file
+    if (::fstatat64(dirFd, name, &statBuffer, 0) == 0)
+        metaData.fillFromStatBuf(statBuffer);
+    metaData.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags
+            | QFileSystemMetaData::ExistsAttribute;
+}
+#else
 /*
     Native filesystem iterator, which uses ::opendir()/readdir()/dirent from the system
     libraries to iterate over the directory represented by \a entry.
@@ -32,6 +101,31 @@ QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry)
     }
 }
 
+QFileSystemIterator::~QFileSystemIterator() = default;
+#endif
+
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS64
+QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry,
+                                         QDirListing::IteratorFlags flags)
+    : QFileSystemIterator(entry)
+{
+    // Symlinks and entries of unknown type are only stat'ed up front if
+    // QDirListing needs their type to filter or recurse; otherwise their
+    // metadata is filled on demand.
+    using F = QDirListing::IteratorFlag;
+    statUntypedEntries = flags.testAnyFlags(F::ExcludeFiles | F::ExcludeDirs | F::ExcludeSpecial
+                                            | F::ResolveSymlinks | F::Recursive);
+}
+
+QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters)
+    : QFileSystemIterator(entry)
+{
+    // Only a filter that lets every type of entry through gets by without it
+    const QDir::Filters allTypes = QDir::Dirs | QDir::Files | QDir::System;
+    statUntypedEntries = (filters & allTypes) != allTypes
+            || filters.testAnyFlags(QDir::AllDirs | QDir::NoSymLinks | QDir::PermissionMask);
+}
+#else
 QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDirListing::IteratorFlags)
     : QFileSystemIterator(entry)
 {}
@@ -40,8 +134,7 @@ QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Fi
     : QFileSystemIterator(entry)
 {
 }
-
-QFileSystemIterator::~QFileSystemIterator() = default;
+#endif
 
 bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData)
 {
@@ -53,6 +146,41 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
 #endif
         return QFileSystemEntry(dirPath + name, QFileSystemEntry::FromInternalPath());
     };
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS64
+    if (dirFd == -1)
+        return false;
+
+    for (;;) {
+        if (direntBufferOffset >= direntBufferSize) {
+            const long read = ::syscall(SYS_getdents64, dirFd, direntBuffer.get(),
+                                        DirentBufferSize);
+            if (read <= 0) {
+                lastError = read < 0 ? errno : 0;
+                return false;
+            }
+            direntBufferSize = read;
+            direntBufferOffset = 0;
+        }
+
+        const auto *dirEntry =
+                reinterpret_cast<const QT_DIRENT *>(direntBuffer.get() + direntBufferOffset);
+        direntBufferOffset += dirEntry->d_reclen;
+
+        QByteArrayView name(dirEntry->d_name, strlen(dirEntry->d_name));
+        // name.size() is sufficient here, see QUtf8::convertToUnicode() for details
+        QVarLengthArray<char16_t> buffer(name.size());
+        auto *end = toUtf16.appendToBuffer(buffer.data(), name);
+        buffer.resize(end - buffer.constData());
+        if (toUtf16.hasError())
+            continue; // Invalid or incomplete multibyte or wide character
+
+        fileEntry = asFileEntry(buffer);
+        metaData.fillFromDirEnt(*dirEntry);
+        if (statUntypedEntries && (dirEntry->d_type == DT_UNKNOWN || dirEntry->d_type == DT_LNK))
+            fillFromStatAt(dirFd, dirEntry->d_name, dirEntry->d_type, metaData);
+        return true;
+    }
+#else
     if (!dir)
         return false;
 
@@ -90,6 +218,7 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
 
     lastError = errno;
     return false;
+#endif
 }
 
 QT_END_NAMESPACE
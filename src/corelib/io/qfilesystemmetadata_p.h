@@ -213,6 +213,7 @@ public:
 #endif
 private:
     friend class QFileSystemEngine;
+    friend class QFileSystemIterator;
 
     MetaDataFlags knownFlagsMask;
     MetaDataFlags entryFlags;
@@ -0,0 +1,366 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qfilesystemmetadatacache_p.h"
+
+#include "qfilesystemengine_p.h"
+
+#include <qfile.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <private/qcore_unix_p.h>
+
+#include <map>
+
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// The directory changes that can change the metadata of its entries, or the
+// meaning of the paths below it. Reading a file may update its access time.
+// Symlinks to directories aren't watched, as the target's parents aren't.
+constexpr uint32_t WatchMask = IN_ACCESS | IN_ATTRIB | IN_MODIFY | IN_CREATE | IN_DELETE
+        | IN_MOVE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW;
+
+// Each watched directory uses an inotify watch, which are limited per user
+constexpr qsizetype MaxDirectories = 1024;
+constexpr qsizetype MaxEntries = 64 * 1024;
+
+// The file systems known to report all their changes through inotify.
+// Network and pseudo file systems don't, as their contents change without
+// going through the local VFS.
+bool reportsAllChanges(const QByteArray &path)
+{
+    struct statfs buffer;
+    if (::statfs(path.constData(), &buffer) != 0)
+        return false;
+    switch (quint32(buffer.f_type)) {
+    case 0xEF53:        // ext2, ext3, ext4
+    case 0x58465342:    // xfs
+    case 0x9123683E:    // btrfs
+    case 0xCA451A4E:    // bcachefs
+    case 0xF2F52010:    // f2fs
+    case 0x2FC12FC1:    // zfs
+    case 0x01021994:    // tmpfs
+    case 0x794C7630:    // overlayfs
+        return true;
+    }
+    return false;
+}
+
+bool isCleanAbsolutePath(QStringView path)
+{
+    if (!path.startsWith(u'/') || path.endsWith(u'/'))
+        return false;
+    qsizetype start = 1;
+    while (start <= path.size()) {
+        qsizetype end = path.indexOf(u'/', start);
+        if (end < 0)
+            end = path.size();
+        const QStringView segment = path.sliced(start, end - start);
+        if (segment.isEmpty() || segment == u"." || segment == u"..")
+            return false;
+        start = end + 1;
+    }
+    return true;
+}
+
+QString parentPath(const QString &path)
+{
+    const qsizetype slash = path.lastIndexOf(u'/');
+    return slash == 0 ? QStringLiteral("/") : path.first(slash);
+}
+
+QString childPath(const QString &directory, QStringView name)
+{
+    if (directory.size() == 1)
+        return directory + name;
+    return directory + u'/' + name;
+}
+
+struct Directory
+{
+    int wd = -1;
+    QHash<QString, QFileSystemMetaData> entries;    // by file name
+};
+
+class QFileSystemMetaDataCachePrivate
+{
+public:
+    ~QFileSystemMetaDataCachePrivate()
+    {
+        if (inotifyFd != -1)
+            qt_safe_close(inotifyFd);
+    }
+
+    bool open();
+    void processEvents();
+    bool watch(const QString &path);
+    void removeDirectories(const QString &path);
+    void removeEntry(const QString &path);
+    void clear();
+
+    QMutex mutex;
+    int inotifyFd = -1;
+    QAtomicInt enabled = -1;    // -1 until the environment has been read
+
+    // Incremented when processing notifications, so that the metadata read
+    // while a change happened isn't cached
+    quint64 generation = 0;
+    qsizetype entryCount = 0;
+    QFileSystemMetaDataCache::Statistics statistics;
+
+    // sorted, so that the directories below a path are next to each other
+    std::map<QString, Directory> directories;
+    QMultiHash<int, QString> pathsByWatch;
+};
+
+bool QFileSystemMetaDataCachePrivate::open()
+{
+    if (inotifyFd == -1)
+        inotifyFd = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    return inotifyFd != -1;
+}
+
+void QFileSystemMetaDataCachePrivate::processEvents()
+{
+    if (inotifyFd == -1)
+        return;
+    alignas(struct inotify_event) char buffer[4096];
+    qint64 n;
+    while ((n = qt_safe_read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+        ++generation;
+        for (const char *at = buffer; at < buffer + n; ) {
+            const auto *event = reinterpret_cast<const struct inotify_event *>(at);
+            at += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                clear();
+                continue;
+            }
+
+            const QList<QString> paths = pathsByWatch.values(event->wd);
+            for (const QString &path : paths) {
+                if (event->len) {
+                    // a change to an entry in the directory
+                    const QString name = QFile::decodeName(event->name);
+                    const QString entryPath = childPath(path, name);
+                    removeEntry(entryPath);
+                    if (event->mask & (IN_ISDIR | IN_CREATE | IN_DELETE | IN_MOVE))
+                        removeDirectories(entryPath);
+                    // adding and removing entries changes the directory itself
+                    if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVE))
+                        removeEntry(path);
+                } else {
+                    // a change to the directory itself
+                    removeEntry(path);
+                    removeDirectories(path);
+                }
+            }
+        }
+    }
+}
+
+bool QFileSystemMetaDataCachePrivate::watch(const QString &path)
+{
+    if (directories.find(path) != directories.end())
+        return true;
+
+    // the paths below a directory change with the entries of its parents
+    if (path.size() > 1 && !watch(parentPath(path)))
+        return false;
+
+    const QByteArray nativePath = QFile::encodeName(path);
+    if (!reportsAllChanges(nativePath))
+        return false;
+    const int wd = ::inotify_add_watch(inotifyFd, nativePath.constData(), WatchMask);
+    if (wd == -1)
+        return false;
+    directories[path].wd = wd;
+    pathsByWatch.insert(wd, path);
+    return true;
+}
+
+// Removes the directory at path and the ones below it
+void QFileSystemMetaDataCachePrivate::removeDirectories(const QString &path)
+{
+    auto remove = [this](std::map<QString, Directory>::iterator it) {
+        const int wd = it->second.wd;
+        pathsByWatch.remove(wd, it->first);
+        if (!pathsByWatch.contains(wd))
+            ::inotify_rm_watch(inotifyFd, wd);
+        entryCount -= it->second.entries.size();
+        return directories.erase(it);
+    };
+
+    if (auto it = directories.find(path); it != directories.end())
+        remove(it);
+
+    const QString prefix = path.size() == 1 ? path : path + u'/';
+    auto it = directories.lower_bound(prefix);
+    while (it != directories.end() && it->first.startsWith(prefix))
+        it = remove(it);
+}
+
+void QFileSystemMetaDataCachePrivate::removeEntry(const QString &path)
+{
+    if (path.size() == 1)
+        return;
+    auto it = directories.find(parentPath(path));
+    if (it != directories.end())
+        entryCount -= it->second.entries.remove(path.sliced(path.lastIndexOf(u'/') + 1));
+}
+
+void QFileSystemMetaDataCachePrivate::clear()
+{
+    // closing the file descriptor removes all the watches at once
+    if (inotifyFd != -1) {
+        qt_safe_close(inotifyFd);
+        inotifyFd = -1;
+    }
+    directories.clear();
+    pathsByWatch.clear();
+    entryCount = 0;
+    ++generation;
+}
+
+Q_GLOBAL_STATIC(QFileSystemMetaDataCachePrivate, metaDataCache)
+} // unnamed namespace
+
+bool QFileSystemMetaDataCache::isEnabled() noexcept
+{
+    QFileSystemMetaDataCachePrivate *d = metaDataCache();
+    if (Q_UNLIKELY(!d))
+        return false;
+    int enabled = d->enabled.loadRelaxed();
+    if (Q_UNLIKELY(enabled == -1)) {
+        QMutexLocker locker(&d->mutex);
+        enabled = d->enabled.loadRelaxed();
+        if (enabled == -1) {
+            enabled = qEnvironmentVariableIsSet("QT_FILEINFO_SHARED_CACHE") && d->open();
+            d->enabled.storeRelaxed(enabled);
+        }
+    }
+    return enabled == 1;
+}
+
+/*!
+    \internal
+
+    Enables the cache if \a enable is \c true, and disables and clears it
+    otherwise, overriding the QT_FILEINFO_SHARED_CACHE environment variable.
+    Returns \c false if the cache couldn't be enabled.
+*/
+bool QFileSystemMetaDataCache::setEnabled(bool enable)
+{
+    QFileSystemMetaDataCachePrivate *d = metaDataCache();
+    if (!d)
+        return false;
+    QMutexLocker locker(&d->mutex);
+    if (enable && !d->open())
+        enable = false;
+    if (!enable)
+        d->clear();
+    d->enabled.storeRelaxed(enable);
+    return enable;
+}
+
+/*!
+    \internal
+
+    Fills \a data with the \a what metadata of \a entry, like
+    QFileSystemEngine::fillMetaData(), from the cache if possible.
+*/
+bool QFileSystemMetaDataCache::fillMetaData(const QFileSystemEntry &entry,
+                                            QFileSystemMetaData &data,
+                                            QFileSystemMetaData::MetaDataFlags what)
+{
+    QFileSystemMetaDataCachePrivate *d = metaDataCache();
+    const QString &path = entry.filePath();
+    if (!d || !isCleanAbsolutePath(path))
+        return QFileSystemEngine::fillMetaData(entry, data, what);
+
+    const QString directory = parentPath(path);
+    const QString name = entry.fileName();
+    QFileSystemMetaData cached;
+    quint64 generation;
+    {
+        QMutexLocker locker(&d->mutex);
+        d->processEvents();
+        if (qsizetype(d->directories.size()) >= MaxDirectories)
+            d->clear();
+        if (!d->open())
+            return QFileSystemEngine::fillMetaData(entry, data, what);
+
+        auto it = d->directories.find(directory);
+        if (it != d->directories.end()) {
+            const auto found = it->second.entries.constFind(name);
+            if (found != it->second.entries.cend()) {
+                if (found->hasFlags(what)) {
+                    ++d->statistics.hits;
+                    data = *found;
+                    return data.exists();
+                }
+                // what we know is up to date, so keep it
+                cached = *found;
+            }
+        } else if (!d->watch(directory)) {
+            return QFileSystemEngine::fillMetaData(entry, data, what);
+        }
+        ++d->statistics.misses;
+        generation = d->generation;
+    }
+
+    // The watches don't report changes to the target of a symlink, nor the
+    // updated times of a directory whose entries change, so those aren't kept
+    const auto uncachedTypes = QFileSystemMetaData::LinkType | QFileSystemMetaData::DirectoryType;
+    const bool result = QFileSystemEngine::fillMetaData(entry, cached, what | uncachedTypes);
+    data = cached;
+    if (cached.isLink() || cached.isDirectory())
+        return result;
+
+    QMutexLocker locker(&d->mutex);
+    d->processEvents();
+    if (d->generation != generation)
+        return result;      // something changed while reading, which may be this entry
+    auto it = d->directories.find(directory);
+    if (it == d->directories.end())
+        return result;
+    if (d->entryCount >= MaxEntries) {
+        d->clear();
+        return result;
+    }
+    auto &entries = it->second.entries;
+    if (!entries.contains(name))
+        ++d->entryCount;
+    entries.insert(name, std::move(cached));
+    return result;
+}
+
+/*!
+    \internal
+
+    Removes all the entries from the cache.
+*/
+void QFileSystemMetaDataCache::clear()
+{
+    if (QFileSystemMetaDataCachePrivate *d = metaDataCache()) {
+        QMutexLocker locker(&d->mutex);
+        d->clear();
+    }
+}
+
+QFileSystemMetaDataCache::Statistics QFileSystemMetaDataCache::statistics()
+{
+    QFileSystemMetaDataCachePrivate *d = metaDataCache();
+    if (!d)
+        return {};
+    QMutexLocker locker(&d->mutex);
+    Statistics result = d->statistics;
+    result.directories = qsizetype(d->directories.size());
+    return result;
+}
+
+QT_END_NAMESPACE
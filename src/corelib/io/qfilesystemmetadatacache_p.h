@@ -0,0 +1,58 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFILESYSTEMMETADATACACHE_P_H
+#define QFILESYSTEMMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qfilesystementry_p.h"
+#include "qfilesystemmetadata_p.h"
+
+#ifndef QT_BOOTSTRAPPED
+#  if QT_CONFIG(inotify) && defined(Q_OS_LINUX)
+#    define QT_FILESYSTEMMETADATACACHE
+#  endif
+#endif
+
+QT_BEGIN_NAMESPACE
+
+#ifdef QT_FILESYSTEMMETADATACACHE
+// A process-wide cache of the metadata of file system entries, shared by all
+// QFileInfo objects. The directories of the cached entries and their parents
+// are watched with inotify, and the pending notifications are processed before
+// every lookup, so that the cache never returns data older than the last
+// change to the file system. It is disabled by default, and can be enabled by
+// setting the QT_FILEINFO_SHARED_CACHE environment variable.
+class Q_AUTOTEST_EXPORT QFileSystemMetaDataCache
+{
+public:
+    static bool isEnabled() noexcept;
+    static bool setEnabled(bool enable);
+
+    static bool fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                             QFileSystemMetaData::MetaDataFlags what);
+    static void clear();
+
+    struct Statistics
+    {
+        qsizetype hits = 0;
+        qsizetype misses = 0;
+        qsizetype directories = 0;
+    };
+    static Statistics statistics();
+};
+#endif // QT_FILESYSTEMMETADATACACHE
+
+QT_END_NAMESPACE
+
+#endif // QFILESYSTEMMETADATACACHE_P_H
@@ -111,15 +111,28 @@ void QFileSystemWatcherPrivate::directoryChanged(const QString &path, bool remov
 {
     Q_Q(QFileSystemWatcher);
     qCDebug(lcWatcher) << "directory changed" << path << "removed?" << removed << "watching?" << directories.contains(path);
-    if (!directories.contains(path)) {
+    if (!directories.contains(path) && !isInRecursiveTree(path)) {
         // perhaps the path was removed after a change was detected, but before we delivered the signal
         return;
     }
-    if (removed)
+    if (removed) {
         directories.removeAll(path);
+        recursiveDirectories.removeAll(path);
+    }
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
+bool QFileSystemWatcherPrivate::isInRecursiveTree(const QString &path) const
+{
+    for (const QString &root : recursiveDirectories) {
+        if (path.size() > root.size() && path.startsWith(root)
+            && (root.endsWith(u'/') || path.at(root.size()) == u'/')) {
+            return true;
+        }
+    }
+    return false;
+}
+
 #if defined(Q_OS_WIN)
 
 void QFileSystemWatcherPrivate::winDriveLockForRemoval(const QString &path)
@@ -351,6 +364,47 @@ QStringList QFileSystemWatcher::addPaths(const QStringList &paths)
     return p;
 }
 
+/*!
+    \since 6.9
+
+    Adds the directory \a directory and all directories below it to the
+    file system watcher. Returns \c true if the watch was successful.
+
+    The directoryChanged() signal is emitted with the path of the
+    directory whose contents changed, which may be \a directory itself or
+    any of its subdirectories. Subdirectories created or moved into the
+    tree later are watched as well. Symbolic links to directories are not
+    followed.
+
+    Only \a directory is reported by directories(); passing it to
+    removePath() stops watching the whole tree.
+
+    The subdirectories are watched incrementally from the event loop, in
+    batches, so that adding a large tree does not block the caller.
+    Changes in a subdirectory are only reported once it has been reached.
+
+    \note Recursive watching is currently only supported on Linux. On
+    other platforms, and if \a directory does not exist or is already
+    being watched, this function returns \c false.
+
+    \sa addPath(), removePath()
+*/
+bool QFileSystemWatcher::addRecursivePath(const QString &directory)
+{
+    Q_D(QFileSystemWatcher);
+
+    if (directory.isEmpty()) {
+        qWarning("QFileSystemWatcher::addRecursivePath: path is empty");
+        return false;
+    }
+    qCDebug(lcWatcher) << "adding recursively" << directory;
+
+    if (!d->native || !d->native->addRecursivePath(directory, &d->directories))
+        return false;
+    d->recursiveDirectories.append(directory);
+    return true;
+}
+
 /*!
     Removes the specified \a path from the file system watcher.
 
@@ -400,6 +454,10 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     if (d->poller)
         p = d->poller->removePaths(p, &d->files, &d->directories);
 
+    d->recursiveDirectories.removeIf([d](const QString &root) {
+        return !d->directories.contains(root);
+    });
+
     return p;
 }
 
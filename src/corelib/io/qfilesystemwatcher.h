@@ -25,6 +25,7 @@ public:
 
     bool addPath(const QString &file);
     QStringList addPaths(const QStringList &files);
+    bool addRecursivePath(const QString &directory);
     bool removePath(const QString &file);
     QStringList removePaths(const QStringList &files);
 
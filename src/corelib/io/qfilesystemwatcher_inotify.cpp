@@ -7,7 +7,9 @@
 #include "private/qcore_unix_p.h"
 #include "private/qsystemerror_p.h"
 
+#include <qcoreevent.h>
 #include <qdebug.h>
+#include <qdirlisting.h>
 #include <qfile.h>
 #include <qfileinfo.h>
 #include <qscopeguard.h>
@@ -172,6 +174,9 @@ struct inotify_event {
 #define IN_UNMOUNT              0x00002000
 #define IN_Q_OVERFLOW           0x00004000
 #define IN_IGNORED              0x00008000
+#define IN_ONLYDIR              0x01000000
+#define IN_DONT_FOLLOW          0x02000000
+#define IN_MASK_ADD             0x20000000
 
 #define IN_CLOSE                (IN_CLOSE_WRITE | IN_CLOSE_NOWRITE)
 #define IN_MOVE                 (IN_MOVED_FROM | IN_MOVED_TO)
@@ -197,6 +202,20 @@ static inline int inotify_init1(int flags)
 
 QT_BEGIN_NAMESPACE
 
+// directories below a recursively watched directory; added to the mask of
+// the watch, in case the directory is watched through addPaths() as well
+static constexpr uint32_t SubdirectoryMask = IN_ATTRIB | IN_MOVE | IN_CREATE | IN_DELETE
+        | IN_DELETE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW | IN_MASK_ADD;
+
+// how many directories of recursive watches are listed per event loop iteration
+static constexpr int ScanBatchSize = 64;
+
+static bool isBelow(const QString &path, const QString &root)
+{
+    return path.size() > root.size() && path.startsWith(root)
+            && (root.endsWith(u'/') || path.at(root.size()) == u'/');
+}
+
 QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
 {
     int fd = -1;
@@ -318,6 +337,7 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
 
         if (id < 0) {
             directories->removeAll(path);
+            removeRecursiveWatch(path);
         } else {
             files->removeAll(path);
         }
@@ -326,6 +346,157 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
     return unhandled;
 }
 
+bool QInotifyFileSystemWatcherEngine::addRecursivePath(const QString &path,
+                                                       QStringList *directories)
+{
+    if (directories->contains(path) || !QFileInfo(path).isDir())
+        return false;
+
+    QStringList files;
+    if (!addPaths(QStringList(path), &files, directories).isEmpty())
+        return false;
+
+    // Don't walk the tree here: it may have hundreds of thousands of
+    // directories. scanPendingDirectories() adds their watches in batches.
+    recursiveWatches[path].pending.append(path);
+    if (!scanTimer.isActive())
+        scanTimer.start(0, this);
+    return true;
+}
+
+void QInotifyFileSystemWatcherEngine::timerEvent(QTimerEvent *event)
+{
+    if (event->id() == scanTimer.id())
+        scanPendingDirectories();
+    else
+        QFileSystemWatcherEngine::timerEvent(event);
+}
+
+void QInotifyFileSystemWatcherEngine::scanPendingDirectories()
+{
+    using F = QDirListing::IteratorFlag;
+
+    int budget = ScanBatchSize;
+    bool done = true;
+    for (auto it = recursiveWatches.begin(), end = recursiveWatches.end(); it != end; ++it) {
+        RecursiveWatch &watch = it.value();
+        while (budget > 0 && !watch.pending.isEmpty()) {
+            const QString dir = watch.pending.takeFirst();
+            // skip directories that were removed while they were pending
+            if (dir != it.key() && !watch.subdirectories.contains(dir))
+                continue;
+            --budget;
+            if (dir != it.key() && !QFileInfo(dir).isDir()) {
+                // removed while the events were dropped, see rescanRecursiveWatches()
+                removeSubdirectoryWatches(watch, dir);
+                continue;
+            }
+            for (const auto &entry : QDirListing(dir, F::DirsOnly | F::IncludeHidden))
+                addSubdirectoryWatch(watch, entry.filePath());
+        }
+        if (!watch.pending.isEmpty())
+            done = false;
+    }
+
+    if (done)
+        scanTimer.stop();
+}
+
+// The kernel dropped events, so directories may have been created, moved or
+// removed without us knowing: list the trees of the recursive watches again.
+void QInotifyFileSystemWatcherEngine::rescanRecursiveWatches()
+{
+    for (auto it = recursiveWatches.begin(), end = recursiveWatches.end(); it != end; ++it) {
+        RecursiveWatch &watch = it.value();
+        watch.pending = watch.subdirectories.keys();
+        watch.pending.prepend(it.key());
+    }
+    if (!recursiveWatches.isEmpty() && !scanTimer.isActive())
+        scanTimer.start(0, this);
+}
+
+QInotifyFileSystemWatcherEngine::RecursiveWatch *
+QInotifyFileSystemWatcherEngine::recursiveWatchFor(const QString &path)
+{
+    for (auto it = recursiveWatches.begin(), end = recursiveWatches.end(); it != end; ++it) {
+        if (it.key() == path || isBelow(path, it.key()))
+            return &it.value();
+    }
+    return nullptr;
+}
+
+void QInotifyFileSystemWatcherEngine::releaseWatch(int id, const QString &path)
+{
+    auto path_range = idToPath.equal_range(id);
+    auto path_it = std::find(path_range.first, path_range.second, path);
+    if (path_it == path_range.second)
+        return;
+
+    const ssize_t num_elements = std::distance(path_range.first, path_range.second);
+    idToPath.erase(path_it);
+    if (num_elements == 1)
+        inotify_rm_watch(inotifyFd, id < 0 ? -id : id);
+}
+
+void QInotifyFileSystemWatcherEngine::addSubdirectoryWatch(RecursiveWatch &watch,
+                                                           const QString &path)
+{
+    if (watchLimitReached || watch.subdirectories.contains(path))
+        return;
+
+    const int wd = inotify_add_watch(inotifyFd, QFile::encodeName(path), SubdirectoryMask);
+    if (wd < 0) {
+        // ENOENT and ENOTDIR are expected: the directory is already gone,
+        // or it's a symlink to a directory
+        if (errno == ENOSPC) {
+            qWarning("QFileSystemWatcher: reached the limit of inotify watches, "
+                     "not all subdirectories are watched");
+            watchLimitReached = true;
+        }
+        return;
+    }
+
+    const int id = -wd;
+    watch.subdirectories.insert(path, id);
+    idToPath.insert(id, path);
+    watch.pending.append(path);
+    if (!scanTimer.isActive())
+        scanTimer.start(0, this);
+}
+
+void QInotifyFileSystemWatcherEngine::removeSubdirectoryWatches(RecursiveWatch &watch,
+                                                                const QString &path)
+{
+    auto it = watch.subdirectories.find(path);
+    if (it != watch.subdirectories.end()) {
+        releaseWatch(it.value(), it.key());
+        watch.subdirectories.erase(it);
+    }
+
+    // the subdirectories of path are the keys that start with path + '/',
+    // and they sort next to each other
+    const QString prefix = path + u'/';
+    it = watch.subdirectories.lowerBound(prefix);
+    while (it != watch.subdirectories.end() && it.key().startsWith(prefix)) {
+        releaseWatch(it.value(), it.key());
+        it = watch.subdirectories.erase(it);
+    }
+}
+
+void QInotifyFileSystemWatcherEngine::removeRecursiveWatch(const QString &root)
+{
+    const auto it = recursiveWatches.constFind(root);
+    if (it == recursiveWatches.cend())
+        return;
+
+    for (auto subdir = it->subdirectories.cbegin(), end = it->subdirectories.cend();
+         subdir != end; ++subdir) {
+        releaseWatch(subdir.value(), subdir.key());
+    }
+    recursiveWatches.erase(it);
+    watchLimitReached = false;
+}
+
 void QInotifyFileSystemWatcherEngine::readFromInotify()
 {
     // qDebug("QInotifyFileSystemWatcherEngine::readFromInotify");
@@ -343,6 +514,22 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
     while (at < end) {
         inotify_event *event = reinterpret_cast<inotify_event *>(at);
 
+        // The name of the entry is lost when coalescing, so keep the trees
+        // of recursive watches up to date first.
+        if ((event->mask & IN_ISDIR) && event->len > 0 && !recursiveWatches.isEmpty()) {
+            const QString parent = getPathFromID(-event->wd);
+            if (RecursiveWatch *watch = parent.isEmpty() ? nullptr : recursiveWatchFor(parent)) {
+                QString subdirectory = parent;
+                if (!subdirectory.endsWith(u'/'))
+                    subdirectory += u'/';
+                subdirectory += QFile::decodeName(event->name);
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    addSubdirectoryWatch(*watch, subdirectory);
+                else if (event->mask & IN_MOVED_FROM)
+                    removeSubdirectoryWatches(*watch, subdirectory);
+            }
+        }
+
         if (eventForId.contains(event->wd))
             eventForId[event->wd]->mask |= event->mask;
         else
@@ -358,6 +545,15 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
 
         // qDebug() << "inotify event, wd" << event.wd << "mask" << Qt::hex << event.mask;
 
+        if (event.mask & IN_Q_OVERFLOW) {
+            // events were dropped, so anything in a recursive tree may have changed
+            rescanRecursiveWatches();
+            const QStringList roots = recursiveWatches.keys();
+            for (const QString &root : roots)
+                emit directoryChanged(root, false);
+            continue;
+        }
+
         int id = event.wd;
         QString path = getPathFromID(id);
         if (path.isEmpty()) {
@@ -371,6 +567,16 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
         // qDebug() << "event for path" << path;
 
         if ((event.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) != 0) {
+            if (id < 0) {
+                RecursiveWatch *watch = recursiveWatchFor(path);
+                if (watch && watch->subdirectories.contains(path)) {
+                    // already reported as a change in the parent directory
+                    removeSubdirectoryWatches(*watch, path);
+                    continue;
+                }
+                removeRecursiveWatch(path);
+            }
+
             pathToID.remove(path);
             idToPath.remove(id, getPathFromID(id));
             if (!idToPath.contains(id))
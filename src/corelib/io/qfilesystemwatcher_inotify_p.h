@@ -19,7 +19,9 @@
 
 QT_REQUIRE_CONFIG(filesystemwatcher);
 
+#include <QtCore/qbasictimer.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qsocketnotifier.h>
 
@@ -36,18 +38,38 @@ public:
 
     QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
     QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
+    bool addRecursivePath(const QString &path, QStringList *directories) override;
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
 
 private Q_SLOTS:
     void readFromInotify();
 
 private:
+    struct RecursiveWatch {
+        // path -> id, excluding the root; sorted, so that a subtree is a range
+        QMap<QString, int> subdirectories;
+        QStringList pending; // watched, but their subdirectories aren't yet
+    };
+
     QString getPathFromID(int id) const;
+    RecursiveWatch *recursiveWatchFor(const QString &path);
+    void releaseWatch(int id, const QString &path);
+    void addSubdirectoryWatch(RecursiveWatch &watch, const QString &path);
+    void removeSubdirectoryWatches(RecursiveWatch &watch, const QString &path);
+    void removeRecursiveWatch(const QString &root);
+    void scanPendingDirectories();
+    void rescanRecursiveWatches();
 
 private:
     QInotifyFileSystemWatcherEngine(int fd, QObject *parent);
     int inotifyFd;
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
+    QHash<QString, RecursiveWatch> recursiveWatches;
+    QBasicTimer scanTimer;
+    bool watchLimitReached = false;
     QSocketNotifier notifier;
 };
 
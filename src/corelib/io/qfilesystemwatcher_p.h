@@ -48,6 +48,14 @@ public:
     virtual QStringList removePaths(const QStringList &paths,
                                     QStringList *files,
                                     QStringList *directories) = 0;
+    // watches \a path and all directories below it, reporting changes in
+    // any of them with directoryChanged(); adds \a path to \a directories
+    virtual bool addRecursivePath(const QString &path, QStringList *directories)
+    {
+        Q_UNUSED(path);
+        Q_UNUSED(directories);
+        return false;
+    }
 
 Q_SIGNALS:
     void fileChanged(const QString &path, bool removed);
@@ -67,6 +75,9 @@ public:
 
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
+    QStringList recursiveDirectories;
+
+    bool isInRecursiveTree(const QString &path) const;
 
     // private slots
     void fileChanged(const QString &path, bool removed);
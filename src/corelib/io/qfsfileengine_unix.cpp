@@ -517,6 +517,8 @@ bool QFSFileEngine::setSize(qint64 size)
         ret = QT_TRUNCATE(d->fileEntry.nativeFilePath().constData(), size) == 0;
     if (!ret)
         setError(QFile::ResizeError, qt_error_string(errno));
+    else
+        d->metaData.clearFlags(QFileSystemMetaData::SizeAttribute);
     return ret;
 }
 
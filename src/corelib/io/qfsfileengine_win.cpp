@@ -712,6 +712,7 @@ bool QFSFileEngine::setSize(qint64 size)
 
         if (seek(size) && SetEndOfFile(fh)) {
             seek(qMin(currentPos, size));
+            d->metaData.clearFlags(QFileSystemMetaData::SizeAttribute);
             return true;
         }
 
@@ -726,6 +727,8 @@ bool QFSFileEngine::setSize(qint64 size)
             bool ret = file.resize(size);
             if (!ret)
                 setError(QFile::ResizeError, file.errorString());
+            else
+                d->metaData.clearFlags(QFileSystemMetaData::SizeAttribute);
             return ret;
         }
     }
@@ -309,6 +309,19 @@ QIODevicePrivate::~QIODevicePrivate()
                      classes might use this flag in the future, but until then
                      using this flag with any classes other than QFile may
                      result in undefined behavior. (since Qt 5.11)
+    \value MemoryMapped Serve reads from a memory mapping of the file instead
+                     of copying them through the device's buffer. This flag
+                     only has an effect when QFile opens a regular, non-empty
+                     file by name for reading only, and implies Unbuffered;
+                     if the file cannot be mapped, it is read normally and
+                     the flag is not part of openMode(). Files opened from
+                     an existing FILE pointer or file descriptor are never
+                     mapped. If another process truncates the file while it
+                     is mapped, reading past the new end raises \c SIGBUS on
+                     Unix systems, so only use this flag for files that are
+                     not modified while they are open. This flag currently
+                     only affects QFile.
+                     (since Qt 6.9)
 
     Certain flags, such as \c Unbuffered and \c Truncate, are
     meaningless when used with some subclasses. Some of these
@@ -2378,6 +2391,8 @@ QDebug operator<<(QDebug debug, QIODevice::OpenMode modes)
             modeList << "Text"_L1;
         if (modes & QIODevice::Unbuffered)
             modeList << "Unbuffered"_L1;
+        if (modes & QIODevice::MemoryMapped)
+            modeList << "MemoryMapped"_L1;
     }
     std::sort(modeList.begin(), modeList.end());
     debug << modeList.join(u'|');
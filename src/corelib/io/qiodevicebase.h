@@ -23,7 +23,8 @@ public:
         Text = 0x0010,
         Unbuffered = 0x0020,
         NewOnly = 0x0040,
-        ExistingOnly = 0x0080
+        ExistingOnly = 0x0080,
+        MemoryMapped = 0x0100
     };
     Q_DECLARE_FLAGS(OpenMode, OpenModeFlag)
 };
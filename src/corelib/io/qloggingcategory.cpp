@@ -184,6 +184,7 @@ void QLoggingCategory::init(const char *category, QtMsgType severityLevel)
         name = category;
     else
         name = qtDefaultCategoryName;
+    enableForLevel = quint8(severityLevel);
 
     if (QLoggingRegistry *reg = QLoggingRegistry::instance())
         reg->registerCategory(this, severityLevel);
@@ -53,7 +53,10 @@ private:
         AtomicBools bools;
         QBasicAtomicInt enabled;
     };
-    Q_DECL_UNUSED_MEMBER bool placeholder[4]; // reserved for future use
+    quint8 enableForLevel;  // used by the default filter
+    Q_DECL_UNUSED_MEMBER bool placeholder[3]; // reserved for future use
+
+    friend class QLoggingRegistry;
 };
 
 namespace { // allow different TUs to have different QT_NO_xxx_OUTPUT
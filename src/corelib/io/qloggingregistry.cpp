@@ -239,6 +239,11 @@ QLoggingRegistry::QLoggingRegistry()
     initializeRules(); // Init on first use
 }
 
+QLoggingRegistry::~QLoggingRegistry()
+{
+    delete activeRules.loadRelaxed();
+}
+
 static bool qtLoggingDebug()
 {
     static const bool debugEnv = [] {
@@ -332,16 +337,37 @@ void QLoggingRegistry::initializeRules()
     Registers a category object.
 
     This method might be called concurrently for the same category object.
+    With the default filter, only the shard of the category is locked.
 */
 void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableForLevel)
 {
-    const auto locker = qt_scoped_lock(registryMutex);
+    Q_ASSERT(cat->enableForLevel == enableForLevel);
+    CategoryShard &categoryShard = shard(cat);
+
+    bool inserted = false;
+    if (categoryFilter.load(std::memory_order_acquire) == defaultCategoryFilter) {
+        const auto locker = qt_scoped_lock(categoryShard.mutex);
+        if (categoryShard.categories.contains(cat))
+            return;
+        categoryShard.categories.insert(cat);
+        inserted = true;
+
+        // a new filter is stored before it is applied to each shard
+        if (categoryFilter.load(std::memory_order_acquire) == defaultCategoryFilter) {
+            applyRules(cat, activeRules.loadAcquire());
+            return;
+        }
+    }
 
-    auto r = categories.tryEmplace(cat, enableForLevel);
-    if (r.inserted) {
-        // new entry
-        (*categoryFilter)(cat);
+    // a custom filter is never called concurrently
+    const auto locker = qt_scoped_lock(registryMutex);
+    if (!inserted) {
+        const auto shardLocker = qt_scoped_lock(categoryShard.mutex);
+        if (categoryShard.categories.contains(cat))
+            return;
+        categoryShard.categories.insert(cat);
     }
+    (*categoryFilter.load(std::memory_order_relaxed))(cat);
 }
 
 /*!
@@ -350,8 +376,9 @@ void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableF
 */
 void QLoggingRegistry::unregisterCategory(QLoggingCategory *cat)
 {
-    const auto locker = qt_scoped_lock(registryMutex);
-    categories.remove(cat);
+    CategoryShard &categoryShard = shard(cat);
+    const auto locker = qt_scoped_lock(categoryShard.mutex);
+    categoryShard.categories.remove(cat);
 }
 
 /*!
@@ -383,21 +410,75 @@ void QLoggingRegistry::setApiRules(const QString &content)
 
     const QMutexLocker locker(&registryMutex);
 
-    ruleSets[ApiRules] = parser.rules();
+    // only the categories matched by the rules after the common ones can change
+    QList<QLoggingRule> rules = parser.rules();
+    const QList<QLoggingRule> &oldRules = ruleSets[ApiRules];
+    const auto common = std::mismatch(oldRules.cbegin(), oldRules.cend(),
+                                      rules.cbegin(), rules.cend());
+    QList<QLoggingRule> changedRules(common.first, oldRules.cend());
+    changedRules.append(common.second, rules.cend());
+    // a custom filter is still passed all the categories, as it always was
+    if (changedRules.isEmpty()
+            && categoryFilter.load(std::memory_order_relaxed) == defaultCategoryFilter) {
+        return;
+    }
 
-    updateRules();
+    ruleSets[ApiRules] = std::move(rules);
+
+    updateRules(changedRules);
 }
 
 /*!
     \internal
-    Activates a new set of logging rules for the default filter.
+    Activates a new set of logging rules for the default filter, and passes
+    all the categories to the current filter.
 
     (The caller must lock registryMutex to make sure the API is thread safe.)
 */
 void QLoggingRegistry::updateRules()
 {
-    for (auto it = categories.keyBegin(), end = categories.keyEnd(); it != end; ++it)
-        (*categoryFilter)(*it);
+    updateRules({});
+}
+
+/*!
+    \internal
+    \overload
+
+    Like updateRules(), but the default filter is only applied to the
+    categories that match one of \a changedRules, as the other ones keep their
+    configuration. If \a changedRules is empty, it is applied to all of them.
+*/
+void QLoggingRegistry::updateRules(QSpan<const QLoggingRule> changedRules)
+{
+    QList<QLoggingRule> rules;
+    for (const auto &ruleSet : ruleSets)
+        rules += ruleSet;
+    const QList<QLoggingRule> *newRules = new const QList<QLoggingRule>(std::move(rules));
+    const QList<QLoggingRule> *oldRules = activeRules.fetchAndStoreAcquire(newRules);
+
+    auto matchesChangedRule = [changedRules](QLoggingCategory *cat) {
+        if (changedRules.empty())
+            return true;
+        const auto categoryName = QLatin1StringView(cat->categoryName());
+        return std::any_of(changedRules.begin(), changedRules.end(), [&](const QLoggingRule &rule) {
+            const QtMsgType type = rule.messageType == -1 ? QtDebugMsg : QtMsgType(rule.messageType);
+            return rule.pass(categoryName, type) != 0;
+        });
+    };
+
+    const QLoggingCategory::CategoryFilter filter = categoryFilter.load(std::memory_order_relaxed);
+    for (CategoryShard &categoryShard : shards) {
+        const auto locker = qt_scoped_lock(categoryShard.mutex);
+        for (QLoggingCategory *cat : std::as_const(categoryShard.categories)) {
+            if (filter != defaultCategoryFilter)
+                (*filter)(cat);
+            else if (matchesChangedRule(cat))
+                applyRules(cat, newRules);
+        }
+    }
+
+    // every shard was locked since, so nothing is still reading the old rules
+    delete oldRules;
 }
 
 /*!
@@ -412,8 +493,8 @@ QLoggingRegistry::installFilter(QLoggingCategory::CategoryFilter filter)
     if (!filter)
         filter = defaultCategoryFilter;
 
-    QLoggingCategory::CategoryFilter old = categoryFilter;
-    categoryFilter = filter;
+    QLoggingCategory::CategoryFilter old = categoryFilter.exchange(filter,
+                                                                   std::memory_order_acq_rel);
 
     updateRules();
 
@@ -434,8 +515,17 @@ QLoggingRegistry *QLoggingRegistry::instance()
 void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
 {
     const QLoggingRegistry *reg = QLoggingRegistry::instance();
-    Q_ASSERT(reg->categories.contains(cat));
-    QtMsgType enableForLevel = reg->categories.value(cat);
+    reg->applyRules(cat, reg->activeRules.loadAcquire());
+}
+
+/*!
+    \internal
+    Updates category settings according to \a rules, the snapshot of all the
+    rule sets.
+*/
+void QLoggingRegistry::applyRules(QLoggingCategory *cat, const QList<QLoggingRule> *rules) const
+{
+    const QtMsgType enableForLevel = QtMsgType(cat->enableForLevel);
 
     // NB: note that the numeric values of the Qt*Msg constants are
     //     not in severity order.
@@ -453,8 +543,8 @@ void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
             debug = false;
         } else if (strncmp(categoryName, "qt.", 3) == 0) {
             // may be overridden
-            auto it = reg->qtCategoryEnvironmentOverrides.find(categoryName);
-            if (it == reg->qtCategoryEnvironmentOverrides.end())
+            auto it = qtCategoryEnvironmentOverrides.find(categoryName);
+            if (it == qtCategoryEnvironmentOverrides.end())
                 debug = false;
             else
                 debug = qEnvironmentVariableIntValue(it->second);
@@ -463,8 +553,8 @@ void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
 
     const auto categoryName = QLatin1StringView(cat->categoryName());
 
-    for (const auto &ruleSet : reg->ruleSets) {
-        for (const auto &rule : ruleSet) {
+    if (rules) {
+        for (const auto &rule : *rules) {
             int filterpass = rule.pass(categoryName, QtDebugMsg);
             if (filterpass != 0)
                 debug = (filterpass > 0);
@@ -20,9 +20,12 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qspan.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qtextstream.h>
 
+#include <atomic>
 #include <map>
 
 class tst_QLoggingRegistry;
@@ -83,6 +86,13 @@ public:
 
 private:
     void parse(QStringView pattern);
+
+    friend bool comparesEqual(const QLoggingRule &lhs, const QLoggingRule &rhs) noexcept
+    {
+        return lhs.category == rhs.category && lhs.messageType == rhs.messageType
+                && lhs.flags == rhs.flags && lhs.enabled == rhs.enabled;
+    }
+    Q_DECLARE_EQUALITY_COMPARABLE(QLoggingRule)
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QLoggingRule::PatternFlags)
@@ -111,6 +121,7 @@ class Q_AUTOTEST_EXPORT QLoggingRegistry
     Q_DISABLE_COPY_MOVE(QLoggingRegistry)
 public:
     QLoggingRegistry();
+    ~QLoggingRegistry();
 
     void initializeRules();
 
@@ -131,8 +142,10 @@ public:
 
 private:
     void updateRules();
+    void updateRules(QSpan<const QLoggingRule> changedRules);
 
     static void defaultCategoryFilter(QLoggingCategory *category);
+    void applyRules(QLoggingCategory *category, const QList<QLoggingRule> *rules) const;
 
     enum RuleSet {
         // sorted by order in which defaultCategoryFilter considers them:
@@ -144,14 +157,34 @@ private:
         NumRuleSets
     };
 
+    // The categories are spread over several shards, so that the categories
+    // created concurrently don't contend for the same lock
+    struct CategoryShard
+    {
+        QMutex mutex;
+        QSet<QLoggingCategory *> categories;
+    };
+    static constexpr size_t ShardCount = 16;
+    CategoryShard &shard(QLoggingCategory *category)
+    { return shards[qHash(category) % ShardCount]; }
+
+    // Serializes the rule updates and the calls to a custom filter. When both
+    // are needed, it is locked before the mutex of a shard.
     QMutex registryMutex;
 
-    // protected by mutex:
+    // protected by registryMutex:
     QList<QLoggingRule> ruleSets[NumRuleSets];
-    QHash<QLoggingCategory *, QtMsgType> categories;
-    QLoggingCategory::CategoryFilter categoryFilter;
     std::map<QByteArrayView, const char *> qtCategoryEnvironmentOverrides;
 
+    // Written with registryMutex held, and read with the mutex of a shard
+    // held. The rules are an immutable snapshot of all the rule sets, so that
+    // the new categories can be configured without locking registryMutex. A
+    // snapshot is deleted once every shard has been locked after replacing it.
+    std::atomic<QLoggingCategory::CategoryFilter> categoryFilter;
+    QAtomicPointer<const QList<QLoggingRule>> activeRules;
+
+    CategoryShard shards[ShardCount];
+
     friend class ::tst_QLoggingRegistry;
 };
 
@@ -25,6 +25,7 @@
 #include <qdir.h>
 #include <qlist.h>
 #include <qmutex.h>
+#include <qscopeguard.h>
 #include <qsocketnotifier.h>
 #include <qthread.h>
 
@@ -52,6 +53,16 @@
 #include <forkfd.h>
 #endif
 
+#if QT_CONFIG(process) && defined(Q_OS_LINUX) && QT_CONFIG(forkfd_pidfd) && defined(__GLIBC__)
+#  include <spawn.h>
+// pidfd_spawn() and pidfd_getpid() were added in glibc 2.39
+#  if __GLIBC_PREREQ(2, 39)
+#    include <sys/pidfd.h>
+#    define QPROCESS_USE_POSIX_SPAWN
+extern "C" int qt_forkfd_uses_pidfd(void);      // in forkfd_qt.c
+#  endif
+#endif
+
 #ifndef O_PATH
 #  define O_PATH        0
 #endif
@@ -338,6 +349,10 @@ struct QChildProcess
         return ::vforkfd(ffdflags, pid, &QChildProcess::startProcess, this);
     }
 
+#ifdef QPROCESS_USE_POSIX_SPAWN
+    int spawnChild(pid_t *pid) const noexcept;
+#endif
+
 private:
     Q_NORETURN void startProcess() const noexcept;
     static int startProcess(void *self) noexcept
@@ -731,7 +746,12 @@ void QProcessPrivate::startProcess()
     }
 
     // Start the child.
-    forkfd = childProcess.startChild(&pid);
+    forkfd = -1;
+#ifdef QPROCESS_USE_POSIX_SPAWN
+    forkfd = childProcess.spawnChild(&pid);
+#endif
+    if (forkfd == -1)
+        forkfd = childProcess.startChild(&pid);
     int lastForkErrno = errno;
 
     if (forkfd == -1) {
@@ -747,10 +767,13 @@ void QProcessPrivate::startProcess()
         return;
     }
 
-    Q_ASSERT(pid > 0);
+    // see spawnChild() for when the PID can be unknown
+    Q_ASSERT(pid >= 0);
 
     // parent
-    // close the ends we don't use and make all pipes non-blocking
+    // close the ends we don't use and make all pipes non-blocking (our ends
+    // are freshly created pipes, so O_NONBLOCK is the only status flag they
+    // need and we don't have to F_GETFL first)
     qt_safe_close(childStartedPipe[1]);
     childStartedPipe[1] = -1;
 
@@ -760,7 +783,7 @@ void QProcessPrivate::startProcess()
     }
 
     if (stdinChannel.pipe[1] != -1)
-        ::fcntl(stdinChannel.pipe[1], F_SETFL, ::fcntl(stdinChannel.pipe[1], F_GETFL) | O_NONBLOCK);
+        ::fcntl(stdinChannel.pipe[1], F_SETFL, O_NONBLOCK);
 
     if (stdoutChannel.pipe[1] != -1) {
         qt_safe_close(stdoutChannel.pipe[1]);
@@ -768,14 +791,14 @@ void QProcessPrivate::startProcess()
     }
 
     if (stdoutChannel.pipe[0] != -1)
-        ::fcntl(stdoutChannel.pipe[0], F_SETFL, ::fcntl(stdoutChannel.pipe[0], F_GETFL) | O_NONBLOCK);
+        ::fcntl(stdoutChannel.pipe[0], F_SETFL, O_NONBLOCK);
 
     if (stderrChannel.pipe[1] != -1) {
         qt_safe_close(stderrChannel.pipe[1]);
         stderrChannel.pipe[1] = -1;
     }
     if (stderrChannel.pipe[0] != -1)
-        ::fcntl(stderrChannel.pipe[0], F_SETFL, ::fcntl(stderrChannel.pipe[0], F_GETFL) | O_NONBLOCK);
+        ::fcntl(stderrChannel.pipe[0], F_SETFL, O_NONBLOCK);
 }
 
 // we need an errno number to use to indicate the child process modifier threw,
@@ -919,6 +942,80 @@ static void callChildProcessModifier(const QProcessPrivate *d) noexcept
     }
 }
 
+#ifdef QPROCESS_USE_POSIX_SPAWN
+// Starts the child with pidfd_spawn() and returns its pidfd, which
+// forkfd_wait4() and the event dispatcher treat like any other forkfd.
+// pidfd_spawn() returns only after the child has execve()'d or failed to, so
+// none of our code needs to run on the child side. That is only possible if
+// the user didn't ask for a child process modifier or any of the other
+// UnixProcessParameters. Returns -1 if this method can't be used or no child
+// was started, in which case the caller falls back to startChild(), which will
+// report any errors in detail.
+//
+// The pidfd is created together with the child, so unlike with posix_spawn()
+// and pidfd_open(), there's no window in which the child could be reaped by a
+// waitpid(-1) elsewhere in the application, or by the kernel if SIGCHLD is
+// ignored, and its PID be reused.
+int QChildProcess::spawnChild(pid_t *pid) const noexcept
+{
+    if (d->unixExtras || !isUsingVfork || !qt_forkfd_uses_pidfd())
+        return -1;
+
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    if (posix_spawn_file_actions_init(&actions) != 0)
+        return -1;
+    if (posix_spawnattr_init(&attr) != 0) {
+        posix_spawn_file_actions_destroy(&actions);
+        return -1;
+    }
+    auto cleanup = qScopeGuard([&] {
+        posix_spawnattr_destroy(&attr);
+        posix_spawn_file_actions_destroy(&actions);
+    });
+
+    // same as commitChannels() and the fchdir() in startProcess()
+    bool ok = true;
+    if (d->stdinChannel.pipe[0] != INVALID_Q_PIPE)
+        ok = ok && posix_spawn_file_actions_adddup2(&actions, d->stdinChannel.pipe[0], STDIN_FILENO) == 0;
+    if (d->stdoutChannel.pipe[1] != INVALID_Q_PIPE)
+        ok = ok && posix_spawn_file_actions_adddup2(&actions, d->stdoutChannel.pipe[1], STDOUT_FILENO) == 0;
+    if (d->stderrChannel.pipe[1] != INVALID_Q_PIPE)
+        ok = ok && posix_spawn_file_actions_adddup2(&actions, d->stderrChannel.pipe[1], STDERR_FILENO) == 0;
+    else if (d->processChannelMode == QProcess::MergedChannels)
+        ok = ok && posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO) == 0;
+    if (workingDirectory >= 0)
+        ok = ok && posix_spawn_file_actions_addfchdir_np(&actions, workingDirectory) == 0;
+
+    // We've blocked all signals in the parent (see maybeBlockSignals()), so
+    // give the child the original mask. And reset SIGPIPE, which we may have
+    // ignored.
+    sigset_t sigpipe;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    ok = ok && posix_spawnattr_setsigmask(&attr, &oldsigset) == 0;
+    ok = ok && posix_spawnattr_setsigdefault(&attr, &sigpipe) == 0;
+    ok = ok && posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF) == 0;
+    if (!ok)
+        return -1;
+
+    int pidfd;
+    if (pidfd_spawn(&pidfd, argv[0], &actions, &attr, argv,
+                    envp.pointers ? envp.pointers.get() : environ) != 0) {
+        return -1;
+    }
+
+    // From here on, the child has run, so it must not be started again.
+    // pidfd_getpid() only fails if the child has already exited and been
+    // reaped by someone else. Then its PID is unknown, and forkfd_wait4()
+    // reports no status, as it does for a forkfd child reaped that way.
+    // pidfds are always close-on-exec, like forkfd's FFD_CLOEXEC.
+    const pid_t childPid = pidfd_getpid(pidfd);
+    *pid = childPid > 0 ? childPid : 0;
+    return pidfd;
+}
+#endif
+
 // IMPORTANT:
 //
 // This function is called in a vfork() context on some OSes (notably, Linux
@@ -16,6 +16,8 @@
 #include "qstringlist.h"
 #include "qendian.h"
 #include <qshareddata.h>
+#include <qcache.h>
+#include <qmutex.h>
 #include <qplatformdefs.h>
 #include <qendian.h>
 #include "private/qabstractfileengine_p.h"
@@ -113,7 +115,8 @@ public:
         // must match rcc.h
         Compressed = 0x01,
         Directory = 0x02,
-        CompressedZstd = 0x04
+        CompressedZstd = 0x04,
+        CompressedChunks = 0x08
     };
 
 private:
@@ -125,12 +128,15 @@ private:
     short flags(int node) const;
 public:
     mutable QAtomicInt ref;
+    // identifies the data for caching, as the address may be reused once unregistered
+    const quint64 serial = newSerial();
 
     inline QResourceRoot(): tree(nullptr), names(nullptr), payloads(nullptr), version(0) {}
     inline QResourceRoot(int version, const uchar *t, const uchar *n, const uchar *d) { setSource(version, t, n, d); }
     virtual ~QResourceRoot() { }
     int findNode(const QString &path, const QLocale &locale=QLocale()) const;
     inline bool isContainer(int node) const { return flags(node) & Directory; }
+    inline bool isChunked(int node) const { return flags(node) & CompressedChunks; }
     QResource::Compression compressionAlgo(int node)
     {
         uint compressionFlags = flags(node) & (Compressed | CompressedZstd);
@@ -153,6 +159,11 @@ public:
     virtual ResourceRootType type() const { return Resource_Builtin; }
 
 protected:
+    static quint64 newSerial()
+    {
+        Q_CONSTINIT static QBasicAtomicInteger<quint64> lastSerial = Q_BASIC_ATOMIC_INITIALIZER(0);
+        return lastSerial.fetchAndAddRelaxed(1) + 1;
+    }
     inline void setSource(int v, const uchar *t, const uchar *n, const uchar *d) {
         tree = t;
         names = n;
@@ -289,11 +300,16 @@ public:
     void ensureChildren() const;
     qint64 uncompressedSize() const Q_DECL_PURE_FUNCTION;
     qsizetype decompress(char *buffer, qsizetype bufferSize) const;
+    qsizetype chunkSize() const;
+    qsizetype chunkCount() const;
+    qsizetype decompressChunk(qsizetype index, char *buffer, qsizetype bufferSize) const;
 
     bool load(const QString &file);
     void clear();
 
     static bool mayRemapData(const QResource &resource);
+    static bool isChunked(const QResource &resource) { return resource.d_func()->chunked; }
+    static bool readChunks(const QResource &resource, qint64 offset, char *buffer, qint64 len);
 
     QLocale locale;
     QString fileName, absoluteFilePath;
@@ -303,8 +319,9 @@ public:
     const uchar *data;
     mutable QStringList children;
     quint8 compressionAlgo;
+    bool chunked;
     bool container;
-    /* 2 or 6 padding bytes */
+    /* 1 or 5 padding bytes */
 
     QResource *q_ptr;
     Q_DECLARE_PUBLIC(QResource)
@@ -314,6 +331,7 @@ void QResourcePrivate::clear()
 {
     absoluteFilePath.clear();
     compressionAlgo = QResource::NoCompression;
+    chunked = false;
     data = nullptr;
     size = 0;
     children.clear();
@@ -342,10 +360,13 @@ bool QResourcePrivate::load(const QString &file)
                 if (!container) {
                     data = res->data(node, &size);
                     compressionAlgo = res->compressionAlgo(node);
+                    chunked = compressionAlgo != QResource::NoCompression
+                            && res->isChunked(node);
                 } else {
                     data = nullptr;
                     size = 0;
                     compressionAlgo = QResource::NoCompression;
+                    chunked = false;
                 }
                 lastModified = res->lastModified(node);
             } else if (res->isContainer(node) != container) {
@@ -359,6 +380,7 @@ bool QResourcePrivate::load(const QString &file)
             data = nullptr;
             size = 0;
             compressionAlgo = QResource::NoCompression;
+            chunked = false;
             lastModified = 0;
             res->ref.ref();
             related.append(res);
@@ -424,6 +446,10 @@ void QResourcePrivate::ensureChildren() const
 
 qint64 QResourcePrivate::uncompressedSize() const
 {
+    // chunked payloads start with the uncompressed size, like qCompress()'s
+    if (chunked)
+        return size_t(size) >= 2 * sizeof(quint32) ? qFromBigEndian<quint32>(data) : -1;
+
     switch (compressionAlgo) {
     case QResource::NoCompression:
         return size;
@@ -452,12 +478,14 @@ qint64 QResourcePrivate::uncompressedSize() const
     return -1;
 }
 
-qsizetype QResourcePrivate::decompress(char *buffer, qsizetype bufferSize) const
+static qsizetype decompressBlock(quint8 compressionAlgo, char *buffer, qsizetype bufferSize,
+                                 const uchar *data, qsizetype size)
 {
-    Q_ASSERT(data);
 #if defined(QT_NO_COMPRESS) && !QT_CONFIG(zstd)
     Q_UNUSED(buffer);
     Q_UNUSED(bufferSize);
+    Q_UNUSED(data);
+    Q_UNUSED(size);
 #endif
 
     switch (compressionAlgo) {
@@ -468,8 +496,7 @@ qsizetype QResourcePrivate::decompress(char *buffer, qsizetype bufferSize) const
     case QResource::ZlibCompression: {
 #ifndef QT_NO_COMPRESS
         uLong len = uLong(bufferSize);
-        int res = ::uncompress(reinterpret_cast<Bytef *>(buffer), &len, data + sizeof(quint32),
-                               uLong(size - sizeof(quint32)));
+        int res = ::uncompress(reinterpret_cast<Bytef *>(buffer), &len, data, uLong(size));
         if (res != Z_OK) {
             qWarning("QResource: error decompressing zlib content (%d)", res);
             return -1;
@@ -497,6 +524,62 @@ qsizetype QResourcePrivate::decompress(char *buffer, qsizetype bufferSize) const
     return -1;
 }
 
+qsizetype QResourcePrivate::decompress(char *buffer, qsizetype bufferSize) const
+{
+    Q_ASSERT(data);
+    if (!chunked) {
+        // zlib payloads start with the uncompressed size, which zlib doesn't know about
+        const qsizetype skip = compressionAlgo == QResource::ZlibCompression ? sizeof(quint32) : 0;
+        return decompressBlock(compressionAlgo, buffer, bufferSize, data + skip, size - skip);
+    }
+
+    qsizetype total = 0;
+    for (qsizetype i = 0, count = chunkCount(); i < count; ++i) {
+        const qsizetype n = decompressChunk(i, buffer + total, bufferSize - total);
+        if (n < 0)
+            return -1;
+        total += n;
+    }
+    return total;
+}
+
+// Chunked payloads are made of the uncompressed size and the chunk size,
+// followed by the end offset of each compressed chunk, and then the chunks.
+qsizetype QResourcePrivate::chunkSize() const
+{
+    Q_ASSERT(chunked);
+    return size_t(size) >= 2 * sizeof(quint32) ? qFromBigEndian<quint32>(data + 4) : 0;
+}
+
+qsizetype QResourcePrivate::chunkCount() const
+{
+    const qsizetype n = chunkSize();
+    if (n == 0)
+        return 0;
+    const qsizetype count = (uncompressedSize() + n - 1) / n;
+    if (count > (size - 2 * qsizetype(sizeof(quint32))) / qsizetype(sizeof(quint32)))
+        return 0;
+    return count;
+}
+
+qsizetype QResourcePrivate::decompressChunk(qsizetype index, char *buffer,
+                                            qsizetype bufferSize) const
+{
+    const qsizetype count = chunkCount();
+    Q_ASSERT(index < count);
+    const uchar *ends = data + 2 * sizeof(quint32);
+    const uchar *chunks = ends + count * sizeof(quint32);
+    const quint32 begin = index ? qFromBigEndian<quint32>(ends + (index - 1) * sizeof(quint32)) : 0;
+    const quint32 end = qFromBigEndian<quint32>(ends + index * sizeof(quint32));
+    if (begin > end || chunks + end > data + size) {
+        qWarning("QResource: invalid compressed chunk");
+        return -1;
+    }
+    const qsizetype n = chunkSize();
+    bufferSize = qMin(bufferSize, qMin(n, qsizetype(uncompressedSize() - index * n)));
+    return decompressBlock(compressionAlgo, buffer, bufferSize, chunks + begin, end - begin);
+}
+
 /*!
     Constructs a QResource pointing to \a file. \a locale is used to
     load a specific localization of a resource data.
@@ -624,6 +707,10 @@ bool QResource::isValid() const
 
     See \l{http://facebook.github.io/zstd/zstd_manual.html}{Zstandard manual}.
 
+    Since Qt 6.9, \c rcc can compress large files in separately decompressible
+    chunks. The data() of such resources does not consist of a single stream;
+    use uncompressedData() or QFile to read them.
+
     \sa data(), isFile()
 */
 QResource::Compression QResource::compressionAlgorithm() const
@@ -1107,6 +1194,8 @@ public:
 #endif
         if (QT_CONFIG(zstd))
             acceptableFlags |= CompressedZstd;
+        if (acceptableFlags)
+            acceptableFlags |= CompressedChunks;
         if (file_flags & ~acceptableFlags)
             return false;
 
@@ -1377,6 +1466,71 @@ bool QResource::unregisterResource(const uchar *rccData, const QString &resource
 }
 
 #if !defined(QT_BOOTSTRAPPED)
+namespace {
+// Decompressed chunks of chunk-compressed resources, shared by all the QFiles
+// reading them, so that reading large resources doesn't need to decompress
+// them in full.
+struct QResourceChunkCache
+{
+    // the serial of the resource root, and the address of the payload offset
+    // by the chunk index
+    using Key = std::pair<quint64, const uchar *>;
+    static constexpr qsizetype MaxCost = 8 * 1024 * 1024;
+
+    QMutex mutex;
+    QCache<Key, QByteArray> chunks{MaxCost};
+};
+}
+Q_GLOBAL_STATIC(QResourceChunkCache, resourceChunkCache)
+
+bool QResourcePrivate::readChunks(const QResource &resource, qint64 offset, char *buffer,
+                                  qint64 len)
+{
+    const QResourcePrivate *d = resource.d_func();
+    Q_ASSERT(d->chunked);
+    const qsizetype chunkSize = d->chunkSize();
+    const qsizetype chunkCount = d->chunkCount();
+    const qint64 uncompressedSize = d->uncompressedSize();
+    if (chunkSize == 0 || offset + len > uncompressedSize)
+        return false;
+
+    while (len > 0) {
+        const qsizetype index = offset / chunkSize;
+        const qsizetype chunkOffset = offset % chunkSize;
+        const qsizetype chunkLength = qMin(qint64(chunkSize), uncompressedSize - index * chunkSize);
+        if (index >= chunkCount)
+            return false;
+        const qsizetype n = qMin(len, qint64(chunkLength - chunkOffset));
+
+        if (chunkOffset == 0 && n == chunkLength) {
+            // the whole chunk is wanted, no need to go through the cache
+            if (d->decompressChunk(index, buffer, n) != n)
+                return false;
+        } else {
+            QResourceChunkCache *cache = resourceChunkCache();
+            const QResourceChunkCache::Key key(d->related.at(0)->serial, d->data + index);
+            QByteArray chunk;
+            {
+                QMutexLocker locker(&cache->mutex);
+                if (const QByteArray *cached = cache->chunks.object(key))
+                    chunk = *cached;
+            }
+            if (chunk.isNull()) {
+                chunk.resize(chunkLength);
+                if (d->decompressChunk(index, chunk.data(), chunkLength) != chunkLength)
+                    return false;
+                QMutexLocker locker(&cache->mutex);
+                cache->chunks.insert(key, new QByteArray(chunk), chunkLength);
+            }
+            memcpy(buffer, chunk.constData() + chunkOffset, n);
+        }
+        buffer += n;
+        offset += n;
+        len -= n;
+    }
+    return true;
+}
+
 // resource engine
 class QResourceFileEnginePrivate : public QAbstractFileEnginePrivate
 {
@@ -1441,7 +1595,9 @@ bool QResourceFileEngine::open(QIODevice::OpenMode flags,
     }
     if (flags & QIODevice::WriteOnly)
         return false;
-    if (d->resource.compressionAlgorithm() != QResource::NoCompression) {
+    if (d->resource.compressionAlgorithm() != QResource::NoCompression
+            && !QResourcePrivate::isChunked(d->resource)) {
+        // chunked resources are decompressed as they are read, see read()
         d->uncompress();
         if (d->uncompressed.isNull()) {
             d->errorString = QSystemError::stdString(EIO);
@@ -1474,10 +1630,16 @@ qint64 QResourceFileEngine::read(char *data, qint64 len)
         len = size() - d->offset;
     if (len <= 0)
         return 0;
-    if (!d->uncompressed.isNull())
+    if (!d->uncompressed.isNull()) {
         memcpy(data, d->uncompressed.constData() + d->offset, len);
-    else
+    } else if (d->resource.compressionAlgorithm() != QResource::NoCompression) {
+        if (!QResourcePrivate::readChunks(d->resource, d->offset, data, len)) {
+            setError(QFile::ReadError, QSystemError::stdString(EIO));
+            return -1;
+        }
+    } else {
         memcpy(data, d->resource.data() + d->offset, len);
+    }
     d->offset += len;
     return len;
 }
@@ -1616,6 +1778,14 @@ bool QResourceFileEngine::supportsExtension(Extension extension) const
 uchar *QResourceFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags)
 {
     Q_Q(QResourceFileEngine);
+    if (QResourcePrivate::isChunked(resource)) {
+        // mapping needs the data in one piece
+        uncompress();
+        if (uncompressed.isNull()) {
+            q->setError(QFile::UnspecifiedError, QSystemError::stdString(EIO));
+            return nullptr;
+        }
+    }
     Q_ASSERT_X(resource.compressionAlgorithm() == QResource::NoCompression
                || !uncompressed.isNull(), "QFile::map()",
                "open() should have uncompressed compressed resources");
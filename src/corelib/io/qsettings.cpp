@@ -17,6 +17,8 @@
 #include "qtemporaryfile.h"
 #include "qstandardpaths.h"
 #include <qdatastream.h>
+#include <qendian.h>
+#include <qmath.h>
 #include "private/qstringconverter_p.h"
 
 #ifndef QT_NO_GEOM_VARIANT
@@ -53,6 +55,10 @@
 #    define QSETTINGS_USE_QSTANDARDPATHS
 #endif
 
+#if !defined(QT_BOOTSTRAPPED) && !defined(Q_OS_WASM) && QT_CONFIG(temporaryfile)
+#    define QSETTINGS_USE_INI_CACHE
+#endif
+
 // ************************************************************************
 // QConfFile
 
@@ -102,8 +108,82 @@ Q_CONSTINIT static QBasicMutex settingsGlobalMutex;
 
 Q_CONSTINIT static QSettings::Format globalDefaultFormat = QSettings::NativeFormat;
 
+namespace {
+/*
+    Layout of the compiled INI cache file. It is only meant to be read on the
+    machine that wrote it, so everything is in native byte order; a cache
+    written with another byte order or version is simply ignored.
+
+    The header is followed by the hash table (entry index + 1, or 0 for an
+    empty bucket, linear probing), the entries and the string data. Keys and
+    QString values are stored as UTF-16, other values as a serialized QVariant.
+*/
+struct IniCacheHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 byteOrder;
+    qint32 streamVersion;
+    quint32 entryCount;
+    quint32 bucketCount;
+    quint32 reserved;
+    qint64 iniSize;
+    qint64 iniModified;     // msecs since epoch, UTC
+    qint64 journalSize;     // size of the journal when the cache was written
+    qint64 journalEnd;      // end of the journal records applied to the cache
+};
+
+struct IniCacheEntry
+{
+    enum Type : quint32 { String, Variant };
+
+    quint32 hash;
+    Type type;
+    quint32 keyOffset;
+    quint32 keySize;
+    quint32 originalKeyOffset;
+    quint32 originalKeySize;
+    quint32 valueOffset;
+    quint32 valueSize;
+    qint64 position;
+};
+
+constexpr char IniCacheMagic[8] = { 'Q', 'S', 'E', 'T', 'C', 'A', 'C', 'H' };
+constexpr quint32 IniCacheVersion = 1;
+constexpr quint32 IniCacheByteOrder = 0x01020304;
+} // unnamed namespace
+
+class QSettingsIniCache
+{
+public:
+    static std::unique_ptr<QSettingsIniCache> open(const QString &fileName,
+                                                   qint64 iniSize, qint64 iniModified);
+    static bool write(const QString &fileName, const ParsedSettingsMap &map,
+                      qint64 iniSize, qint64 iniModified, qint64 journalSize, qint64 journalEnd,
+                      QFileDevice::Permissions permissions);
+
+    qint64 journalSize() const { return header()->journalSize; }
+    qint64 journalEnd() const { return header()->journalEnd; }
+    std::optional<QVariant> value(const QString &key) const;
+    void readAll(ParsedSettingsMap *map) const;
+
+private:
+    const IniCacheHeader *header() const
+    { return reinterpret_cast<const IniCacheHeader *>(data); }
+    const quint32 *buckets() const
+    { return reinterpret_cast<const quint32 *>(data + sizeof(IniCacheHeader)); }
+    const IniCacheEntry *entries() const;
+    QStringView string(quint32 offset, quint32 size) const;
+    std::optional<QVariant> decodeValue(const IniCacheEntry &entry) const;
+
+    QFile file;
+    QByteArray buffer;      // if the file cannot be mapped
+    const uchar *data = nullptr;
+    qint64 size = 0;
+};
+
 QConfFile::QConfFile(const QString &fileName, bool _userPerms)
-    : name(fileName), size(0), ref(1), userPerms(_userPerms)
+    : name(fileName), size(0), journalSize(0), journalEnd(0), ref(1), userPerms(_userPerms)
 {
     usedHashFunc()->insert(name, this);
 }
@@ -910,6 +990,17 @@ void QConfFileSettingsPrivate::initFormat()
             caseSensitivity = info.caseSensitivity;
         }
     }
+
+#ifdef QSETTINGS_USE_INI_CACHE
+    // The cache and the journal are only understood by QSettings, so
+    // they must be requested explicitly.
+#  ifdef Q_OS_DARWIN
+    const bool isIniFormat = format == QSettings::IniFormat;
+#  else
+    const bool isIniFormat = format <= QSettings::IniFormat;
+#  endif
+    useIniCache = isIniFormat && qEnvironmentVariableIntValue("QT_SETTINGS_INI_CACHE") > 0;
+#endif
 }
 
 void QConfFileSettingsPrivate::initAccess()
@@ -1226,7 +1317,12 @@ std::optional<QVariant> QConfFileSettingsPrivate::get(const QString &key) const
             j = confFile->addedKeys.constFind(theKey);
             found = (j != confFile->addedKeys.constEnd());
         }
-        if (!found) {
+        if (!found && confFile->iniCache) {
+            // look the key up in the mapped cache without materializing it
+            std::optional<QVariant> value = confFile->iniCache->value(theKey);
+            if (value && !confFile->removedKeys.contains(theKey))
+                return value;
+        } else if (!found) {
             ensureSectionParsed(confFile, theKey);
             j = confFile->originalKeys.constFind(theKey);
             found = (j != confFile->originalKeys.constEnd()
@@ -1334,18 +1430,438 @@ bool QConfFileSettingsPrivate::isWritable() const
     return confFiles.at(0)->isWritable();
 }
 
+// ************************************************************************
+// QSettingsIniCache
+
+static quint32 iniCacheHash(QStringView key)
+{
+    // FNV-1a; must not depend on the process, unlike qHash()
+    quint32 h = 2166136261u;
+    for (QChar ch : key) {
+        h ^= ch.unicode();
+        h *= 16777619u;
+    }
+    return h;
+}
+
+std::unique_ptr<QSettingsIniCache> QSettingsIniCache::open(const QString &fileName,
+                                                           qint64 iniSize, qint64 iniModified)
+{
+    auto cache = std::make_unique<QSettingsIniCache>();
+    cache->file.setFileName(fileName);
+    if (!cache->file.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    cache->size = cache->file.size();
+    if (cache->size < qint64(sizeof(IniCacheHeader)) || cache->size > std::numeric_limits<quint32>::max())
+        return nullptr;
+    cache->data = cache->file.map(0, cache->size);
+    if (!cache->data) {
+        cache->buffer = cache->file.readAll();
+        if (cache->buffer.size() != cache->size)
+            return nullptr;
+        cache->data = reinterpret_cast<const uchar *>(cache->buffer.constData());
+    }
+
+    const IniCacheHeader *h = cache->header();
+    if (memcmp(h->magic, IniCacheMagic, sizeof(IniCacheMagic)) != 0
+            || h->version != IniCacheVersion || h->byteOrder != IniCacheByteOrder
+            || h->streamVersion > QDataStream::Qt_DefaultCompiledVersion
+            || h->iniSize != iniSize || h->iniModified != iniModified
+            || h->bucketCount == 0 || (h->bucketCount & (h->bucketCount - 1)) != 0
+            || h->bucketCount < h->entryCount) {
+        return nullptr;
+    }
+    const qint64 tableEnd = sizeof(IniCacheHeader) + qint64(h->bucketCount) * sizeof(quint32)
+            + qint64(h->entryCount) * sizeof(IniCacheEntry);
+    if (tableEnd > cache->size)
+        return nullptr;
+    return cache;
+}
+
+const IniCacheEntry *QSettingsIniCache::entries() const
+{
+    return reinterpret_cast<const IniCacheEntry *>(buckets() + header()->bucketCount);
+}
+
+QStringView QSettingsIniCache::string(quint32 offset, quint32 size) const
+{
+    if (offset % alignof(char16_t) != 0 || qint64(offset) + qint64(size) * 2 > this->size)
+        return {};
+    return QStringView(reinterpret_cast<const char16_t *>(data + offset), size);
+}
+
+std::optional<QVariant> QSettingsIniCache::decodeValue(const IniCacheEntry &entry) const
+{
+    if (entry.type == IniCacheEntry::String) {
+        if (entry.valueSize % 2 != 0)
+            return std::nullopt;
+        QStringView value = string(entry.valueOffset, entry.valueSize / 2);
+        if (value.size() != qsizetype(entry.valueSize / 2))
+            return std::nullopt;
+        return QVariant(value.toString());
+    }
+
+    if (qint64(entry.valueOffset) + entry.valueSize > size)
+        return std::nullopt;
+    const QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(data) + entry.valueOffset,
+                                                     entry.valueSize);
+    QDataStream stream(bytes);
+    stream.setVersion(header()->streamVersion);
+    QVariant value;
+    stream >> value;
+    if (stream.status() != QDataStream::Ok)
+        return std::nullopt;
+    return value;
+}
+
+std::optional<QVariant> QSettingsIniCache::value(const QString &key) const
+{
+    const IniCacheHeader *h = header();
+    const quint32 mask = h->bucketCount - 1;
+    const quint32 hash = iniCacheHash(key);
+
+    for (quint32 i = hash & mask, probes = 0; probes < h->bucketCount; i = (i + 1) & mask, ++probes) {
+        const quint32 index = buckets()[i];
+        if (index == 0 || index > h->entryCount)
+            break;
+        const IniCacheEntry &entry = entries()[index - 1];
+        if (entry.hash == hash && string(entry.keyOffset, entry.keySize) == key)
+            return decodeValue(entry);
+    }
+    return std::nullopt;
+}
+
+void QSettingsIniCache::readAll(ParsedSettingsMap *map) const
+{
+    const IniCacheHeader *h = header();
+    for (quint32 i = 0; i < h->entryCount; ++i) {
+        const IniCacheEntry &entry = entries()[i];
+        const QStringView key = entry.originalKeySize
+                ? string(entry.originalKeyOffset, entry.originalKeySize)
+                : string(entry.keyOffset, entry.keySize);
+        std::optional<QVariant> value = decodeValue(entry);
+        if (key.isEmpty() || !value)
+            continue;
+        map->insert(QSettingsKey(key.toString(), IniCaseSensitivity, entry.position),
+                    std::move(*value));
+    }
+}
+
+#ifdef QSETTINGS_USE_INI_CACHE
+bool QSettingsIniCache::write(const QString &fileName, const ParsedSettingsMap &map,
+                              qint64 iniSize, qint64 iniModified,
+                              qint64 journalSize, qint64 journalEnd,
+                              QFileDevice::Permissions permissions)
+{
+    const quint32 entryCount = quint32(map.size());
+    const quint32 bucketCount = qNextPowerOfTwo(entryCount) * 2;
+
+    IniCacheHeader header = {};
+    memcpy(header.magic, IniCacheMagic, sizeof(IniCacheMagic));
+    header.version = IniCacheVersion;
+    header.byteOrder = IniCacheByteOrder;
+    header.streamVersion = QDataStream::Qt_DefaultCompiledVersion;
+    header.entryCount = entryCount;
+    header.bucketCount = bucketCount;
+    header.iniSize = iniSize;
+    header.iniModified = iniModified;
+    header.journalSize = journalSize;
+    header.journalEnd = journalEnd;
+
+    QList<quint32> buckets(bucketCount, 0);
+    QList<IniCacheEntry> entries;
+    entries.reserve(entryCount);
+    QByteArray strings;
+    const qint64 stringsOffset = sizeof(IniCacheHeader) + qint64(bucketCount) * sizeof(quint32)
+            + qint64(entryCount) * sizeof(IniCacheEntry);
+
+    auto appendData = [&](const void *data, qsizetype size) {
+        const qint64 offset = stringsOffset + strings.size();
+        strings.append(static_cast<const char *>(data), size);
+        if (strings.size() % 2)
+            strings.append('\0');
+        return quint32(offset);
+    };
+
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        const QString &key = it.key();
+        const QString originalKey = it.key().originalCaseKey();
+        IniCacheEntry entry = {};
+        entry.hash = iniCacheHash(key);
+        entry.keyOffset = appendData(key.constData(), key.size() * 2);
+        entry.keySize = quint32(key.size());
+        if (originalKey != key) {
+            entry.originalKeyOffset = appendData(originalKey.constData(), originalKey.size() * 2);
+            entry.originalKeySize = quint32(originalKey.size());
+        }
+        entry.position = it.key().originalKeyPosition();
+
+        const QVariant &value = it.value();
+        if (value.metaType() == QMetaType::fromType<QString>()) {
+            const QString str = value.toString();
+            entry.type = IniCacheEntry::String;
+            entry.valueOffset = appendData(str.constData(), str.size() * 2);
+            entry.valueSize = quint32(str.size() * 2);
+        } else {
+            QByteArray bytes;
+            QDataStream stream(&bytes, QIODevice::WriteOnly);
+            stream.setVersion(header.streamVersion);
+            stream << value;
+            if (stream.status() != QDataStream::Ok)
+                return false;
+            entry.type = IniCacheEntry::Variant;
+            entry.valueOffset = appendData(bytes.constData(), bytes.size());
+            entry.valueSize = quint32(bytes.size());
+        }
+        if (stringsOffset + strings.size() > std::numeric_limits<quint32>::max())
+            return false;
+
+        quint32 i = entry.hash & (bucketCount - 1);
+        while (buckets.at(i) != 0)
+            i = (i + 1) & (bucketCount - 1);
+        entries.append(entry);
+        buckets[i] = quint32(entries.size());
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    // the cache holds the same settings as the INI file, don't make them
+    // readable by more users
+    file.setPermissions(permissions);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(buckets.constData()), bucketCount * sizeof(quint32));
+    file.write(reinterpret_cast<const char *>(entries.constData()), entryCount * sizeof(IniCacheEntry));
+    file.write(strings);
+    return file.commit();
+}
+
+/*
+    The journal records the changes that were synced since the INI file was
+    last written. Its header identifies the version of the INI file it
+    applies to; each record is a big-endian length followed by a QDataStream
+    with the operation, the key and, for Set, the value as it would appear
+    in the INI file, so that replaying it yields the same values as
+    rereading a rewritten file.
+*/
+namespace {
+enum IniJournalOperation : quint8 { IniJournalSet = 1, IniJournalRemove = 2 };
+
+constexpr quint32 IniJournalMagic = 0x51534a4e; // "QSJN"
+constexpr quint32 IniJournalVersion = 1;
+constexpr qint64 IniJournalHeaderSize = 2 * sizeof(quint32) + 2 * sizeof(qint64);
+// the journal is folded into the INI file once it grows past this (or past
+// half the size of the INI file, whichever is larger)
+constexpr qint64 IniJournalMinimumLimit = 64 * 1024;
+} // unnamed namespace
+
+static QString iniCacheFileName(const QString &iniFileName)
+{
+    return iniFileName + ".qtcache"_L1;
+}
+
+static QString iniJournalFileName(const QString &iniFileName)
+{
+    return iniFileName + ".qtjournal"_L1;
+}
+
+static QByteArray iniJournalHeader(qint64 iniSize, qint64 iniModified)
+{
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream << IniJournalMagic << IniJournalVersion << iniSize << iniModified;
+    return header;
+}
+
+static void iniEscapedValue(const QVariant &value, QByteArray &result);
+
+static void appendIniJournalRecord(QByteArray &records, IniJournalOperation operation,
+                                   const QSettingsKey &key, const QVariant *value = nullptr)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << quint8(operation) << key.originalCaseKey();
+    if (value) {
+        QByteArray iniValue;
+        iniEscapedValue(*value, iniValue);
+        stream << iniValue;
+    }
+
+    char length[sizeof(quint32)];
+    qToBigEndian(quint32(payload.size()), length);
+    records.append(length, sizeof(length));
+    records.append(payload);
+}
+
+/*
+    Applies the records of \a journal starting at \a from (or the first
+    record, if \a from is 0) to \a map. Returns the end of the last complete
+    record, or 0 if the journal does not apply to this version of the INI
+    file. A torn record at the end, left by a writer that did not finish, is
+    ignored.
+*/
+static qint64 replayIniJournal(QFile &journal, qint64 from, qint64 iniSize, qint64 iniModified,
+                               ParsedSettingsMap *map)
+{
+    if (!journal.open(QIODevice::ReadOnly))
+        return 0;
+    if (journal.read(IniJournalHeaderSize) != iniJournalHeader(iniSize, iniModified))
+        return 0;
+
+    qint64 pos = qMax(from, IniJournalHeaderSize);
+    if (!journal.seek(pos))
+        return 0;
+    const QByteArray records = journal.readAll();
+    qsizetype offset = 0;
+    while (records.size() - offset >= qsizetype(sizeof(quint32))) {
+        const quint32 length = qFromBigEndian<quint32>(records.constData() + offset);
+        if (records.size() - offset - qsizetype(sizeof(quint32)) < qint64(length))
+            break;
+
+        QDataStream stream(QByteArray::fromRawData(records.constData() + offset + sizeof(quint32),
+                                                   length));
+        stream.setVersion(QDataStream::Qt_6_0);
+        quint8 operation;
+        QString key;
+        QByteArray iniValue;
+        stream >> operation >> key;
+        if (operation == IniJournalSet)
+            stream >> iniValue;
+        if (stream.status() != QDataStream::Ok)
+            break;
+
+        if (operation == IniJournalSet) {
+            QString stringValue;
+            QStringList stringListValue;
+            QVariant value = QSettingsPrivate::iniUnescapedStringList(iniValue, stringValue,
+                                                                      stringListValue)
+                    ? QSettingsPrivate::stringListToVariantList(stringListValue)
+                    : QSettingsPrivate::stringToVariant(stringValue);
+            map->insert(QSettingsKey(key, IniCaseSensitivity), std::move(value));
+        } else if (operation == IniJournalRemove) {
+            map->remove(QSettingsKey(key, IniCaseSensitivity));
+        }
+        offset += sizeof(quint32) + length;
+    }
+    return pos + offset;
+}
+
+/*
+    Reads the INI file through its compiled cache: if the cache is up to date,
+    it is mapped and looked up directly. Otherwise the INI file is parsed,
+    the journal replayed on top of it and the cache rewritten for the next
+    reader.
+*/
+bool QConfFileSettingsPrivate::readIniFileCached(QConfFile *confFile, QFile &file,
+                                                 const QFileInfo &fileInfo)
+{
+    const qint64 iniSize = fileInfo.size();
+    const qint64 iniModified = fileInfo.lastModified(QTimeZone::UTC).toMSecsSinceEpoch();
+    QFile journal(iniJournalFileName(confFile->name));
+    const qint64 journalSize = journal.size();
+
+    std::unique_ptr<QSettingsIniCache> cache =
+            QSettingsIniCache::open(iniCacheFileName(confFile->name), iniSize, iniModified);
+    if (cache && cache->journalSize() == journalSize) {
+        confFile->journalSize = journalSize;
+        confFile->journalEnd = cache->journalEnd();
+        confFile->iniCache = std::move(cache);
+        return true;
+    }
+
+    bool ok = true;
+    qint64 replayFrom = 0;
+    if (cache && cache->journalSize() < journalSize) {
+        // only the journal has grown since the cache was written
+        cache->readAll(&confFile->originalKeys);
+        replayFrom = cache->journalEnd();
+    } else {
+        QByteArray data = file.readAll();
+        ok = readIniFile(data, &confFile->unparsedIniSections);
+    }
+    cache.reset();
+
+    const bool writeCache = QFileInfo(fileInfo.absolutePath()).isWritable();
+    if (journalSize > 0 || writeCache)
+        ensureAllSectionsParsed(confFile);
+    qint64 journalEnd = 0;
+    if (journalSize > 0)
+        journalEnd = replayIniJournal(journal, replayFrom, iniSize, iniModified, &confFile->originalKeys);
+    confFile->journalSize = journalSize;
+    confFile->journalEnd = journalEnd;
+
+    if (ok && writeCache) {
+        QSettingsIniCache::write(iniCacheFileName(confFile->name), confFile->originalKeys,
+                                 iniSize, iniModified, journalSize, journalEnd,
+                                 fileInfo.permissions());
+    }
+    return ok;
+}
+
+/*
+    Appends the pending changes of \a confFile to its journal instead of
+    rewriting the INI file. Returns \c false if the file must be rewritten,
+    because there is no INI file yet, the journal has grown too large or
+    cannot be written.
+*/
+bool QConfFileSettingsPrivate::appendToIniJournal(QConfFile *confFile)
+{
+    if (confFile->size == 0)
+        return false;
+
+    QByteArray records;
+    for (auto i = confFile->removedKeys.constBegin(); i != confFile->removedKeys.constEnd(); ++i) {
+        if (!confFile->addedKeys.contains(i.key()))
+            appendIniJournalRecord(records, IniJournalRemove, i.key());
+    }
+    for (auto i = confFile->addedKeys.constBegin(); i != confFile->addedKeys.constEnd(); ++i)
+        appendIniJournalRecord(records, IniJournalSet, i.key(), &i.value());
+
+    qint64 pos = confFile->journalEnd;
+    if (pos == 0)
+        records.prepend(iniJournalHeader(confFile->size, confFile->timeStamp.toMSecsSinceEpoch()));
+    if (pos + records.size() > qMax(confFile->size / 2, IniJournalMinimumLimit))
+        return false;
+
+    QFile journal(iniJournalFileName(confFile->name));
+    const bool created = !journal.exists();
+    if (!journal.open(QIODevice::ReadWrite))
+        return false;
+    if (created)
+        journal.setPermissions(QFileInfo(confFile->name).permissions());
+    // drop whatever follows the last complete record
+    if (!journal.resize(pos) || !journal.seek(pos)
+            || journal.write(records) != records.size() || !journal.flush()) {
+        return false;
+    }
+
+    confFile->journalSize = confFile->journalEnd = pos + records.size();
+    return true;
+}
+#endif // QSETTINGS_USE_INI_CACHE
+
 void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 {
     bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
 
     QFileInfo fileInfo(confFile->name);
+#ifdef QSETTINGS_USE_INI_CACHE
+    QFileInfo journalInfo(iniJournalFileName(confFile->name));
+    auto journalSize = [&] { return useIniCache ? journalInfo.size() : 0; };
+#else
+    auto journalSize = [] { return qint64(0); };
+#endif
     /*
         We can often optimize the read-only case, if the file on disk
         hasn't changed.
     */
     if (readOnly && confFile->size > 0) {
-        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified(QTimeZone::UTC))
+        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified(QTimeZone::UTC)
+                && confFile->journalSize == journalSize()) {
             return;
+        }
     }
 
     if (!readOnly && !confFile->isWritable()) {
@@ -1381,16 +1897,22 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
         since last time we read it.
     */
     fileInfo.refresh();
+#ifdef QSETTINGS_USE_INI_CACHE
+    journalInfo.refresh();
+#endif
     bool mustReadFile = true;
     bool createFile = !fileInfo.exists();
 
     if (!readOnly)
         mustReadFile = (confFile->size != fileInfo.size()
-                        || (confFile->size != 0 && confFile->timeStamp != fileInfo.lastModified(QTimeZone::UTC)));
+                        || (confFile->size != 0 && confFile->timeStamp != fileInfo.lastModified(QTimeZone::UTC))
+                        || confFile->journalSize != journalSize());
 
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
         confFile->originalKeys.clear();
+        confFile->iniCache.reset();
+        confFile->journalSize = confFile->journalEnd = 0;
 
         QFile file(confFile->name);
         if (!createFile && !file.open(QFile::ReadOnly)) {
@@ -1416,6 +1938,11 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
                 QByteArray data = file.readAll();
                 ok = readPlistFile(data, &confFile->originalKeys);
             } else
+#endif
+#ifdef QSETTINGS_USE_INI_CACHE
+            if (useIniCache) {
+                ok = readIniFileCached(confFile, file, fileInfo);
+            } else
 #endif
             if (format <= QSettings::IniFormat) {
                 QByteArray data = file.readAll();
@@ -1451,6 +1978,15 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
         ensureAllSectionsParsed(confFile);
         ParsedSettingsMap mergedKeys = confFile->mergedKeyMap();
 
+#ifdef QSETTINGS_USE_INI_CACHE
+        if (useIniCache && !createFile && appendToIniJournal(confFile)) {
+            confFile->originalKeys = mergedKeys;
+            confFile->addedKeys.clear();
+            confFile->removedKeys.clear();
+            return;
+        }
+#endif
+
 #if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(temporaryfile)
         QSaveFile sf(confFile->name);
         sf.setDirectWriteFallback(!atomicSyncOnly);
@@ -1505,6 +2041,16 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             confFile->size = fileInfo.size();
             confFile->timeStamp = fileInfo.lastModified(QTimeZone::UTC);
 
+#ifdef QSETTINGS_USE_INI_CACHE
+            if (useIniCache) {
+                // The journal has been folded into the file. The cache is
+                // left for the next reader to rebuild: it must contain the
+                // values as read back from the file, not the ones we set.
+                QFile::remove(iniJournalFileName(confFile->name));
+                confFile->journalSize = confFile->journalEnd = 0;
+            }
+#endif
+
             // If we have created the file, apply the file perms
             if (createFile) {
                 QFile::Permissions perms = fileInfo.permissions() | QFile::ReadOwner | QFile::WriteOwner;
@@ -1774,6 +2320,22 @@ Q_DECLARE_TYPEINFO(QSettingsIniSection, Q_RELOCATABLE_TYPE);
 
 typedef QMap<QString, QSettingsIniSection> IniMap;
 
+static void iniEscapedValue(const QVariant &value, QByteArray &result)
+{
+    /*
+        The size() != 1 trick is necessary because
+        QVariant(QString("foo")).toList() returns an empty
+        list, not a list containing "foo".
+    */
+    if (value.metaType().id() == QMetaType::QStringList
+            || (value.metaType().id() == QMetaType::QVariantList && value.toList().size() != 1)) {
+        QSettingsPrivate::iniEscapedStringList(QSettingsPrivate::variantListToStringList(value.toList()),
+                                               result);
+    } else {
+        QSettingsPrivate::iniEscapedString(QSettingsPrivate::variantToString(value), result);
+    }
+}
+
 /*
     This would be more straightforward if we didn't try to remember the original
     key order in the .ini file, but we do.
@@ -1843,19 +2405,7 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
             iniEscapedKey(j.key(), block);
             block += '=';
 
-            const QVariant &value = j.value();
-
-            /*
-                The size() != 1 trick is necessary because
-                QVariant(QString("foo")).toList() returns an empty
-                list, not a list containing "foo".
-            */
-            if (value.metaType().id() == QMetaType::QStringList
-                    || (value.metaType().id() == QMetaType::QVariantList && value.toList().size() != 1)) {
-                iniEscapedStringList(variantListToStringList(value.toList()), block);
-            } else {
-                iniEscapedString(variantToString(value), block);
-            }
+            iniEscapedValue(j.value(), block);
             block += eol;
             if (device.write(block) == -1) {
                 writeError = true;
@@ -1868,6 +2418,11 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
 
 void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) const
 {
+    if (confFile->iniCache) {
+        confFile->iniCache->readAll(&confFile->originalKeys);
+        confFile->iniCache.reset();
+    }
+
     auto i = confFile->unparsedIniSections.constBegin();
     const auto end = confFile->unparsedIniSections.constEnd();
 
@@ -1881,6 +2436,12 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
 void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
                                                    const QSettingsKey &key) const
 {
+    // the cache can only be read as a whole
+    if (confFile->iniCache) {
+        ensureAllSectionsParsed(confFile);
+        return;
+    }
+
     if (confFile->unparsedIniSections.isEmpty())
         return;
 
@@ -2281,6 +2842,21 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
 
     \snippet code/src_corelib_io_qsettings.cpp 3
 
+    \section2 Caching Large INI Files
+
+    If the environment variable \c QT_SETTINGS_INI_CACHE is set to \c 1,
+    QSettings stores a compiled binary copy of every INI file it reads next
+    to it, with the suffix \c .qtcache. As long as the INI file does not
+    change, later instances, also in other processes, map that copy instead
+    of parsing the file, and look keys up in it directly. This is useful for
+    large INI files that many processes read at startup.
+
+    In the same mode, sync() appends the changes to a journal file with the
+    suffix \c .qtjournal instead of rewriting the whole INI file. The journal
+    is folded back into the INI file once it has grown to half the size of
+    the file. Until then, the INI file itself does not contain those changes,
+    so every process that reads it must have the variable set as well.
+
     \section2 Accessing the Windows Registry Directly
 
     On Windows, QSettings lets you access settings that have been
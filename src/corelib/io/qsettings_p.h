@@ -29,6 +29,8 @@
 #include "private/qobject_p.h"
 #endif
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 #ifndef Q_OS_WIN
@@ -111,6 +113,10 @@ inline QString QSettingsGroup::toString() const
     return result;
 }
 
+class QSettingsIniCache;
+class QFile;
+class QFileInfo;
+
 class QConfFile
 {
 public:
@@ -130,6 +136,9 @@ public:
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
+    std::unique_ptr<QSettingsIniCache> iniCache;
+    qint64 journalSize;
+    qint64 journalEnd;
     QAtomicInt ref;
     QMutex mutex;
     bool userPerms;
@@ -250,6 +259,8 @@ private:
     void initFormat();
     virtual void initAccess();
     void syncConfFile(QConfFile *confFile);
+    bool readIniFileCached(QConfFile *confFile, QFile &file, const QFileInfo &fileInfo);
+    bool appendToIniJournal(QConfFile *confFile);
     bool writeIniFile(QIODevice &device, const ParsedSettingsMap &map);
 #ifdef Q_OS_DARWIN
     bool readPlistFile(const QByteArray &data, ParsedSettingsMap *map) const;
@@ -264,6 +275,7 @@ private:
     QString extension;
     Qt::CaseSensitivity caseSensitivity;
     qsizetype nextPosition;
+    bool useIniCache = false;
 #ifdef Q_OS_WASM
     friend class QWasmIDBSettingsPrivate;
 #endif
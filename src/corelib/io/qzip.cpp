@@ -8,14 +8,24 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#if QT_CONFIG(thread)
+#  include <qsemaphore.h>
+#  include <qthreadpool.h>
+#endif
 
 #include <memory>
 
 #include <zlib.h>
 
+#if QT_CONFIG(zstd)
+#  include <zstd.h>
+#endif
+
 // Zip standard version for archives handled by this API
 // (actually, the only basic support of this version is implemented but it is enough for now)
 #define ZIP_VERSION 20
+// Reading also supports the ZIP64 extensions (4.5) and zstd compression (6.3)
+#define ZIP_READ_VERSION 63
 
 #if 0
 #define ZDEBUG qDebug
@@ -89,39 +99,9 @@ static void writeMSDosDate(uchar *dest, const QDateTime& dt)
     }
 }
 
-static int inflate(Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen)
+static inline quint64 readULongLong(const uchar *data)
 {
-    z_stream stream;
-    int err;
-
-    stream.next_in = const_cast<Bytef*>(source);
-    stream.avail_in = (uInt)sourceLen;
-    if ((uLong)stream.avail_in != sourceLen)
-        return Z_BUF_ERROR;
-
-    stream.next_out = dest;
-    stream.avail_out = (uInt)*destLen;
-    if ((uLong)stream.avail_out != *destLen)
-        return Z_BUF_ERROR;
-
-    stream.zalloc = (alloc_func)nullptr;
-    stream.zfree = (free_func)nullptr;
-
-    err = inflateInit2(&stream, -MAX_WBITS);
-    if (err != Z_OK)
-        return err;
-
-    err = inflate(&stream, Z_FINISH);
-    if (err != Z_STREAM_END) {
-        inflateEnd(&stream);
-        if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0))
-            return Z_DATA_ERROR;
-        return err;
-    }
-    *destLen = stream.total_out;
-
-    err = inflateEnd(&stream);
-    return err;
+    return qFromLittleEndian<quint64>(data);
 }
 
 static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen)
@@ -154,6 +134,93 @@ static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sour
 }
 
 
+#if QT_CONFIG(thread)
+// Entries of at least two blocks are compressed block by block on the global
+// thread pool, each block primed with the tail of the preceding one as
+// dictionary. All blocks but the last end with a sync flush, which leaves the
+// output byte aligned, so their concatenation is a single raw deflate stream.
+static constexpr qsizetype ParallelDeflateBlockSize = 1024 * 1024;
+static constexpr qsizetype DeflateDictionarySize = 32 * 1024;
+
+static bool deflateBlock(QByteArray *out, QByteArrayView dictionary, QByteArrayView block, bool last)
+{
+    z_stream stream = {};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+    if (!dictionary.isEmpty()) {
+        deflateSetDictionary(&stream, reinterpret_cast<const Bytef *>(dictionary.data()),
+                             uInt(dictionary.size()));
+    }
+
+    // deflateBound() doesn't account for the empty stored block of the sync flush
+    out->resize(deflateBound(&stream, uLong(block.size())) + 16);
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(block.data()));
+    stream.avail_in = uInt(block.size());
+    stream.next_out = reinterpret_cast<Bytef *>(out->data());
+    stream.avail_out = uInt(out->size());
+
+    const int res = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool ok = last ? res == Z_STREAM_END
+                         : res == Z_OK && stream.avail_in == 0 && stream.avail_out > 0;
+    out->resize(stream.total_out);
+    deflateEnd(&stream);
+    return ok;
+}
+
+// returns a null QByteArray on failure
+static QByteArray deflateParallel(QByteArrayView contents)
+{
+    const qsizetype blockCount =
+            (contents.size() + ParallelDeflateBlockSize - 1) / ParallelDeflateBlockSize;
+
+    struct Job {
+        QList<QByteArray> blocks;
+        QAtomicInteger<qsizetype> next = 0;
+        QAtomicInt failed = 0;
+        QSemaphore done;
+    };
+    // helpers that start late only touch the Job, which they share ownership of
+    const auto job = std::make_shared<Job>();
+    job->blocks.resize(blockCount);
+
+    const auto compressBlocks = [job, contents, blockCount] {
+        qsizetype i;
+        while ((i = job->next.fetchAndAddRelaxed(1)) < blockCount) {
+            const qsizetype start = i * ParallelDeflateBlockSize;
+            const QByteArrayView block = contents.sliced(start)
+                                                 .first(qMin(ParallelDeflateBlockSize,
+                                                             contents.size() - start));
+            const qsizetype dictionaryStart = qMax(start - DeflateDictionarySize, qsizetype(0));
+            const QByteArrayView dictionary =
+                    contents.sliced(dictionaryStart, start - dictionaryStart);
+            if (!deflateBlock(&job->blocks[i], dictionary, block, i == blockCount - 1))
+                job->failed.storeRelaxed(1);
+            job->done.release();
+        }
+    };
+
+    // the calling thread compresses too, so this completes even if the pool is busy
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype helpers = qMin(blockCount - 1, qsizetype(pool->maxThreadCount()));
+    for (qsizetype i = 0; i < helpers; ++i)
+        pool->start(compressBlocks);
+    compressBlocks();
+    job->done.acquire(int(blockCount));
+
+    if (job->failed.loadRelaxed())
+        return QByteArray();
+
+    qsizetype size = 0;
+    for (const QByteArray &block : std::as_const(job->blocks))
+        size += block.size();
+    QByteArray data;
+    data.reserve(size);
+    for (const QByteArray &block : std::as_const(job->blocks))
+        data += block;
+    return data;
+}
+#endif // QT_CONFIG(thread)
+
 namespace WindowsFileAttributes {
 enum {
     Dir        = 0x10, // FILE_ATTRIBUTE_DIRECTORY
@@ -306,6 +373,8 @@ enum CompressionMethod {
     CompressionMethodTerse = 18,
     CompressionMethodLz77 = 19,
 
+    CompressionMethodZstd = 93,
+
     CompressionMethodJpeg = 96,
     CompressionMethodWavPack = 97,
     CompressionMethodPPMd = 98,
@@ -370,15 +439,81 @@ struct EndOfDirectory
 };
 Q_DECLARE_TYPEINFO(EndOfDirectory, Q_PRIMITIVE_TYPE);
 
+struct EndOfDirectory64Locator
+{
+    uchar signature[4]; // 0x07064b50
+    uchar start_of_directory_disk[4];
+    uchar end_of_directory_offset[8];
+    uchar num_disks[4];
+};
+Q_DECLARE_TYPEINFO(EndOfDirectory64Locator, Q_PRIMITIVE_TYPE);
+
+struct EndOfDirectory64
+{
+    uchar signature[4]; // 0x06064b50
+    uchar record_size[8];
+    uchar version_made[2];
+    uchar version_needed[2];
+    uchar this_disk[4];
+    uchar start_of_directory_disk[4];
+    uchar num_dir_entries_this_disk[8];
+    uchar num_dir_entries[8];
+    uchar directory_size[8];
+    uchar dir_start_offset[8];
+};
+Q_DECLARE_TYPEINFO(EndOfDirectory64, Q_PRIMITIVE_TYPE);
+
 struct FileHeader
 {
     CentralFileHeader h;
     QByteArray file_name;
     QByteArray extra_field;
     QByteArray file_comment;
+
+    // from h, or from the ZIP64 extended information in extra_field
+    qint64 compressedSize = 0;
+    qint64 uncompressedSize = 0;
+    qint64 localHeaderOffset = 0;
+
+    void readSizes();
 };
 Q_DECLARE_TYPEINFO(FileHeader, Q_RELOCATABLE_TYPE);
 
+void FileHeader::readSizes()
+{
+    quint64 sizes[3] = { readUInt(h.uncompressed_size), readUInt(h.compressed_size),
+                         readUInt(h.offset_local_header) };
+
+    // The ZIP64 extended information only contains the fields that don't fit
+    // into the header, in this order.
+    const uchar *extra = reinterpret_cast<const uchar *>(extra_field.constData());
+    const uchar *const end = extra + extra_field.size();
+    while (end - extra >= 4) {
+        const ushort tag = readUShort(extra);
+        const ushort size = readUShort(extra + 2);
+        extra += 4;
+        if (size > end - extra)
+            break;
+        if (tag == 0x0001) {
+            const uchar *field = extra;
+            for (quint64 &value : sizes) {
+                if (value != 0xffffffffu)
+                    continue;
+                if (field + 8 > extra + size)
+                    break;
+                value = readULongLong(field);
+                field += 8;
+            }
+            break;
+        }
+        extra += size;
+    }
+
+    uncompressedSize = qint64(qMin(sizes[0], quint64(std::numeric_limits<qint64>::max())));
+    compressedSize = qint64(qMin(sizes[1], quint64(std::numeric_limits<qint64>::max())));
+    localHeaderOffset = qint64(qMin(sizes[2], quint64(std::numeric_limits<qint64>::max())));
+}
+
 class QZipPrivate
 {
 public:
@@ -455,7 +590,7 @@ QZipReader::FileInfo QZipPrivate::fillFileInfo(int index) const
     const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
     fileInfo.filePath = inUtf8 ? QString::fromUtf8(header.file_name) : QString::fromLocal8Bit(header.file_name);
     fileInfo.crc = readUInt(header.h.crc_32);
-    fileInfo.size = readUInt(header.h.uncompressed_size);
+    fileInfo.size = header.uncompressedSize;
     fileInfo.lastModified = readMSDosDate(header.h.last_mod_file);
 
     // fix the file path, if broken (convert separators, eat leading and trailing ones)
@@ -479,6 +614,8 @@ public:
     }
 
     void scanFiles();
+    const FileHeader *findEntry(const QString &fileName) const;
+    std::unique_ptr<QIODevice> openEntry(const FileHeader &header) const;
 
     QZipReader::Status status;
 };
@@ -544,17 +681,18 @@ void QZipReaderPrivate::scanFiles()
 
     // find EndOfDirectory header
     int i = 0;
-    int start_of_directory = -1;
-    int num_dir_entries = 0;
+    qint64 start_of_directory = -1;
+    qint64 num_dir_entries = 0;
+    qint64 eod_pos = 0;
     EndOfDirectory eod;
     while (start_of_directory == -1) {
-        const int pos = device->size() - int(sizeof(EndOfDirectory)) - i;
-        if (pos < 0 || i > 65535) {
+        eod_pos = device->size() - qint64(sizeof(EndOfDirectory)) - i;
+        if (eod_pos < 0 || i > 65535) {
             qWarning("QZip: EndOfDirectory not found");
             return;
         }
 
-        device->seek(pos);
+        device->seek(eod_pos);
         device->read((char *)&eod, sizeof(EndOfDirectory));
         if (readUInt(eod.signature) == 0x06054b50)
             break;
@@ -564,15 +702,35 @@ void QZipReaderPrivate::scanFiles()
     // have the eod
     start_of_directory = readUInt(eod.dir_start_offset);
     num_dir_entries = readUShort(eod.num_dir_entries);
-    ZDEBUG("start_of_directory at %d, num_dir_entries=%d", start_of_directory, num_dir_entries);
+    ZDEBUG("start_of_directory at %lld, num_dir_entries=%lld", start_of_directory, num_dir_entries);
     int comment_length = readUShort(eod.comment_length);
     if (comment_length != i)
         qWarning("QZip: failed to parse zip file.");
     comment = device->read(qMin(comment_length, i));
 
+    // archives that don't fit the 32 bit fields have a ZIP64 EndOfDirectory
+    // record, whose locator immediately precedes the EndOfDirectory header
+    EndOfDirectory64Locator locator;
+    const qint64 locator_pos = eod_pos - qint64(sizeof(EndOfDirectory64Locator));
+    if (locator_pos >= 0 && device->seek(locator_pos)
+        && device->read((char *)&locator, sizeof(locator)) == qint64(sizeof(locator))
+        && readUInt(locator.signature) == 0x07064b50) {
+        EndOfDirectory64 eod64;
+        const qint64 eod64_pos = qint64(readULongLong(locator.end_of_directory_offset));
+        if (eod64_pos >= 0 && device->seek(eod64_pos)
+            && device->read((char *)&eod64, sizeof(eod64)) == qint64(sizeof(eod64))
+            && readUInt(eod64.signature) == 0x06064b50) {
+            start_of_directory = qint64(readULongLong(eod64.dir_start_offset));
+            num_dir_entries = qint64(readULongLong(eod64.num_dir_entries));
+            ZDEBUG("ZIP64: start_of_directory at %lld, num_dir_entries=%lld",
+                   start_of_directory, num_dir_entries);
+        } else {
+            qWarning("QZip: ZIP64 EndOfDirectory record not found");
+        }
+    }
 
     device->seek(start_of_directory);
-    for (i = 0; i < num_dir_entries; ++i) {
+    for (qint64 entry = 0; entry < num_dir_entries; ++entry) {
         FileHeader header;
         int read = device->read((char *) &header.h, sizeof(CentralFileHeader));
         if (read < (int)sizeof(CentralFileHeader)) {
@@ -603,11 +761,255 @@ void QZipReaderPrivate::scanFiles()
             break;
         }
 
+        header.readSizes();
         ZDEBUG("found file '%s'", header.file_name.data());
         fileHeaders.append(header);
     }
 }
 
+const FileHeader *QZipReaderPrivate::findEntry(const QString &fileName) const
+{
+    for (const FileHeader &header : fileHeaders) {
+        if (QString::fromLocal8Bit(header.file_name) == fileName)
+            return &header;
+    }
+    return nullptr;
+}
+
+namespace {
+/*
+    Reads one entry of a zip archive, decompressing it incrementally. The
+    compressed data is read from the archive in chunks, seeking to the entry's
+    position each time, so the archive device can be shared by several entries
+    (on one thread).
+*/
+class QZipEntryDevice : public QIODevice
+{
+public:
+    QZipEntryDevice(QIODevice *archive, qint64 dataStart, const FileHeader &header, int method);
+    ~QZipEntryDevice() override;
+
+    bool isValid() const { return streamReady; }
+
+    bool isSequential() const override { return method != CompressionMethodStored; }
+    qint64 size() const override { return uncompressedSize; }
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    static constexpr qint64 InputChunkSize = 64 * 1024;
+
+    bool fillInput();
+    qint64 readStored(char *data, qint64 maxlen);
+    qint64 readDeflated(char *data, qint64 maxlen);
+#if QT_CONFIG(zstd)
+    qint64 readZstd(char *data, qint64 maxlen);
+#endif
+
+    QIODevice *archive;
+    const qint64 dataStart;
+    const qint64 compressedSize;
+    const qint64 uncompressedSize;
+    const int method;
+    qint64 compressedRead = 0;
+    qint64 uncompressedRead = 0;
+    bool streamReady = false;
+    bool finished = false;
+    bool failed = false;
+    QByteArray input;
+    z_stream zStream = {};
+#if QT_CONFIG(zstd)
+    ZSTD_DStream *zstdStream = nullptr;
+    ZSTD_inBuffer zstdInput = {};
+#endif
+};
+} // unnamed namespace
+
+QZipEntryDevice::QZipEntryDevice(QIODevice *archive, qint64 dataStart, const FileHeader &header,
+                                 int method)
+    : archive(archive), dataStart(dataStart), compressedSize(header.compressedSize),
+      uncompressedSize(header.uncompressedSize), method(method)
+{
+    switch (method) {
+    case CompressionMethodStored:
+        streamReady = true;
+        break;
+    case CompressionMethodDeflated:
+        streamReady = inflateInit2(&zStream, -MAX_WBITS) == Z_OK;
+        break;
+#if QT_CONFIG(zstd)
+    case CompressionMethodZstd:
+        zstdStream = ZSTD_createDStream();
+        streamReady = zstdStream && !ZSTD_isError(ZSTD_initDStream(zstdStream));
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+QZipEntryDevice::~QZipEntryDevice()
+{
+    if (method == CompressionMethodDeflated && streamReady)
+        inflateEnd(&zStream);
+#if QT_CONFIG(zstd)
+    ZSTD_freeDStream(zstdStream);
+#endif
+}
+
+qint64 QZipEntryDevice::bytesAvailable() const
+{
+    if (!isSequential())
+        return QIODevice::bytesAvailable();
+    if (finished)
+        return QIODevice::bytesAvailable();
+    // the uncompressed size is only a hint, report something while not finished
+    return qMax(uncompressedSize - uncompressedRead, qint64(1)) + QIODevice::bytesAvailable();
+}
+
+bool QZipEntryDevice::fillInput()
+{
+    const qint64 remaining = compressedSize - compressedRead;
+    if (remaining <= 0 || !archive->seek(dataStart + compressedRead))
+        return false;
+
+    input.resize(qMin(remaining, InputChunkSize));
+    const qint64 read = archive->read(input.data(), input.size());
+    if (read <= 0)
+        return false;
+    compressedRead += read;
+
+    zStream.next_in = reinterpret_cast<Bytef *>(input.data());
+    zStream.avail_in = uInt(read);
+#if QT_CONFIG(zstd)
+    zstdInput = { input.constData(), size_t(read), 0 };
+#endif
+    return true;
+}
+
+qint64 QZipEntryDevice::readData(char *data, qint64 maxlen)
+{
+    qint64 read = -1;
+    switch (method) {
+    case CompressionMethodStored:
+        return readStored(data, maxlen);
+    case CompressionMethodDeflated:
+        read = readDeflated(data, maxlen);
+        break;
+#if QT_CONFIG(zstd)
+    case CompressionMethodZstd:
+        read = readZstd(data, maxlen);
+        break;
+#endif
+    default:
+        Q_UNREACHABLE_RETURN(-1);
+    }
+    if (read > 0)
+        uncompressedRead += read;
+    return read;
+}
+
+qint64 QZipEntryDevice::readStored(char *data, qint64 maxlen)
+{
+    // opened Unbuffered, so pos() is the position in the entry
+    const qint64 offset = pos();
+    maxlen = qMin(maxlen, compressedSize - offset);
+    if (maxlen <= 0)
+        return 0;
+    if (!archive->seek(dataStart + offset))
+        return -1;
+    return archive->read(data, maxlen);
+}
+
+qint64 QZipEntryDevice::readDeflated(char *data, qint64 maxlen)
+{
+    zStream.next_out = reinterpret_cast<Bytef *>(data);
+    zStream.avail_out = uInt(qMin(maxlen, qint64(std::numeric_limits<uInt>::max())));
+    const uInt requested = zStream.avail_out;
+
+    while (zStream.avail_out > 0 && !finished) {
+        if (zStream.avail_in == 0 && !fillInput()) {
+            qWarning("QZip: Unexpected end of compressed data");
+            finished = failed = true;
+            break;
+        }
+        const int res = ::inflate(&zStream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END) {
+            finished = true;
+        } else if (res == Z_MEM_ERROR) {
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+            finished = failed = true;
+        } else if (res == Z_DATA_ERROR || res == Z_NEED_DICT) {
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            finished = failed = true;
+        }
+    }
+
+    const qint64 written = requested - zStream.avail_out;
+    return written == 0 && failed ? -1 : written;
+}
+
+#if QT_CONFIG(zstd)
+qint64 QZipEntryDevice::readZstd(char *data, qint64 maxlen)
+{
+    ZSTD_outBuffer output = { data, size_t(maxlen), 0 };
+    while (output.pos < output.size && !finished) {
+        if (zstdInput.pos == zstdInput.size && !fillInput()) {
+            qWarning("QZip: Unexpected end of compressed data");
+            finished = failed = true;
+            break;
+        }
+        const size_t res = ZSTD_decompressStream(zstdStream, &output, &zstdInput);
+        if (ZSTD_isError(res)) {
+            qWarning("QZip: Input data is corrupted: %s", ZSTD_getErrorName(res));
+            finished = failed = true;
+        } else if (res == 0 && zstdInput.pos == zstdInput.size
+                   && compressedRead == compressedSize) {
+            finished = true;
+        }
+    }
+
+    const qint64 written = qint64(output.pos);
+    return written == 0 && failed ? -1 : written;
+}
+#endif // QT_CONFIG(zstd)
+
+std::unique_ptr<QIODevice> QZipReaderPrivate::openEntry(const FileHeader &header) const
+{
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_READ_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return nullptr;
+    }
+
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return nullptr;
+    }
+
+    LocalFileHeader lh;
+    if (!device->seek(header.localHeaderOffset)
+        || device->read((char *)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader))) {
+        qWarning("QZip: Failed to read the local file header");
+        return nullptr;
+    }
+    const qint64 dataStart = header.localHeaderOffset + qint64(sizeof(LocalFileHeader))
+            + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+
+    const int compression_method = readUShort(lh.compression_method);
+    auto entry = std::make_unique<QZipEntryDevice>(device, dataStart, header, compression_method);
+    if (!entry->isValid()) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return nullptr;
+    }
+    entry->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    return entry;
+}
+
 void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
 {
 #ifndef NDEBUG
@@ -644,27 +1046,39 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     if (compression == QZipWriter::AlwaysCompress) {
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
 
-       ulong len = contents.size();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.size());
+        bool compressed = false;
+#if QT_CONFIG(thread)
+        if (contents.size() >= 2 * ParallelDeflateBlockSize) {
+            QByteArray blocks = deflateParallel(contents);
+            compressed = !blocks.isNull();
+            if (compressed)
+                data = std::move(blocks);
+        }
+#endif
 
-            switch (res) {
-            case Z_OK:
+        if (!compressed) {
+            ulong len = contents.size();
+            // shamelessly copied form zlib
+            len += (len >> 12) + (len >> 14) + 11;
+            int res;
+            do {
                 data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
+                res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.size());
+
+                switch (res) {
+                case Z_OK:
+                    data.resize(len);
+                    break;
+                case Z_MEM_ERROR:
+                    qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+                    data.resize(0);
+                    break;
+                case Z_BUF_ERROR:
+                    len *= 2;
+                    break;
+                }
+            } while (res == Z_BUF_ERROR);
+        }
     }
 // TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
     writeUInt(header.h.compressed_size, data.size());
@@ -895,91 +1309,50 @@ QZipReader::FileInfo QZipReader::entryInfoAt(int index) const
 
 /*!
     Fetch the file contents from the zip archive and return the uncompressed bytes.
+
+    \sa fileDevice()
 */
 QByteArray QZipReader::fileData(const QString &fileName) const
 {
-    d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromLocal8Bit(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
+    const std::unique_ptr<QIODevice> entry = fileDevice(fileName);
+    if (!entry)
         return QByteArray();
 
-    FileHeader header = d->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+    // the size is taken from the archive, so don't trust it blindly
+    QByteArray data(qMin(entry->size(), qint64(64 * 1024 * 1024)), Qt::Uninitialized);
+    const qint64 read = entry->read(data.data(), data.size());
+    if (read < 0)
         return QByteArray();
-    }
-
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
+    data.truncate(read);
+    if (!entry->atEnd())
+        data += entry->readAll();
+    return data;
+}
 
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
-        return QByteArray();
-    }
+/*!
+    Returns a read-only device that provides the uncompressed contents of the
+    file \a fileName in the zip archive, or \nullptr if there is no such file
+    or its contents cannot be extracted.
 
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
-    if (compression_method == CompressionMethodStored) {
-        // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        QByteArray baunzip;
-        ulong len = qMax(uncompressed_size,  1);
-        int res;
-        do {
-            baunzip.resize(len);
-            res = inflate((uchar*)baunzip.data(), &len,
-                          (const uchar*)compressed.constData(), compressed_size);
-
-            switch (res) {
-            case Z_OK:
-                if ((int)len != baunzip.size())
-                    baunzip.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory");
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            case Z_DATA_ERROR:
-                qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-        return baunzip;
-    }
+    Unlike fileData(), the contents are decompressed incrementally as they
+    are read, so large files don't need to fit into memory. The device reads
+    from device() on demand: it must not outlive the QZipReader, and it may
+    only be used from the thread that uses the QZipReader.
 
-    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
-    return QByteArray();
+    \sa fileData()
+*/
+std::unique_ptr<QIODevice> QZipReader::fileDevice(const QString &fileName) const
+{
+    d->scanFiles();
+    const FileHeader *header = d->findEntry(fileName);
+    return header ? d->openEntry(*header) : nullptr;
 }
 
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
-    In case writing or linking a file fails, the extraction will be aborted.
+    In case reading, writing or linking a file fails, the extraction will be
+    aborted and \c false is returned.
 */
 bool QZipReader::extractAll(const QString &destinationDir) const
 {
@@ -1044,9 +1417,21 @@ bool QZipReader::extractAll(const QString &destinationDir) const
             QFile f(absPath);
             if (!f.open(QIODevice::WriteOnly))
                 return false;
-            f.write(fileData(fi.filePath));
+            const std::unique_ptr<QIODevice> entry = fileDevice(fi.filePath);
+            if (!entry)
+                return false;
+            QByteArray buffer(qMin(fi.size, qint64(1024 * 1024)) + 1, Qt::Uninitialized);
+            qint64 read;
+            while ((read = entry->read(buffer.data(), buffer.size())) > 0) {
+                if (f.write(buffer.constData(), read) != read)
+                    return false;
+            }
+            if (read < 0 || !entry->atEnd())
+                return false;
             f.setPermissions(fi.permissions);
             f.close();
+            if (f.error() != QFileDevice::NoError)
+                return false;
         }
     }
 
@@ -9,7 +9,9 @@
 #include "qabstracteventdispatcher.h"
 #include "qcoreevent.h"
 #include "qcoreevent_p.h"
+#include "qelapsedtimer.h"
 #include "qeventloop.h"
+#include "qeventloopprofiler_p.h"
 #endif
 #include "qmetaobject.h"
 #include <private/qproperty_p.h>
@@ -897,6 +899,9 @@ void Q_TRACE_INSTRUMENT(qtcore) QCoreApplicationPrivate::init()
     qt_startup_hook();
 #ifndef QT_BOOTSTRAPPED
     QtPrivate::initBindingStatusThreadId();
+#ifndef QT_NO_QOBJECT
+    QEventLoopProfiler::initialize();
+#endif
     if (Q_UNLIKELY(qtHookData[QHooks::Startup]))
         reinterpret_cast<QHooks::StartupCallback>(qtHookData[QHooks::Startup])();
 #endif
@@ -1118,14 +1123,28 @@ bool QCoreApplication::notifyInternal2(QObject *receiver, QEvent *event)
     }
 
     QScopedScopeLevelCounter scopeLevelCounter(threadData);
-    if (!selfRequired)
-        return doNotify(receiver, event);
+    auto notify = [&] {
+        if (!selfRequired)
+            return doNotify(receiver, event);
 
 #if QT_VERSION >= QT_VERSION_CHECK(7, 0, 0)
-    if (!QThread::isMainThread())
-        return false;
+        if (!QThread::isMainThread())
+            return false;
 #endif
-    return qApp->notify(receiver, event);
+        return qApp->notify(receiver, event);
+    };
+
+    if (Q_UNLIKELY(QEventLoopProfiler::isEnabled())) {
+        // the event may delete the receiver
+        const QMetaObject *receiverClass = QEventLoopProfiler::receiverClass(receiver);
+        const QEvent::Type type = event->type();
+        QElapsedTimer timer;
+        timer.start();
+        result = notify();
+        QEventLoopProfiler::recordDispatch(receiverClass, type, timer.nsecsElapsed());
+        return result;
+    }
+    return notify();
 }
 
 /*!
@@ -1681,6 +1700,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     event->m_posted = true;
     ++receiver->d_func()->postedEvents;
     data->canWait = false;
+    if (Q_UNLIKELY(QEventLoopProfiler::isEnabled()))
+        QEventLoopProfiler::recordPostedEventQueueDepth(data->postEventList.size()
+                                                        - data->postEventList.startOffset);
     locker.unlock();
 
     QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
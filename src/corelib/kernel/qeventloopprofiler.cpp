@@ -0,0 +1,371 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qeventloopprofiler_p.h"
+
+#include <qalgorithms.h>
+#include <qcoreapplication.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qmetaobject.h>
+#include <qmutex.h>
+
+#include <private/qmetaobject_p.h>
+
+#include <algorithm>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+    \internal
+    Returns the index of the bucket that counts \a value.
+
+    The values below SubBucketCount have a bucket each. Above, the buckets of
+    each power of two are SubBucketCount values of its most significant bits
+    apart, so the relative error stays below 1 / SubBucketCount.
+*/
+int QEventLoopHistogram::bucketIndex(quint64 value) noexcept
+{
+    if (value < SubBucketCount)
+        return int(value);
+    const int shift = 63 - qCountLeadingZeroBits(value) - SubBucketBits;
+    const int subBucket = int(value >> shift) & (SubBucketCount - 1);
+    return (shift + 1) * SubBucketCount + subBucket;
+}
+
+/*!
+    \internal
+    Returns the largest value counted by the bucket at \a index.
+*/
+quint64 QEventLoopHistogram::bucketUpperBound(int index) noexcept
+{
+    if (index < SubBucketCount)
+        return quint64(index);
+    const int shift = index / SubBucketCount - 1;
+    const quint64 subBucket = quint64(index % SubBucketCount);
+    return ((quint64(SubBucketCount) + subBucket + 1) << shift) - 1;
+}
+
+void QEventLoopHistogram::record(quint64 value) noexcept
+{
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(value, std::memory_order_relaxed);
+    quint64 previous = max.load(std::memory_order_relaxed);
+    while (previous < value
+           && !max.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+    }
+}
+
+void QEventLoopHistogram::reset() noexcept
+{
+    for (auto &bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+/*!
+    \internal
+    Returns the statistics of the recorded values. The percentiles are the
+    upper bounds of the buckets they fall in.
+*/
+QEventLoopHistogram::Summary QEventLoopHistogram::summary() const noexcept
+{
+    // the values may be recorded while summing them up
+    quint64 counts[BucketCount];
+    quint64 sum = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        sum += counts[i];
+    }
+
+    Summary result;
+    result.count = sum;
+    result.total = total.load(std::memory_order_relaxed);
+    result.max = max.load(std::memory_order_relaxed);
+    if (!sum)
+        return result;
+
+    auto percentile = [&](quint64 permille) {
+        const quint64 rank = (sum * permille + 999) / 1000;
+        quint64 seen = 0;
+        for (int i = 0; i < BucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank)
+                return qMin(bucketUpperBound(i), result.max);
+        }
+        return result.max;
+    };
+    result.p50 = percentile(500);
+    result.p90 = percentile(900);
+    result.p99 = percentile(990);
+    return result;
+}
+
+namespace {
+struct Histograms
+{
+    QMutex mutex;
+    // never removed, so that the threads can keep pointers to them
+    QHash<int, std::shared_ptr<QEventLoopHistogram>> byEventType;
+    // by class name, as the meta-objects of plugins may be gone by the report
+    QHash<QByteArray, std::shared_ptr<QEventLoopHistogram>> byReceiverClass;
+    QEventLoopHistogram postedEventQueueDepth;
+    QEventLoopHistogram timerLateness;
+};
+Q_GLOBAL_STATIC(Histograms, histograms)
+
+int histogramKey(int type)
+{
+    return type;
+}
+
+QByteArray histogramKey(const QMetaObject *receiverClass)
+{
+    return QByteArray(receiverClass->className());
+}
+
+// Looks up the histogram of key, first in the cache of the current thread
+template <typename MapKey, typename Key>
+QEventLoopHistogram *histogram(QHash<MapKey, std::shared_ptr<QEventLoopHistogram>> Histograms::*map,
+                               Key key)
+{
+    // the cached histograms are destroyed with the others
+    Histograms *h = histograms();
+    if (!h)
+        return nullptr;
+
+    static thread_local QHash<Key, QEventLoopHistogram *> cache;
+    if (QEventLoopHistogram *cached = cache.value(key))
+        return cached;
+
+    QMutexLocker locker(&h->mutex);
+    auto &result = (h->*map)[histogramKey(key)];
+    if (!result)
+        result = std::make_shared<QEventLoopHistogram>();
+    cache.insert(key, result.get());
+    return result.get();
+}
+
+template <typename MapKey, typename Key>
+QEventLoopHistogram::Summary summary(QHash<MapKey, std::shared_ptr<QEventLoopHistogram>> Histograms::*map,
+                                     Key key)
+{
+    Histograms *h = histograms();
+    if (!h)
+        return {};
+    QMutexLocker locker(&h->mutex);
+    const auto result = (h->*map).value(histogramKey(key));
+    return result ? result->summary() : QEventLoopHistogram::Summary();
+}
+
+QJsonObject toJson(const QEventLoopHistogram::Summary &summary)
+{
+    return QJsonObject{
+        { "count"_L1, qint64(summary.count) },
+        { "total"_L1, qint64(summary.total) },
+        { "max"_L1, qint64(summary.max) },
+        { "p50"_L1, qint64(summary.p50) },
+        { "p90"_L1, qint64(summary.p90) },
+        { "p99"_L1, qint64(summary.p99) },
+    };
+}
+
+void writeReport()
+{
+    const QString fileName = qEnvironmentVariable("QT_EVENTLOOP_PROFILE");
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("QEventLoopProfiler: cannot write the report to %ls: %ls",
+                 qUtf16Printable(fileName), qUtf16Printable(file.errorString()));
+        return;
+    }
+    file.write(QJsonDocument(QEventLoopProfiler::report()).toJson());
+}
+} // unnamed namespace
+
+Q_CONSTINIT QBasicAtomicInt QEventLoopProfiler::enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*!
+    \class QEventLoopProfiler
+    \inmodule QtCore
+    \internal
+
+    Records how long the events take to be dispatched, by event type and by
+    class of the receiver, how many events are waiting in the posted event
+    queue of a thread when one is posted, and how late the timers fire.
+
+    Setting the \c QT_EVENTLOOP_PROFILE environment variable to the path of a
+    file enables it, and writes report() to that file as JSON when the
+    application exits. The durations are in nanoseconds.
+
+    When disabled, the event loop only checks isEnabled().
+*/
+
+/*!
+    \internal
+    Enables the profiler if requested by the environment. Called when the
+    QCoreApplication is created.
+*/
+void QEventLoopProfiler::initialize()
+{
+    if (!qEnvironmentVariableIsEmpty("QT_EVENTLOOP_PROFILE")) {
+        setEnabled(true);
+        qAddPostRoutine(writeReport);
+    }
+}
+
+void QEventLoopProfiler::setEnabled(bool enable)
+{
+    enabled.storeRelaxed(enable);
+}
+
+/*!
+    \internal
+    Clears the recorded values.
+*/
+void QEventLoopProfiler::reset()
+{
+    Histograms *h = histograms();
+    if (!h)
+        return;
+    QMutexLocker locker(&h->mutex);
+    for (const auto &histogram : std::as_const(h->byEventType))
+        histogram->reset();
+    for (const auto &histogram : std::as_const(h->byReceiverClass))
+        histogram->reset();
+    h->postedEventQueueDepth.reset();
+    h->timerLateness.reset();
+}
+
+/*!
+    \internal
+    Returns the class \a receiver is recorded as: the class of its
+    meta-object, or of the first one it derives from that is neither dynamic
+    nor allocated, like those of QML, as those may be destroyed before the
+    next event is dispatched. Must be called before the event is dispatched,
+    as it may delete the receiver.
+*/
+const QMetaObject *QEventLoopProfiler::receiverClass(const QObject *receiver) noexcept
+{
+    const QMetaObject *metaObject = receiver->metaObject();
+    while (metaObject->superClass()) {
+        const int flags = QMetaObjectPrivate::get(metaObject)->flags;
+        if (!(flags & DynamicMetaObject) && !(flags & AllocatedMetaObject))
+            break;
+        metaObject = metaObject->superClass();
+    }
+    return metaObject;
+}
+
+/*!
+    \internal
+    Records that dispatching an event of \a type to a receiver of
+    \a receiverClass, as returned by receiverClass(), took \a nsecs.
+*/
+void QEventLoopProfiler::recordDispatch(const QMetaObject *receiverClass, QEvent::Type type,
+                                        qint64 nsecs)
+{
+    const quint64 value = quint64(qMax(nsecs, 0));
+    if (QEventLoopHistogram *histogram = ::histogram(&Histograms::byEventType, int(type)))
+        histogram->record(value);
+    if (QEventLoopHistogram *histogram = ::histogram(&Histograms::byReceiverClass, receiverClass))
+        histogram->record(value);
+}
+
+void QEventLoopProfiler::recordPostedEventQueueDepth(qsizetype depth)
+{
+    if (Histograms *h = histograms())
+        h->postedEventQueueDepth.record(quint64(qMax(depth, 0)));
+}
+
+void QEventLoopProfiler::recordTimerLateness(qint64 nsecs)
+{
+    if (Histograms *h = histograms())
+        h->timerLateness.record(quint64(qMax(nsecs, 0)));
+}
+
+QEventLoopHistogram::Summary QEventLoopProfiler::dispatchTime(QEvent::Type type)
+{
+    return summary(&Histograms::byEventType, int(type));
+}
+
+QEventLoopHistogram::Summary QEventLoopProfiler::dispatchTime(const QMetaObject *receiverClass)
+{
+    return summary(&Histograms::byReceiverClass, receiverClass);
+}
+
+QEventLoopHistogram::Summary QEventLoopProfiler::postedEventQueueDepth()
+{
+    Histograms *h = histograms();
+    return h ? h->postedEventQueueDepth.summary() : QEventLoopHistogram::Summary();
+}
+
+QEventLoopHistogram::Summary QEventLoopProfiler::timerLateness()
+{
+    Histograms *h = histograms();
+    return h ? h->timerLateness.summary() : QEventLoopHistogram::Summary();
+}
+
+/*!
+    \internal
+    Returns the recorded values, sorted by total dispatch time.
+*/
+QJsonObject QEventLoopProfiler::report()
+{
+    Histograms *h = histograms();
+    if (!h)
+        return {};
+
+    auto sortedByTotal = [](QList<QJsonObject> entries) {
+        std::sort(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.value("total"_L1).toInteger() > rhs.value("total"_L1).toInteger();
+        });
+        QJsonArray result;
+        for (const QJsonObject &entry : std::as_const(entries))
+            result.append(entry);
+        return result;
+    };
+
+    const QMetaEnum eventTypes = QMetaEnum::fromType<QEvent::Type>();
+    QList<QJsonObject> byEventType;
+    QList<QJsonObject> byReceiverClass;
+    {
+        QMutexLocker locker(&h->mutex);
+        for (auto it = h->byEventType.cbegin(); it != h->byEventType.cend(); ++it) {
+            const QEventLoopHistogram::Summary summary = it.value()->summary();
+            if (!summary.count)
+                continue;   // since reset()
+            QJsonObject entry = toJson(summary);
+            entry.insert("type"_L1, it.key());
+            if (const char *name = eventTypes.valueToKey(it.key()))
+                entry.insert("name"_L1, QLatin1StringView(name));
+            byEventType.append(entry);
+        }
+        for (auto it = h->byReceiverClass.cbegin(); it != h->byReceiverClass.cend(); ++it) {
+            const QEventLoopHistogram::Summary summary = it.value()->summary();
+            if (!summary.count)
+                continue;
+            QJsonObject entry = toJson(summary);
+            entry.insert("class"_L1, QLatin1StringView(it.key()));
+            byReceiverClass.append(entry);
+        }
+    }
+
+    return QJsonObject{
+        { "dispatchTimeByEventType"_L1, sortedByTotal(std::move(byEventType)) },
+        { "dispatchTimeByReceiverClass"_L1, sortedByTotal(std::move(byReceiverClass)) },
+        { "postedEventQueueDepth"_L1, toJson(h->postedEventQueueDepth.summary()) },
+        { "timerLateness"_L1, toJson(h->timerLateness.summary()) },
+    };
+}
+
+QT_END_NAMESPACE
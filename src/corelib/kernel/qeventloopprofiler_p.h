@@ -0,0 +1,92 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QEVENTLOOPPROFILER_P_H
+#define QEVENTLOOPPROFILER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qcoreevent.h>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonObject;
+class QObject;
+struct QMetaObject;
+
+// A histogram of non-negative values with a bounded relative error, like the
+// HDR histograms: each power of two is split into SubBucketCount buckets.
+class Q_CORE_EXPORT QEventLoopHistogram
+{
+public:
+    static constexpr int SubBucketBits = 3;
+    static constexpr int SubBucketCount = 1 << SubBucketBits;
+    static constexpr int BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+    struct Summary
+    {
+        quint64 count = 0;
+        quint64 total = 0;
+        quint64 max = 0;
+        quint64 p50 = 0;
+        quint64 p90 = 0;
+        quint64 p99 = 0;
+    };
+
+    void record(quint64 value) noexcept;
+    void reset() noexcept;
+    Summary summary() const noexcept;
+
+    static int bucketIndex(quint64 value) noexcept;
+    static quint64 bucketUpperBound(int index) noexcept;
+
+private:
+    std::atomic<quint64> buckets[BucketCount] = {};
+    std::atomic<quint64> count = 0;
+    std::atomic<quint64> total = 0;
+    std::atomic<quint64> max = 0;
+};
+
+// Records where the time of the event loop goes, when enabled by setting
+// QT_EVENTLOOP_PROFILE or calling setEnabled(). The dispatch times include
+// the nested event loops run by the receivers.
+class Q_CORE_EXPORT QEventLoopProfiler
+{
+public:
+    static void initialize();
+    static bool isEnabled() noexcept { return enabled.loadRelaxed(); }
+    static void setEnabled(bool enable);
+    static void reset();
+
+    static const QMetaObject *receiverClass(const QObject *receiver) noexcept;
+    static void recordDispatch(const QMetaObject *receiverClass, QEvent::Type type,
+                               qint64 nsecs);
+    static void recordPostedEventQueueDepth(qsizetype depth);
+    static void recordTimerLateness(qint64 nsecs);
+
+    static QEventLoopHistogram::Summary dispatchTime(QEvent::Type type);
+    static QEventLoopHistogram::Summary dispatchTime(const QMetaObject *receiverClass);
+    static QEventLoopHistogram::Summary postedEventQueueDepth();
+    static QEventLoopHistogram::Summary timerLateness();
+    static QJsonObject report();
+
+private:
+    Q_CONSTINIT static QBasicAtomicInt enabled;
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTLOOPPROFILER_P_H
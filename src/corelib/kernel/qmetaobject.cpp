@@ -22,6 +22,8 @@
 
 // for normalizeTypeInternal
 #include "private/qmetaobject_moc_p.h"
+// for the hash of the lookup tables
+#include <QtCore/qtmochelpers.h>
 
 #include <ctype.h>
 #include <memory>
@@ -676,13 +678,66 @@ bool QMetaObjectPrivate::methodMatch(const QMetaObject *m, const QMetaMethod &me
     return true;
 }
 
+QMetaObjectPrivate::LookupTable QMetaObjectPrivate::methodLookupTable(const QMetaObject *m)
+{
+    const QMetaObjectPrivate *d = priv(m->d.data);
+    if (d->revision < 14 || !d->lookupData)
+        return {};
+    const uint *data = m->d.data + d->lookupData;
+    const uint size = data[0];
+    return { size ? data + 2 : nullptr, size - 1 };
+}
+
+QMetaObjectPrivate::LookupTable QMetaObjectPrivate::propertyLookupTable(const QMetaObject *m)
+{
+    const QMetaObjectPrivate *d = priv(m->d.data);
+    if (d->revision < 14 || !d->lookupData)
+        return {};
+    const uint *data = m->d.data + d->lookupData;
+    const uint size = data[1];
+    return { size ? data + 2 + data[0] : nullptr, size - 1 };
+}
+
+namespace {
+// Computes the hash of a name for the lookup tables when the first one is found
+struct LookupHash
+{
+    QByteArrayView name;
+    uint hash = 0;
+    bool computed = false;
+
+    uint operator()()
+    {
+        if (!computed) {
+            hash = QtMocHelpers::lookupHash(name.data(), size_t(name.size()));
+            computed = true;
+        }
+        return hash;
+    }
+};
+} // unnamed namespace
+
 /*!
    \internal
    Returns the first method with name \a name found in \a baseObject
  */
 QMetaMethod QMetaObjectPrivate::firstMethod(const QMetaObject *baseObject, QByteArrayView name)
 {
+    LookupHash hash{name};
     for (const QMetaObject *currentObject = baseObject; currentObject; currentObject = currentObject->superClass()) {
+        if (const LookupTable table = methodLookupTable(currentObject); table.entries) {
+            // the method with the highest index, as below
+            int found = -1;
+            for (uint e = hash() & table.mask; table.entries[e]; e = (e + 1) & table.mask) {
+                const int i = int(table.entries[e]) - 1;
+                if (i > found && name == QMetaMethod::fromRelativeMethodIndex(currentObject, i).name())
+                    found = i;
+            }
+            if (found != -1)
+                return QMetaMethod::fromRelativeMethodIndex(currentObject, found);
+            continue;
+        }
+
         const int start = priv(currentObject->d.data)->methodCount - 1;
         const int end = 0;
         for (int i = start; i >= end; --i) {
@@ -705,6 +760,7 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
                                         const QByteArray &name, int argc,
                                         const QArgumentType *types)
 {
+    LookupHash hash{name};
     for (const QMetaObject *m = *baseObject; m; m = m->d.superdata) {
         Q_ASSERT(priv(m->d.data)->revision >= 7);
         int i = (MethodType == MethodSignal)
@@ -712,6 +768,25 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
         const int end = (MethodType == MethodSlot)
                         ? (priv(m->d.data)->signalCount) : 0;
 
+        if (const LookupTable table = methodLookupTable(m); table.entries) {
+            // only check the methods with that name, keeping the one with the
+            // highest index like the linear search does
+            int found = -1;
+            for (uint e = hash() & table.mask; table.entries[e]; e = (e + 1) & table.mask) {
+                const int candidate = int(table.entries[e]) - 1;
+                if (candidate <= i && candidate >= end && candidate > found
+                        && methodMatch(m, QMetaMethod::fromRelativeMethodIndex(m, candidate),
+                                       name, argc, types)) {
+                    found = candidate;
+                }
+            }
+            if (found != -1) {
+                *baseObject = m;
+                return found;
+            }
+            continue;
+        }
+
         for (; i >= end; --i) {
             auto data = QMetaMethod::fromRelativeMethodIndex(m, i);
             if (methodMatch(m, data, name, argc, types)) {
@@ -1115,8 +1190,23 @@ int QMetaObjectPrivate::indexOfEnumerator(const QMetaObject *m, QByteArrayView n
 int QMetaObject::indexOfProperty(const char *name) const
 {
     const QMetaObject *m = this;
+    LookupHash hash{QByteArrayView(name)};
     while (m) {
         const QMetaObjectPrivate *d = priv(m->d.data);
+        if (const auto table = QMetaObjectPrivate::propertyLookupTable(m); table.entries) {
+            // the property with the lowest index, like the linear search
+            int found = -1;
+            for (uint e = hash() & table.mask; table.entries[e]; e = (e + 1) & table.mask) {
+                const int i = int(table.entries[e]) - 1;
+                const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, i);
+                if ((found == -1 || i < found) && hash.name == stringDataView(m, data.name()))
+                    found = i;
+            }
+            if (found != -1)
+                return found + m->propertyOffset();
+            m = m->d.superdata;
+            continue;
+        }
         for (int i = 0; i < d->propertyCount; ++i) {
             const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, i);
             const char *prop = rawStringData(m, data.name());
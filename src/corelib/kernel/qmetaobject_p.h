@@ -124,10 +124,21 @@ struct QMetaObjectPrivate
     int constructorCount, constructorData;
     int flags;
     int signalCount;
+    int lookupData;     // since revision 14, 0 if there are no lookup tables
 
     static inline const QMetaObjectPrivate *get(const QMetaObject *metaobject)
     { return reinterpret_cast<const QMetaObjectPrivate*>(metaobject->d.data); }
 
+    // An open addressing hash table of the relative indices of the methods or
+    // properties of a class by name, see QtMocHelpers::metaObjectData().
+    struct LookupTable
+    {
+        const uint *entries = nullptr;  // index + 1, or 0 for an empty entry
+        uint mask = 0;
+    };
+    static LookupTable methodLookupTable(const QMetaObject *m);
+    static LookupTable propertyLookupTable(const QMetaObject *m);
+
     static int originalClone(const QMetaObject *obj, int local_method_index);
 
     static QByteArray decodeMethodSignature(const char *signature,
@@ -8,7 +8,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
-#include "qreadwritelock.h"
+#include "qmutex.h"
 #include "qhash.h"
 #include "qmap.h"
 #include "qstring.h"
@@ -56,8 +56,11 @@
 # include "qline.h"
 #endif
 
+#include <atomic>
+#include <memory>
 #include <new>
 #include <cstring>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -81,6 +84,173 @@ struct QMetaTypeDeleter
     }
 };
 
+// An open addressing hash table of pointers that can be searched without
+// locking, for the lookups in the registries. The writers must hold the lock of
+// the registry. The readers may still look at a removed node, or at a table
+// replaced when growing, so they are only freed with the hash. Instead, a
+// removed node is reused when its key gets inserted again, and so is the
+// removed entry of the table it was in, so that registering and unregistering
+// the same types or converters doesn't take more memory each time.
+template <typename Key, typename T>
+class QMetaTypeConcurrentHash
+{
+    static_assert(std::is_pointer_v<T>);
+
+    struct Node
+    {
+        const Key key;
+        // a reader that found the node before it got reused sees either value
+        std::atomic<T> value;
+    };
+    struct Table
+    {
+        explicit Table(size_t size)
+            : mask(size - 1), entries(new std::atomic<Node *>[size]())
+        {}
+        size_t mask;
+        std::unique_ptr<std::atomic<Node *>[]> entries;
+    };
+
+public:
+    QMetaTypeConcurrentHash() = default;
+    Q_DISABLE_COPY_MOVE(QMetaTypeConcurrentHash)
+
+    // Returns nullptr if there is no value for key
+    template <typename K> T find(const K &key) const noexcept
+    {
+        const Table *table = current.load(std::memory_order_acquire);
+        if (!table)
+            return nullptr;
+        for (size_t i = qHash(key) & table->mask; ; i = (i + 1) & table->mask) {
+            const Node *node = table->entries[i].load(std::memory_order_acquire);
+            if (!node)
+                return nullptr;
+            if (node != removed() && node->key == key)
+                return node->value.load(std::memory_order_acquire);
+        }
+    }
+
+    // Returns false if there already is a value for key
+    bool insert(const Key &key, T value)
+    {
+        Q_ASSERT(value);
+        if (find(key))
+            return false;
+        Node *node = retired.take(key);
+        if (node) {
+            node->value.store(value, std::memory_order_release);
+        } else {
+            nodes.emplace_back(new Node{ key, value });
+            node = nodes.back().get();
+        }
+        Table *table = current.load(std::memory_order_relaxed);
+        if (!table || !insertNode(table, node)) {
+            table = rehash();
+            insertNode(table, node);
+        }
+        ++count;
+        return true;
+    }
+
+    // Returns the value that was removed, if any
+    T remove(const Key &key)
+    {
+        Table *table = current.load(std::memory_order_relaxed);
+        if (!table)
+            return nullptr;
+        for (size_t i = qHash(key) & table->mask; ; i = (i + 1) & table->mask) {
+            Node *node = table->entries[i].load(std::memory_order_relaxed);
+            if (!node)
+                return nullptr;
+            if (node != removed() && node->key == key) {
+                removeAt(table, i);
+                return node->value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename Predicate> void removeIf(Predicate pred)
+    {
+        Table *table = current.load(std::memory_order_relaxed);
+        for (size_t i = 0; table && i <= table->mask; ++i) {
+            Node *node = table->entries[i].load(std::memory_order_relaxed);
+            if (node && node != removed()
+                    && pred(node->key, node->value.load(std::memory_order_relaxed))) {
+                removeAt(table, i);
+            }
+        }
+    }
+
+    template <typename F> void forEach(F f) const
+    {
+        const Table *table = current.load(std::memory_order_relaxed);
+        for (size_t i = 0; table && i <= table->mask; ++i) {
+            const Node *node = table->entries[i].load(std::memory_order_relaxed);
+            if (node && node != removed())
+                f(node->key, node->value.load(std::memory_order_relaxed));
+        }
+    }
+
+private:
+    static Node *removed() noexcept { return reinterpret_cast<Node *>(quintptr(1)); }
+
+    void removeAt(Table *table, size_t i)
+    {
+        Node *node = table->entries[i].load(std::memory_order_relaxed);
+        table->entries[i].store(removed(), std::memory_order_release);
+        retired.insert(node->key, node);
+        --count;
+    }
+
+    // Takes the first removed entry on the way, if any. Returns false if the
+    // table is too full to take an empty one.
+    bool insertNode(Table *table, Node *node)
+    {
+        size_t i = qHash(node->key) & table->mask;
+        for (; ; i = (i + 1) & table->mask) {
+            Node *entry = table->entries[i].load(std::memory_order_relaxed);
+            if (entry == removed())
+                break;
+            if (!entry) {
+                if ((used + 1) * 3 > (table->mask + 1) * 2)
+                    return false;
+                ++used;
+                break;
+            }
+        }
+        table->entries[i].store(node, std::memory_order_release);
+        return true;
+    }
+
+    // Moves the nodes to a new table, without the removed ones, that is at
+    // most two thirds full after the next insertion
+    Table *rehash()
+    {
+        size_t size = 16;
+        while (size * 2 < (count + 1) * 3)
+            size *= 2;
+        auto table = std::make_unique<Table>(size);
+        used = 0;
+        if (const Table *old = current.load(std::memory_order_relaxed)) {
+            for (size_t i = 0; i <= old->mask; ++i) {
+                Node *node = old->entries[i].load(std::memory_order_relaxed);
+                if (node && node != removed())
+                    insertNode(table.get(), node);
+            }
+        }
+        tables.push_back(std::move(table));
+        current.store(tables.back().get(), std::memory_order_release);
+        return tables.back().get();
+    }
+
+    std::atomic<Table *> current = nullptr;
+    std::vector<std::unique_ptr<Table>> tables;
+    std::vector<std::unique_ptr<Node>> nodes;
+    QHash<Key, Node *> retired;     // the removed nodes, by key
+    size_t used = 0;    // entries that aren't empty, including the removed ones
+    size_t count = 0;
+};
+
 struct QMetaTypeCustomRegistry
 {
 
@@ -97,9 +267,11 @@ struct QMetaTypeCustomRegistry
     }
 #endif
 
-    QReadWriteLock lock;
+    // only for the writers, the lookups don't lock
+    QMutex lock;
     QList<const QtPrivate::QMetaTypeInterface *> registry;
-    QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    QMetaTypeConcurrentHash<int, const QtPrivate::QMetaTypeInterface *> registryById;
+    QMetaTypeConcurrentHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
 
@@ -109,7 +281,7 @@ struct QMetaTypeCustomRegistry
         // (not read-only)
         auto ti = const_cast<QtPrivate::QMetaTypeInterface *>(cti);
         {
-            QWriteLocker l(&lock);
+            QMutexLocker l(&lock);
             if (int id = ti->typeId.loadRelaxed())
                 return id;
             QByteArray name =
@@ -117,12 +289,11 @@ struct QMetaTypeCustomRegistry
                     QMetaObject::normalizedType
 #endif
                     (ti->name);
-            if (auto ti2 = aliases.value(name)) {
+            if (auto ti2 = aliases.find(name)) {
                 const auto id = ti2->typeId.loadRelaxed();
                 ti->typeId.storeRelaxed(id);
                 return id;
             }
-            aliases[name] = ti;
             int size = registry.size();
             while (firstEmpty < size && registry[firstEmpty])
                 ++firstEmpty;
@@ -133,7 +304,11 @@ struct QMetaTypeCustomRegistry
                 registry.append(ti);
                 firstEmpty = registry.size();
             }
-            ti->typeId.storeRelaxed(firstEmpty + QMetaType::User);
+            // the lookups don't lock: publish the type by id before setting
+            // its id, and by name once it's set
+            registryById.insert(firstEmpty + QMetaType::User, ti);
+            ti->typeId.storeRelease(firstEmpty + QMetaType::User);
+            aliases.insert(name, ti);
         }
         if (ti->legacyRegisterOp)
             ti->legacyRegisterOp();
@@ -145,12 +320,13 @@ struct QMetaTypeCustomRegistry
         if (!id)
             return;
         Q_ASSERT(id > QMetaType::User);
-        QWriteLocker l(&lock);
+        QMutexLocker l(&lock);
         int idx = id - QMetaType::User - 1;
         auto &ti = registry[idx];
 
         // We must unregister all names.
-        aliases.removeIf([ti] (const auto &kv) { return kv.value() == ti; });
+        aliases.removeIf([ti] (const auto &, const auto &value) { return value == ti; });
+        registryById.remove(id);
 
         ti = nullptr;
 
@@ -159,8 +335,7 @@ struct QMetaTypeCustomRegistry
 
     const QtPrivate::QMetaTypeInterface *getCustomType(int id)
     {
-        QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        return registryById.find(id);
     }
 };
 
@@ -178,25 +353,22 @@ const char *QtMetaTypePrivate::typedefNameForType(const QtPrivate::QMetaTypeInte
     QMetaTypeCustomRegistry *r = &*customTypeRegistry;
 
     QByteArrayView officialName(type_d->name);
-    QReadLocker l(&r->lock);
-    auto it = r->aliases.constBegin();
-    auto end = r->aliases.constEnd();
-    for ( ; it != end; ++it) {
-        if (it.value() != type_d)
-            continue;
-        if (it.key() == officialName)
-            continue;               // skip the official name
-        name = it.key().constData();
-        ++it;
-        break;
-    }
-
+    QMutexLocker l(&r->lock);
 #ifndef QT_NO_DEBUG
     QByteArrayList otherNames;
-    for ( ; it != end; ++it) {
-        if (it.value() == type_d && it.key() != officialName)
-            otherNames << it.key();
-    }
+#endif
+    r->aliases.forEach([&](const QByteArray &alias, const QtPrivate::QMetaTypeInterface *value) {
+        if (value != type_d || alias == officialName)
+            return;                 // skip the official name
+        if (!name)
+            name = alias.constData();
+#ifndef QT_NO_DEBUG
+        else
+            otherNames << alias;
+#endif
+    });
+
+#ifndef QT_NO_DEBUG
     l.unlock();
     if (!otherNames.isEmpty())
         qWarning("QMetaType: type %s has more than one typedef alias: %s, %s",
@@ -1675,39 +1847,40 @@ class QMetaTypeFunctionRegistry
 public:
     ~QMetaTypeFunctionRegistry()
     {
-        const QWriteLocker locker(&lock);
-        map.clear();
+        map.forEach([](const Key &, const T *f) { delete f; });
     }
 
     bool contains(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.contains(k);
+        return map.find(k) != nullptr;
     }
 
     bool insertIfNotContains(Key k, const T &f)
     {
-        const QWriteLocker locker(&lock);
-        auto r = map.tryEmplace(k, f);
-        return r.inserted;
+        auto function = std::make_unique<T>(f);
+        const QMutexLocker locker(&lock);
+        if (!map.insert(k, function.get()))
+            return false;
+        function.release();
+        return true;
     }
 
+    // The function stays valid until it gets removed
     const T *function(Key k) const
     {
-        const QReadLocker locker(&lock);
-        auto it = map.find(k);
-        return it == map.end() ? nullptr : std::addressof(*it);
+        return map.find(k);
     }
 
     void remove(int from, int to)
     {
         const Key k(from, to);
-        const QWriteLocker locker(&lock);
-        map.remove(k);
+        const QMutexLocker locker(&lock);
+        // it may come from a plugin that is about to be unloaded
+        delete map.remove(k);
     }
 private:
-    mutable QReadWriteLock lock;
-    QHash<Key, T> map;
+    QMutex lock;    // for the writers
+    QMetaTypeConcurrentHash<Key, const T *> map;
 };
 
 using QMetaTypeConverterRegistry
@@ -2765,12 +2938,8 @@ static int qMetaTypeCustomType_unlocked(const char *typeName, int length)
 {
     if (customTypeRegistry.exists()) {
         auto reg = &*customTypeRegistry;
-#if QT_CONFIG(thread)
-        Q_ASSERT(!reg->lock.tryLockForWrite());
-#endif
-        if (auto ti = reg->aliases.value(QByteArray::fromRawData(typeName, length), nullptr)) {
+        if (auto ti = reg->aliases.find(QByteArrayView(typeName, length)))
             return ti->typeId.loadRelaxed();
-        }
     }
     return QMetaType::UnknownType;
 }
@@ -2788,11 +2957,8 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
     if (!metaType.isValid())
         return;
     if (auto reg = customTypeRegistry()) {
-        QWriteLocker lock(&reg->lock);
-        auto &al = reg->aliases[normalizedTypeName];
-        if (al)
-            return;
-        al = metaType.d_ptr;
+        QMutexLocker lock(&reg->lock);
+        reg->aliases.insert(normalizedTypeName, metaType.d_ptr);
     }
 }
 
@@ -2834,7 +3000,6 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
         type = qMetaTypeCustomType_unlocked(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
@@ -1047,6 +1047,7 @@ QObject::~QObject()
 
     QObjectPrivate::ConnectionData *cd = d->connections.loadAcquire();
     if (cd) {
+        QObjectPrivate::Sender *currentSenders = cd->currentSender;
         if (cd->currentSender) {
             cd->currentSender->receiverDeleted();
             cd->currentSender = nullptr;
@@ -1123,7 +1124,8 @@ QObject::~QObject()
 
             if (locksAreTheSame) // otherwise already unlocked
                 locker.unlock();
-            if (slotObj)
+            // a slot object that is being called is destroyed when the call returns
+            if (slotObj && !QObjectPrivate::Sender::adoptSlotObject(currentSenders, slotObj))
                 slotObj->destroyIfLastRef();
             locker.relock();
         }
@@ -4132,11 +4134,15 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                     receiverInSameThread ? QObjectPrivate::get(receiver)->connections.loadAcquire() : nullptr);
 
             if (c->isSlotObject) {
-                SlotObjectGuard obj{c->slotObj};
+                QtPrivate::QSlotObjectBase *slotObj = c->slotObj;
+                // The destructor of a receiver living in this thread leaves the slot object
+                // to senderData, only keep it alive ourselves if the receiver lives elsewhere.
+                // This saves two atomic operations per call of a functor or member function.
+                SlotObjectGuard guard{senderData.watchSlotObject(slotObj) ? nullptr : slotObj};
 
                 {
-                    Q_TRACE_SCOPE(QMetaObject_activate_slot_functor, c->slotObj);
-                    obj->call(receiver, argv);
+                    Q_TRACE_SCOPE(QMetaObject_activate_slot_functor, slotObj);
+                    slotObj->call(receiver, argv);
                 }
             } else if (c->callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
                 //we compare the vtable to make sure we are not in the destructor of the object.
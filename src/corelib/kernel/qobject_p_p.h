@@ -236,6 +236,8 @@ struct QObjectPrivate::Sender
     {
         if (receiver)
             receiver->d_func()->connections.loadAcquire()->currentSender = previous;
+        if (adoptedSlotObject)
+            adoptedSlotObject->destroyIfLastRef();
     }
     void receiverDeleted()
     {
@@ -245,10 +247,35 @@ struct QObjectPrivate::Sender
             s = s->previous;
         }
     }
+    // Returns whether the receiver hands slotObject over to us if it gets
+    // destroyed while we call it, so that the call doesn't need a reference.
+    bool watchSlotObject(QtPrivate::QSlotObjectBase *slotObject)
+    {
+        if (!receiver)
+            return false;
+        watchedSlotObject = slotObject;
+        return true;
+    }
+    // Called by the destructor of the receiver, with the senders that were
+    // current, for the slot objects of the connections it's removing.
+    static bool adoptSlotObject(Sender *senders, QtPrivate::QSlotObjectBase *slotObject)
+    {
+        Sender *outermost = nullptr;
+        for (Sender *s = senders; s; s = s->previous) {
+            if (s->watchedSlotObject == slotObject)
+                outermost = s;
+        }
+        if (!outermost)
+            return false;
+        outermost->adoptedSlotObject = slotObject;
+        return true;
+    }
     Sender *previous = nullptr;
     QObject *receiver;
     QObject *sender;
     int signal;
+    QtPrivate::QSlotObjectBase *watchedSlotObject = nullptr;
+    QtPrivate::QSlotObjectBase *adoptedSlotObject = nullptr;
 };
 Q_DECLARE_TYPEINFO(QObjectPrivate::Sender, Q_RELOCATABLE_TYPE);
 
@@ -55,6 +55,154 @@ void QPropertyBindingDataPointer::addObserver(QPropertyObserver *observer)
     }
 }
 
+/*!
+    \internal
+
+    QPropertyBindingBatch evaluates the bindings that depend on changed
+    properties, directly or through other bindings, in topological order. A
+    binding depending on several of them is evaluated once, after all of its
+    dependencies, and only if one of them changed.
+
+    add() fails if the bindings observing a property have a binding loop. The
+    caller then evaluates them recursively, which reports the loop. Bindings
+    that start observing a binding of the batch while it is evaluated are
+    evaluated recursively as well.
+*/
+class QPropertyBindingBatch
+{
+    Q_DISABLE_COPY_MOVE(QPropertyBindingBatch)
+public:
+    enum State : quint8 {
+        NotInBatch,
+        Visiting,   // while adding the bindings observing it
+        Clean,      // none of its dependencies changed
+        Dirty,
+    };
+
+    QPropertyBindingBatch() = default;
+    ~QPropertyBindingBatch()
+    {
+        // if add() failed or a binding threw an exception
+        for (const auto &binding : std::as_const(order))
+            get(binding)->batchState = NotInBatch;
+    }
+
+    static bool isEvaluating() { return evaluating; }
+
+    // whether the bindings observing a property are observed by bindings too,
+    // otherwise evaluating them recursively is as good and cheaper
+    static bool hasDependentBindings(QPropertyObserverPointer observer)
+    {
+        for (; observer; observer = observer.nextObserver()) {
+            if (observer.ptr->next.tag() == QPropertyObserver::ObserverNotifiesBinding) {
+                for (auto dependent = observer.binding()->firstObserver; dependent;
+                     dependent = dependent.nextObserver()) {
+                    if (dependent.ptr->next.tag() == QPropertyObserver::ObserverNotifiesBinding)
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool add(QPropertyObserverPointer observer)
+    {
+        const Bindings bindings = bindingsObserving(observer);
+        for (auto it = bindings.crbegin(); it != bindings.crend(); ++it) {
+            if (!visit(*it))
+                return false;
+            (*it)->batchState = Dirty;
+        }
+        return true;
+    }
+
+    void evaluate(PendingBindingObserverList &bindingObservers, QBindingStatus *status)
+    {
+        QScopedValueRollback<bool> guard(evaluating, true);
+        // the bindings are after the ones depending on them
+        while (!order.isEmpty()) {
+            QPropertyBindingPrivatePtr bindingPtr = std::move(order.last());
+            order.removeLast();
+            QPropertyBindingPrivate *binding = get(bindingPtr);
+            const bool dirty = binding->batchState == Dirty;
+            binding->batchState = NotInBatch;
+            // skip the bindings removed from their property meanwhile
+            if (!dirty || !binding->propertyDataPtr || !binding->evaluate_inline(nullptr, status))
+                continue;
+            markObserversDirty(binding, bindingObservers, status);
+            bindingObservers.push_back(std::move(bindingPtr));
+        }
+    }
+
+private:
+    using Bindings = QVarLengthArray<QPropertyBindingPrivate *, 8>;
+
+    static QPropertyBindingPrivate *get(const QPropertyBindingPrivatePtr &binding)
+    { return static_cast<QPropertyBindingPrivate *>(binding.get()); }
+
+    static Bindings bindingsObserving(QPropertyObserverPointer observer)
+    {
+        Bindings bindings;
+        for (; observer; observer = observer.nextObserver()) {
+            if (observer.ptr->next.tag() == QPropertyObserver::ObserverNotifiesBinding)
+                bindings.append(observer.binding());
+        }
+        return bindings;
+    }
+
+    // adds binding after the bindings depending on it
+    bool visit(QPropertyBindingPrivate *binding)
+    {
+        if (binding->batchState == Visiting || binding->updating)
+            return false;
+        if (binding->batchState != NotInBatch)
+            return true;
+
+        binding->batchState = Visiting;
+        const Bindings dependents = bindingsObserving(binding->firstObserver);
+        // so that they're evaluated in the order of the observers, like recursively
+        for (auto it = dependents.crbegin(); it != dependents.crend(); ++it) {
+            if (!visit(*it)) {
+                binding->batchState = NotInBatch;
+                return false;
+            }
+        }
+        binding->batchState = Clean;
+        order.emplace_back(binding);
+        return true;
+    }
+
+    void markObserversDirty(QPropertyBindingPrivate *binding,
+                            PendingBindingObserverList &bindingObservers, QBindingStatus *status)
+    {
+        binding->firstObserver.noSelfDependencies(binding);
+        QPropertyObserver *observer = binding->firstObserver.ptr;
+        // See also comment in QPropertyObserverPointer::notify()
+        while (observer) {
+            QPropertyObserver *next = observer->next.data();
+            if (QPropertyObserver::ObserverTag(observer->next.tag()) == QPropertyObserver::ObserverNotifiesBinding) {
+                QPropertyBindingPrivate *dependent = observer->binding;
+                if (dependent->batchState == Clean) {
+                    dependent->batchState = Dirty;
+                } else if (dependent->batchState == NotInBatch) {
+                    // it started observing binding during the batch
+                    QPropertyObserverNodeProtector protector(observer);
+                    QPropertyBindingPrivatePtr dependentPtr(dependent);
+                    if (dependent->evaluateRecursive_inline(bindingObservers, status))
+                        bindingObservers.push_back(std::move(dependentPtr));
+                    next = protector.next();
+                }
+            }
+            observer = next;
+        }
+    }
+
+    static thread_local bool evaluating;
+    PendingBindingObserverList order;
+};
+
+Q_CONSTINIT thread_local bool QPropertyBindingBatch::evaluating = false;
+
 /*!
     \internal
 
@@ -122,10 +270,26 @@ struct QPropertyDelayedNotifications
         binding updates and notifications used in non-deferred updates).
      */
      void evaluateBindings(PendingBindingObserverList &bindingObservers, qsizetype index, QBindingStatus *status) {
+        auto *bindingData = restore(index);
+        if (!bindingData)
+            return;
+
+        QPropertyBindingDataPointer bindingDataPointer{bindingData};
+        QPropertyObserverPointer observer = bindingDataPointer.firstObserver();
+        if (observer)
+            observer.evaluateBindings(bindingObservers, status);
+    }
+
+    /*!
+        \internal
+        Restores the original binding data of the QPropertyProxyBindingData at
+        position \a index, and returns it.
+     */
+    const QPropertyBindingData *restore(qsizetype index) {
         auto *delayed = delayedProperties + index;
         auto *bindingData = delayed->originalBindingData;
         if (!bindingData)
-            return;
+            return nullptr;
 
         bindingData->d_ptr = delayed->d_ptr;
         Q_ASSERT(!(bindingData->d_ptr & QPropertyBindingData::DelayedNotificationBit));
@@ -133,11 +297,19 @@ struct QPropertyDelayedNotifications
             if (auto observer = reinterpret_cast<QPropertyObserver *>(bindingData->d_ptr))
                 observer->prev = reinterpret_cast<QPropertyObserver **>(&bindingData->d_ptr);
         }
+        return bindingData;
+    }
 
-        QPropertyBindingDataPointer bindingDataPointer{bindingData};
-        QPropertyObserverPointer observer = bindingDataPointer.firstObserver();
-        if (observer)
-            observer.evaluateBindings(bindingObservers, status);
+    /*!
+        \internal
+        Returns the first observer of the property at position \a index,
+        without restoring its binding data.
+     */
+    QPropertyObserverPointer firstObserver(qsizetype index) const {
+        auto *bindingData = delayedProperties[index].originalBindingData;
+        if (!bindingData)
+            return {};
+        return QPropertyBindingDataPointer{bindingData}.firstObserver();
     }
 
     /*!
@@ -176,6 +348,8 @@ Q_CONSTINIT static thread_local QBindingStatus bindingStatus;
     changing a property does neither immediately update any dependent properties
     nor does it trigger change notifications.
     Those are instead deferred until the group is ended by a call to endPropertyUpdateGroup.
+    A binding depending on several of the properties changed in the group is then evaluated
+    only once.
 
     Groups can be nested. In that case, the deferral ends only after the outermost group has been
     ended.
@@ -218,9 +392,30 @@ void Qt::endPropertyUpdateGroup()
     groupUpdateData = nullptr;
     // ensures that bindings are kept alive until endPropertyUpdateGroup concludes
     PendingBindingObserverList bindingObservers;
-    // update all delayed properties
     auto start = data;
-    while (data) {
+    // update all delayed properties, in one batch if possible, so that a
+    // binding depending on several of them is evaluated once
+    bool batched = !QPropertyBindingBatch::isEvaluating();
+    if (batched) {
+        QVarLengthArray<QPropertyObserverPointer, 16> observers;
+        for (auto *page = start; page; page = page->next) {
+            for (qsizetype i = 0; i < page->used; ++i) {
+                if (QPropertyObserverPointer observer = page->firstObserver(i))
+                    observers.append(observer);
+            }
+        }
+        QPropertyBindingBatch batch;
+        for (auto it = observers.crbegin(); batched && it != observers.crend(); ++it)
+            batched = batch.add(*it);
+        if (batched) {
+            for (auto *page = start; page; page = page->next) {
+                for (qsizetype i = 0; i < page->used; ++i)
+                    page->restore(i);
+            }
+            batch.evaluate(bindingObservers, status);
+        }
+    }
+    while (!batched && data) {
         for (qsizetype i = 0; i < data->used; ++i)
             data->evaluateBindings(bindingObservers, i, status);
         data = data->next;
@@ -800,6 +995,14 @@ void QPropertyObserverPointer::noSelfDependencies(QPropertyBindingPrivate *bindi
 void QPropertyObserverPointer::evaluateBindings(PendingBindingObserverList &bindingObservers, QBindingStatus *status)
 {
     Q_ASSERT(status);
+    if (!QPropertyBindingBatch::isEvaluating() && QPropertyBindingBatch::hasDependentBindings(*this)) {
+        QPropertyBindingBatch batch;
+        if (batch.add(*this)) {
+            batch.evaluate(bindingObservers, status);
+            return;
+        }
+    }
+
     auto observer = const_cast<QPropertyObserver*>(ptr);
     // See also comment in notify()
     while (observer) {
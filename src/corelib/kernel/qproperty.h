@@ -243,6 +243,7 @@ private:
     friend struct QPropertyObserverPointer;
     friend struct QPropertyBindingDataPointer;
     friend class QPropertyBindingPrivate;
+    friend class QPropertyBindingBatch;
 
     QTaggedPointer<QPropertyObserver, ObserverTag> next;
     // prev is a pointer to the "next" element within the previous node, or to the "firstObserverPtr" if it is the
@@ -258,6 +258,7 @@ class Q_CORE_EXPORT QPropertyBindingPrivate : public QtPrivate::RefCounted
 private:
     friend struct QPropertyBindingDataPointer;
     friend class QPropertyBindingPrivatePtr;
+    friend class QPropertyBindingBatch;
 
     using ObserverArray = std::array<QPropertyObserver, 4>;
 
@@ -275,6 +276,8 @@ private:
        in qtdeclarative
     */
     bool m_sticky:1;
+    // QPropertyBindingBatch::State of the binding in the batch being evaluated
+    quint8 batchState:2;
 
     const QtPrivate::BindingFunctionVTable *vtable;
 
@@ -333,6 +336,7 @@ public:
         : hasBindingWrapper(false)
         , isQQmlPropertyBinding(isQQmlPropertyBinding)
         , m_sticky(false)
+        , batchState(0)
         , vtable(vtable)
         , location(location)
         , metaType(metaType)
@@ -399,7 +403,9 @@ public:
 
     bool evaluateRecursive(PendingBindingObserverList &bindingObservers, QBindingStatus *status = nullptr);
 
-    bool Q_ALWAYS_INLINE evaluateRecursive_inline(PendingBindingObserverList &bindingObservers, QBindingStatus *status);
+    bool Q_ALWAYS_INLINE evaluateRecursive_inline(PendingBindingObserverList &bindingObservers, QBindingStatus *status)
+    { return evaluate_inline(&bindingObservers, status); }
+    bool Q_ALWAYS_INLINE evaluate_inline(PendingBindingObserverList *bindingObservers, QBindingStatus *status);
 
     void notifyNonRecursive(const PendingBindingObserverList &bindingObservers);
     enum NotificationState : bool { Delayed, Sent };
@@ -825,7 +831,13 @@ struct QUntypedBindablePrivate
     }
 };
 
-inline bool QPropertyBindingPrivate::evaluateRecursive_inline(PendingBindingObserverList &bindingObservers, QBindingStatus *status)
+/*!
+    \internal
+    Evaluates the binding. If it changed and \a bindingObservers isn't
+    \nullptr, evaluates the bindings observing it recursively and adds those
+    that changed to \a bindingObservers.
+ */
+inline bool QPropertyBindingPrivate::evaluate_inline(PendingBindingObserverList *bindingObservers, QBindingStatus *status)
 {
     if (updating) {
         m_error = QPropertyBindingError(QPropertyBindingError::BindingLoop);
@@ -860,11 +872,11 @@ inline bool QPropertyBindingPrivate::evaluateRecursive_inline(PendingBindingObse
     // If there was a change, we must set pendingNotify.
     // If there was not, we must not clear it, as that only should happen in notifyRecursive
     pendingNotify = pendingNotify || changed;
-    if (!changed || !firstObserver)
+    if (!changed || !firstObserver || !bindingObservers)
         return changed;
 
     firstObserver.noSelfDependencies(this);
-    firstObserver.evaluateBindings(bindingObservers, status);
+    firstObserver.evaluateBindings(*bindingObservers, status);
     return true;
 }
 
@@ -9,6 +9,7 @@
 #include "private/qtimerinfo_unix_p.h"
 #include "private/qobject_p.h"
 #include "private/qabstracteventdispatcher_p.h"
+#include "private/qeventloopprofiler_p.h"
 
 #include <sys/times.h>
 
@@ -405,6 +406,11 @@ int QTimerInfoList::activateTimers()
             firstTimerInfo = currentTimerInfo;
         }
 
+        if (Q_UNLIKELY(QEventLoopProfiler::isEnabled())) {
+            const nanoseconds lateness = now - currentTimerInfo->timeout;
+            QEventLoopProfiler::recordTimerLateness(lateness.count());
+        }
+
         // determine next timeout time
         calculateNextTimeout(currentTimerInfo, now);
         if (timers.size() > 1) {
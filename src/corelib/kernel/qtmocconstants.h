@@ -30,7 +30,11 @@ namespace QtMocConstants {
 // revision 11 is Qt 6.5: The metatype for void is stored in the metatypes array
 // revision 12 is Qt 6.6: It adds the metatype for enums
 // revision 13 is Qt 6.9: Adds support for 64-bit QFlags and moves the method revision
-enum { OutputRevision = 13 };   // Used by moc, qmetaobjectbuilder and qdbus
+// revision 14 is Qt 6.9: Adds hash tables for looking up methods and properties by name
+enum { OutputRevision = 14 };   // Used by moc, qmetaobjectbuilder and qdbus
+
+// Classes with fewer methods or properties than this don't get a lookup table
+enum { MinimumLookupTableCount = 8 };
 
 enum PropertyFlags : uint {
     Invalid = 0x00000000,
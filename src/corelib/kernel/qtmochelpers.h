@@ -108,6 +108,27 @@ template <uint... Nx> constexpr auto stringData(const char (&...strings)[Nx])
     return StringRefStorage(strings...).create();
 }
 
+// FNV-1a, used by the lookup tables of the methods and properties
+constexpr uint lookupHash(const char *name, size_t size) noexcept
+{
+    uint hash = 2166136261U;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ uchar(name[i])) * 16777619U;
+    return hash;
+}
+
+// The number of entries of the lookup table for count items, a power of two
+// so that at most two thirds of the entries are used
+constexpr uint lookupTableSize(uint count) noexcept
+{
+    if (count < QtMocConstants::MinimumLookupTableCount)
+        return 0;
+    uint size = 2;
+    while (size < count + count / 2 + 1)
+        size *= 2;
+    return size;
+}
+
 template <typename FuncType> inline bool indexOfMethod(void **_a, FuncType f, int index) noexcept
 {
     int *result = static_cast<int *>(_a[0]);
@@ -520,13 +541,19 @@ constexpr auto metaObjectData(uint flags, const Strings &strings,
             + Methods::metaTypeCount()
             + Constructors::metaTypeCount();
 
-    constexpr uint HeaderSize = 14;
+    constexpr uint MethodLookupTableSize = lookupTableSize(Methods::count());
+    constexpr uint PropertyLookupTableSize = lookupTableSize(Properties::count());
+    constexpr uint LookupDataSize = MethodLookupTableSize || PropertyLookupTableSize
+            ? 2 + MethodLookupTableSize + PropertyLookupTableSize : 0;
+
+    constexpr uint HeaderSize = 15;
     constexpr uint TotalSize = HeaderSize
             + Properties::dataSize()
             + Enums::dataSize()
             + Methods::dataSize()
             + Constructors::dataSize()
             + ClassInfo::headerSize() // + ClassInfo::payloadSize()
+            + LookupDataSize
             + 1;    // empty EOD
 
     MetaObjectContents<TotalSize, 2 * Strings::StringCount, Strings::StringSize,
@@ -582,6 +609,36 @@ constexpr auto metaObjectData(uint flags, const Strings &strings,
         }
     }
 
+    // Hash tables of the relative indices of the methods and properties by
+    // name, using linear probing. The methods sharing a name are all found by
+    // probing until an empty entry.
+    if constexpr (LookupDataSize != 0) {
+        data[14] = dataoffset;
+        data[dataoffset++] = MethodLookupTableSize;
+        data[dataoffset++] = PropertyLookupTableSize;
+        auto fillLookupTable = [&](uint size, uint count, uint itemData, uint intsPerItem) {
+            uint *table = data + dataoffset;
+            for (uint i = 0; i < count; ++i) {
+                const uint nameIndex = data[itemData + i * intsPerItem];
+                const uint hash = lookupHash(strings.inputs[nameIndex],
+                                             result.staticData.stringdata[2 * nameIndex + 1]);
+                uint entry = hash & (size - 1);
+                while (table[entry])
+                    entry = (entry + 1) & (size - 1);
+                table[entry] = i + 1;
+            }
+            dataoffset += size;
+        };
+        if constexpr (MethodLookupTableSize != 0) {
+            fillLookupTable(MethodLookupTableSize, methods.count(), data[5],
+                            Methods::headerSize() / Methods::count());
+        }
+        if constexpr (PropertyLookupTableSize != 0) {
+            fillLookupTable(PropertyLookupTableSize, properties.count(), data[7],
+                            Properties::headerSize() / Properties::count());
+        }
+    }
+
     return result;
 }
 
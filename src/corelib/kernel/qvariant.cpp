@@ -2116,19 +2116,14 @@ bool QVariant::convert(QMetaType targetType)
     if (d.type() == targetType)
         return targetType.isValid();
 
-    QVariant oldValue = *this;
-
-    clear();
-    create(targetType, nullptr);
-    if (!oldValue.canConvert(targetType))
-        return false;
-
+    // convert into the storage of the result, instead of copying the old value first
+    QVariant converted = fromMetaType(targetType);
+    bool ok = false;
     // Fail if the value is not initialized or was forced null by a previous failed convert.
-    if (oldValue.d.is_null && oldValue.d.type().id() != QMetaType::Nullptr)
-        return false;
-
-    bool ok = QMetaType::convert(oldValue.d.type(), oldValue.constData(), targetType, data());
-    d.is_null = !ok;
+    if (canConvert(targetType) && (!d.is_null || d.type().id() == QMetaType::Nullptr))
+        ok = QMetaType::convert(d.type(), constData(), targetType, converted.data());
+    converted.d.is_null = !ok;
+    swap(converted);
     return ok;
 }
 
@@ -96,7 +96,12 @@ public:
 
     struct Private
     {
+#if QT_VERSION >= QT_VERSION_CHECK(7, 0, 0)
+        // large enough for QRectF and QLineF on 64-bit platforms
+        static constexpr size_t MaxInternalSize = 4 * sizeof(void *);
+#else
         static constexpr size_t MaxInternalSize = 3 * sizeof(void *);
+#endif
         template <size_t S> static constexpr bool FitsInInternalSize = S <= MaxInternalSize;
         template<typename T> static constexpr bool CanUseInternalSpace =
                 (QTypeInfo<T>::isRelocatable && FitsInInternalSize<sizeof(T)> && alignof(T) <= alignof(double));
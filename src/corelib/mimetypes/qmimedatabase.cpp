@@ -19,6 +19,10 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QUrl>
 #include <QtCore/QDebug>
+#if QT_CONFIG(thread)
+#  include <QtCore/QSemaphore>
+#  include <QtCore/QThreadPool>
+#endif
 
 #include <algorithm>
 #include <functional>
@@ -358,6 +362,19 @@ QMimeType QMimeDatabasePrivate::findByData(const QByteArray &data, int *accuracy
     return mimeTypeForName(defaultMimeType());
 }
 
+// Reads 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
+// This is much faster than seeking back and forth into QIODevice.
+static std::optional<QByteArray> readHeader(QIODevice *device)
+{
+    const bool openedByUs = !device->isOpen() && device->open(QIODevice::ReadOnly);
+    if (!device->isOpen())
+        return std::nullopt;
+    QByteArray data = device->peek(16384);
+    if (openedByUs)
+        device->close();
+    return data;
+}
+
 QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileName, QIODevice *device)
 {
     // First, glob patterns are evaluated. If there is a match with max weight,
@@ -377,54 +394,47 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
 
     // Extension is unknown, or matches multiple mimetypes.
     // Pass 2) Match on content, if we can read the data
-    const auto matchOnContent = [this, &candidatesByName](QIODevice *device) {
-        const bool openedByUs = !device->isOpen() && device->open(QIODevice::ReadOnly);
-        if (device->isOpen()) {
-            // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
-            // This is much faster than seeking back and forth into QIODevice.
-            const QByteArray data = device->peek(16384);
-
-            if (openedByUs)
-                device->close();
-
-            int magicAccuracy = 0;
-            QMimeType candidateByData(findByData(data, &magicAccuracy));
-
-            // Disambiguate conflicting extensions (if magic matching found something)
-            if (candidateByData.isValid() && magicAccuracy > 0) {
-                const QString sniffedMime = candidateByData.name();
-                // If the sniffedMime matches a highest-weight glob match, use it
-                if (candidatesByName.m_matchingMimeTypes.contains(sniffedMime)) {
-                    return candidateByData;
-                }
-                for (const QString &m : std::as_const(candidatesByName.m_allMatchingMimeTypes)) {
-                    if (inherits(m, sniffedMime)) {
-                        // We have magic + pattern pointing to this, so it's a pretty good match
-                        return mimeTypeForName(m);
-                    }
-                }
-                if (candidatesByName.m_allMatchingMimeTypes.isEmpty()) {
-                    // No glob, use magic
-                    return candidateByData;
+    QFile fallbackFile(fileName);
+    const std::optional<QByteArray> data = readHeader(device ? device : &fallbackFile);
+    return mimeTypeForFileNameAndContent(candidatesByName, data ? &*data : nullptr);
+}
+
+// Second pass of mimeTypeForFileNameAndData(), \a data is null if the file couldn't be read
+QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndContent(QMimeGlobMatchResult &candidatesByName,
+                                                              const QByteArray *data)
+{
+    if (data) {
+        int magicAccuracy = 0;
+        QMimeType candidateByData(findByData(*data, &magicAccuracy));
+
+        // Disambiguate conflicting extensions (if magic matching found something)
+        if (candidateByData.isValid() && magicAccuracy > 0) {
+            const QString sniffedMime = candidateByData.name();
+            // If the sniffedMime matches a highest-weight glob match, use it
+            if (candidatesByName.m_matchingMimeTypes.contains(sniffedMime)) {
+                return candidateByData;
+            }
+            for (const QString &m : std::as_const(candidatesByName.m_allMatchingMimeTypes)) {
+                if (inherits(m, sniffedMime)) {
+                    // We have magic + pattern pointing to this, so it's a pretty good match
+                    return mimeTypeForName(m);
                 }
             }
+            if (candidatesByName.m_allMatchingMimeTypes.isEmpty()) {
+                // No glob, use magic
+                return candidateByData;
+            }
         }
+    }
 
-        if (candidatesByName.m_allMatchingMimeTypes.size() > 1) {
-            candidatesByName.m_matchingMimeTypes.sort(); // make it deterministic
-            const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
-            if (mime.isValid())
-                return mime;
-        }
-
-        return mimeTypeForName(defaultMimeType());
-    };
-
-    if (device)
-        return matchOnContent(device);
+    if (candidatesByName.m_allMatchingMimeTypes.size() > 1) {
+        candidatesByName.m_matchingMimeTypes.sort(); // make it deterministic
+        const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
+        if (mime.isValid())
+            return mime;
+    }
 
-    QFile fallbackFile(fileName);
-    return matchOnContent(&fallbackFile);
+    return mimeTypeForName(defaultMimeType());
 }
 
 QMimeType QMimeDatabasePrivate::mimeTypeForFileExtension(const QString &fileName)
@@ -440,23 +450,16 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileExtension(const QString &fileName
 
 QMimeType QMimeDatabasePrivate::mimeTypeForData(QIODevice *device)
 {
-    int accuracy = 0;
-    const bool openedByUs = !device->isOpen() && device->open(QIODevice::ReadOnly);
-    if (device->isOpen()) {
-        // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
-        // This is much faster than seeking back and forth into QIODevice.
-        const QByteArray data = device->peek(16384);
-        QMimeType result = findByData(data, &accuracy);
-        if (openedByUs)
-            device->close();
-        return result;
+    if (const std::optional<QByteArray> data = readHeader(device)) {
+        int accuracy = 0;
+        return findByData(*data, &accuracy);
     }
     return mimeTypeForName(defaultMimeType());
 }
 
-QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
-                                                const QFileInfo &fileInfo,
-                                                QMimeDatabase::MatchMode mode)
+// Returns the MIME type name for directories and other special files, or an
+// empty string for regular files. Doesn't need the database mutex.
+static QString inodeMimeTypeName(const QString &fileName, const QFileInfo &fileInfo)
 {
     if (false) {
 #ifdef Q_OS_UNIX
@@ -467,20 +470,31 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
         QT_STATBUF statBuffer;
         if (QT_STAT(nativeFilePath.constData(), &statBuffer) == 0) {
             if (S_ISDIR(statBuffer.st_mode))
-                return mimeTypeForName(directoryMimeType());
+                return directoryMimeType();
             if (S_ISCHR(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/chardevice"));
+                return QStringLiteral("inode/chardevice");
             if (S_ISBLK(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/blockdevice"));
+                return QStringLiteral("inode/blockdevice");
             if (S_ISFIFO(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/fifo"));
+                return QStringLiteral("inode/fifo");
             if (S_ISSOCK(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/socket"));
+                return QStringLiteral("inode/socket");
         }
+#else
+        Q_UNUSED(fileName);
 #endif
     } else if (fileInfo.isDir()) {
-        return mimeTypeForName(directoryMimeType());
+        return directoryMimeType();
     }
+    return QString();
+}
+
+QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
+                                                const QFileInfo &fileInfo,
+                                                QMimeDatabase::MatchMode mode)
+{
+    if (const QString inodeType = inodeMimeTypeName(fileName, fileInfo); !inodeType.isEmpty())
+        return mimeTypeForName(inodeType);
 
     switch (mode) {
     case QMimeDatabase::MatchDefault:
@@ -496,6 +510,102 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
     return mimeTypeForFileNameAndData(fileName, nullptr);
 }
 
+QList<QMimeType> QMimeDatabasePrivate::mimeTypesForFiles(const QStringList &fileNames,
+                                                         QMimeDatabase::MatchMode mode)
+{
+    const qsizetype count = fileNames.size();
+    QList<QMimeType> result(count);
+
+    if (mode == QMimeDatabase::MatchExtension) {
+        QMutexLocker locker(&mutex);
+        for (qsizetype i = 0; i < count; ++i)
+            result[i] = mimeTypeForFileExtension(fileNames.at(i));
+        return result;
+    }
+
+    // The same steps as mimeTypeForFile(), but the file system is only accessed
+    // while the mutex is unlocked, from several threads.
+    struct Job {
+        QStringList fileNames;
+        QList<bool> needsContent;
+        QStringList inodeTypes;
+        QList<std::optional<QByteArray>> headers;
+        QAtomicInteger<qsizetype> next = 0;
+#if QT_CONFIG(thread)
+        QSemaphore done;
+#endif
+    };
+    // helpers that start late only touch the Job, which they share ownership of
+    const auto job = std::make_shared<Job>();
+    job->fileNames = fileNames;
+    job->needsContent.fill(true, count);
+    job->inodeTypes.resize(count);
+    job->headers.resize(count);
+
+    // Pass 1) Try to match on the file names
+    QList<QMimeGlobMatchResult> candidatesByName(count);
+    if (mode == QMimeDatabase::MatchDefault) {
+        QMutexLocker locker(&mutex);
+        for (qsizetype i = 0; i < count; ++i) {
+            candidatesByName[i] = findByFileName(fileNames.at(i));
+            if (candidatesByName.at(i).m_allMatchingMimeTypes.size() == 1) {
+                result[i] = mimeTypeForName(candidatesByName.at(i).m_matchingMimeTypes.at(0));
+                if (result.at(i).isValid())
+                    job->needsContent[i] = false;
+                else
+                    candidatesByName[i] = {};
+            }
+        }
+    }
+
+    // Pass 2) Look for special files, and read the headers of the files which
+    // have to be matched on content
+    const auto readFiles = [job, count] {
+        qsizetype i;
+        while ((i = job->next.fetchAndAddRelaxed(1)) < count) {
+            const QString &fileName = job->fileNames.at(i);
+            job->inodeTypes[i] = inodeMimeTypeName(fileName, QFileInfo(fileName));
+            if (job->inodeTypes.at(i).isEmpty() && job->needsContent.at(i)) {
+                QFile file(fileName);
+                job->headers[i] = readHeader(&file);
+            }
+#if QT_CONFIG(thread)
+            job->done.release();
+#endif
+        }
+    };
+#if QT_CONFIG(thread)
+    // the calling thread reads too, so this completes even if the pool is busy
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype helpers = qMin(count - 1, qsizetype(pool->maxThreadCount()));
+    for (qsizetype i = 0; i < helpers; ++i)
+        pool->start(readFiles);
+    readFiles();
+    job->done.acquire(int(count));
+#else
+    readFiles();
+#endif
+
+    // Pass 3) Match on content
+    QMutexLocker locker(&mutex);
+    for (qsizetype i = 0; i < count; ++i) {
+        const std::optional<QByteArray> &header = job->headers.at(i);
+        if (!job->inodeTypes.at(i).isEmpty()) {
+            result[i] = mimeTypeForName(job->inodeTypes.at(i));
+        } else if (!job->needsContent.at(i)) {
+            continue;
+        } else if (mode == QMimeDatabase::MatchContent) {
+            int accuracy = 0;
+            result[i] = header ? findByData(*header, &accuracy)
+                               : mimeTypeForName(defaultMimeType());
+        } else {
+            result[i] = mimeTypeForFileNameAndContent(candidatesByName[i],
+                                                      header ? &*header : nullptr);
+        }
+    }
+    return result;
+}
+
 QList<QMimeType> QMimeDatabasePrivate::allMimeTypes()
 {
     QList<QMimeType> result;
@@ -651,6 +761,26 @@ QMimeType QMimeDatabase::mimeTypeForFile(const QString &fileName, MatchMode mode
     }
 }
 
+/*!
+    \since 6.9
+
+    Returns the MIME types for the files named \a fileNames using \a mode,
+    in the same order. The MIME type returned for each file is the same as
+    the one returned by mimeTypeForFile().
+
+    This is faster than calling mimeTypeForFile() for each file, in particular
+    on slow file systems: the files whose content has to be looked at are
+    opened and read in parallel, using QThreadPool::globalInstance(), and the
+    database is not locked while this happens.
+
+    \sa mimeTypeForFile()
+*/
+QList<QMimeType> QMimeDatabase::mimeTypesForFiles(const QStringList &fileNames,
+                                                  MatchMode mode) const
+{
+    return d->mimeTypesForFiles(fileNames, mode);
+}
+
 /*!
     Returns the MIME types for the file name \a fileName.
 
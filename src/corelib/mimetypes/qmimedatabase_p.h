@@ -30,6 +30,7 @@ QT_REQUIRE_CONFIG(mimetype);
 
 #include <vector>
 #include <memory>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -58,6 +59,8 @@ public:
     QStringList parents(const QString &mimeName);
     QMimeType mimeTypeForName(const QString &nameOrAlias);
     QMimeType mimeTypeForFileNameAndData(const QString &fileName, QIODevice *device);
+    QMimeType mimeTypeForFileNameAndContent(QMimeGlobMatchResult &candidatesByName,
+                                            const QByteArray *data);
     QMimeType mimeTypeForFileExtension(const QString &fileName);
     QMimeType mimeTypeForData(QIODevice *device);
     QMimeType mimeTypeForFile(const QString &fileName, const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode);
@@ -73,6 +76,7 @@ public:
     QStringList mimeParents(const QString &mimeName);
     QStringList listAliases(const QString &mimeName);
     bool mimeInherits(const QString &mime, const QString &parent);
+    QList<QMimeType> mimeTypesForFiles(const QStringList &fileNames, QMimeDatabase::MatchMode mode);
 
 private:
     using Providers = std::vector<std::unique_ptr<QMimeProviderBase>>;
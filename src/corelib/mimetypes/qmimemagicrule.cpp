@@ -302,6 +302,22 @@ QByteArray QMimeMagicRule::mask() const
     return result;
 }
 
+// Returns the byte the data has to start with for this rule to match, or -1
+// if the rule doesn't look at offset 0 or doesn't compare the whole byte.
+int QMimeMagicRule::anchoredFirstByte() const
+{
+    if (!m_matchFunction || m_startPos != 0 || m_endPos != 0)
+        return -1;
+    switch (m_type) {
+    case String:
+        return uchar(m_mask.at(0)) == 0xff ? int(uchar(m_pattern.at(0))) : -1;
+    case Byte:
+        return m_numberMask == 0xff ? int(m_number) : -1;
+    default:
+        return -1;
+    }
+}
+
 bool QMimeMagicRule::matches(const QByteArray &data) const
 {
     const bool ok = m_matchFunction && (this->*m_matchFunction)(data);
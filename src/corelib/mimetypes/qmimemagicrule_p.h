@@ -53,6 +53,7 @@ public:
     int startPos() const { return m_startPos; }
     int endPos() const { return m_endPos; }
     QByteArray mask() const;
+    int anchoredFirstByte() const;
 
     bool isValid() const { return m_matchFunction != nullptr; }
 
@@ -18,6 +18,8 @@
 #include <QDateTime>
 #include <QtEndian>
 
+#include <algorithm>
+
 #if QT_CONFIG(mimetype_database)
 #  if defined(Q_CC_MSVC_ONLY)
 #    pragma section(".qtmimedatabase", read, shared)
@@ -712,9 +714,74 @@ void QMimeXMLProvider::addFileNameMatches(const QString &fileName, QMimeGlobMatc
     m_mimeTypeGlobs.matchingGlobs(fileName, result, filterFunc);
 }
 
+void QMimeXMLProvider::buildMagicIndex()
+{
+    // Highest priority first, keeping the file order between equal priorities,
+    // so that the first match is the one the full scan would have picked.
+    std::stable_sort(m_magicMatchers.begin(), m_magicMatchers.end(),
+                     [](const QMimeMagicRuleMatcher &lhs, const QMimeMagicRuleMatcher &rhs) {
+                         return lhs.priority() > rhs.priority();
+                     });
+
+    for (QList<qsizetype> &bucket : m_magicIndexByFirstByte)
+        bucket.clear();
+    m_unanchoredMagicIndex.clear();
+
+    for (qsizetype i = 0; i < m_magicMatchers.size(); ++i) {
+        // A matcher matches if any of its top-level rules does, so it goes
+        // into the bucket of each of them, or is checked for all data.
+        const QList<QMimeMagicRule> rules = m_magicMatchers.at(i).magicRules();
+        const bool anchored = !rules.isEmpty()
+                && std::all_of(rules.cbegin(), rules.cend(), [](const QMimeMagicRule &rule) {
+                       return rule.anchoredFirstByte() >= 0;
+                   });
+        if (!anchored) {
+            m_unanchoredMagicIndex.append(i);
+            continue;
+        }
+        for (const QMimeMagicRule &rule : rules) {
+            QList<qsizetype> &bucket = m_magicIndexByFirstByte[rule.anchoredFirstByte()];
+            if (bucket.isEmpty() || bucket.constLast() != i)
+                bucket.append(i);
+        }
+    }
+    m_magicIndexDirty = false;
+}
+
 void QMimeXMLProvider::findByMagic(const QByteArray &data, QMimeMagicResult &result)
 {
-    for (const QMimeMagicRuleMatcher &matcher : std::as_const(m_magicMatchers)) {
+    if (m_magicIndexDirty)
+        buildMagicIndex();
+
+    // Walk the matchers that can match this data in priority order, and stop
+    // at the first match or once nothing can beat the current result.
+    static const QList<qsizetype> noMatchers;
+    const QList<qsizetype> &anchored =
+            data.isEmpty() ? noMatchers : m_magicIndexByFirstByte[uchar(data.at(0))];
+    auto a = anchored.cbegin();
+    auto u = m_unanchoredMagicIndex.cbegin();
+    while (a != anchored.cend() || u != m_unanchoredMagicIndex.cend()) {
+        const qsizetype i = (u == m_unanchoredMagicIndex.cend() || (a != anchored.cend() && *a < *u))
+                ? *a++ : *u++;
+        const QMimeMagicRuleMatcher &matcher = m_magicMatchers.at(i);
+        const int priority = matcher.priority();
+        if (priority <= result.accuracy)
+            break;
+        if (matcher.matches(data)) {
+            result.accuracy = priority;
+            result.candidate = matcher.mimetype();
+            break;
+        }
+    }
+}
+
+#ifdef QT_BUILD_INTERNAL
+// For the autotest: tries every magic matcher, as findByMagic() did before it
+// used the index, so that the two can be compared.
+void QMimeXMLProvider::findByMagicWithoutIndex(const QByteArray &data,
+                                               QMimeMagicResult &result) const
+{
+    for (const QMimeMagicRuleMatcher &matcher : m_magicMatchers) {
         if (matcher.matches(data)) {
             const int priority = matcher.priority();
             if (priority > result.accuracy) {
@@ -724,6 +791,7 @@ void QMimeXMLProvider::findByMagic(const QByteArray &data, QMimeMagicResult &res
         }
     }
 }
+#endif
 
 void QMimeXMLProvider::ensureLoaded()
 {
@@ -742,6 +810,7 @@ void QMimeXMLProvider::ensureLoaded()
     m_parents.clear();
     m_mimeTypeGlobs.clear();
     m_magicMatchers.clear();
+    m_magicIndexDirty = true;
 
     //qDebug() << "Loading" << m_allFiles;
 
@@ -872,6 +941,7 @@ void QMimeXMLProvider::addAllMimeTypes(QList<QMimeType> &result)
 void QMimeXMLProvider::addMagicMatcher(const QMimeMagicRuleMatcher &matcher)
 {
     m_magicMatchers.append(matcher);
+    m_magicIndexDirty = true;
 }
 
 QT_END_NAMESPACE
@@ -24,6 +24,7 @@ QT_REQUIRE_CONFIG(mimetype);
 #include <QtCore/qdatetime.h>
 #include <QtCore/qset.h>
 
+#include <array>
 #include <map>
 
 QT_BEGIN_NAMESPACE
@@ -143,8 +144,8 @@ public:
     enum : bool { InternalDatabaseAvailable = false };
 #endif
     QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum);
-    QMimeXMLProvider(QMimeDatabasePrivate *db, const QString &directory);
-    ~QMimeXMLProvider();
+    Q_AUTOTEST_EXPORT QMimeXMLProvider(QMimeDatabasePrivate *db, const QString &directory);
+    Q_AUTOTEST_EXPORT ~QMimeXMLProvider();
 
     bool isValid() override;
     bool isInternalDatabase() const override;
@@ -153,7 +154,11 @@ public:
     void addParents(const QString &mime, QStringList &result) override;
     QString resolveAlias(const QString &name) override;
     void addAliases(const QString &name, QStringList &result) override;
-    void findByMagic(const QByteArray &data, QMimeMagicResult &result) override;
+    Q_AUTOTEST_EXPORT void findByMagic(const QByteArray &data, QMimeMagicResult &result) override;
+#ifdef QT_BUILD_INTERNAL
+    Q_AUTOTEST_EXPORT void findByMagicWithoutIndex(const QByteArray &data,
+                                                   QMimeMagicResult &result) const;
+#endif
     void addAllMimeTypes(QList<QMimeType> &result) override;
     void ensureLoaded() override;
     QMimeTypePrivate::LocaleHash localeComments(const QString &name) override;
@@ -174,6 +179,7 @@ public:
 private:
     void load(const QString &fileName);
     void load(const char *data, qsizetype len);
+    void buildMagicIndex();
 
     typedef QHash<QString, QMimeTypeXMLData> NameMimeTypeMap;
     NameMimeTypeMap m_nameMimeTypeMap;
@@ -185,7 +191,12 @@ private:
     ParentsHash m_parents;
     QMimeAllGlobPatterns m_mimeTypeGlobs;
 
-    QList<QMimeMagicRuleMatcher> m_magicMatchers;
+    QList<QMimeMagicRuleMatcher> m_magicMatchers; // sorted by priority by buildMagicIndex()
+    // Indexes into m_magicMatchers, for matchers that can only match data
+    // starting with a given byte, and for all the others.
+    std::array<QList<qsizetype>, 256> m_magicIndexByFirstByte;
+    QList<qsizetype> m_unanchoredMagicIndex;
+    bool m_magicIndexDirty = false;
     QStringList m_allFiles;
 };
 
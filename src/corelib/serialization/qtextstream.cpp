@@ -326,6 +326,10 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
     Q_ASSERT(!string);
     Q_ASSERT(device);
 
+    // the last view handed out by readLineView() is no longer needed; drop
+    // our reference so that appending below does not detach readBuffer.
+    lineViewBuffer.clear();
+
     // handle text translation and bypass the Text flag in the device.
     bool textModeEnabled = device->isTextModeEnabled();
     if (textModeEnabled)
@@ -387,8 +391,12 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
            QtDebugUtils::toPrintable(buf, bytesRead, 32).constData(), int(sizeof(buf)), int(bytesRead));
 #endif
 
+    // decode straight into the read buffer, without a temporary QString
     int oldReadBufferSize = readBuffer.size();
-    readBuffer += toUtf16(QByteArrayView(buf, bytesRead));
+    readBuffer.resize(oldReadBufferSize + toUtf16.requiredSpace(bytesRead));
+    QChar *decodedEnd = toUtf16.appendToBuffer(readBuffer.data() + oldReadBufferSize,
+                                               QByteArrayView(buf, bytesRead));
+    readBuffer.truncate(decodedEnd - readBuffer.constData());
 
     // remove all '\r\n' in the string.
     if (readBuffer.size() > oldReadBufferSize && textModeEnabled) {
@@ -549,6 +557,30 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // use the vectorized character search instead of looking at
+            // one character at a time
+            int available = endOffset - startOffset;
+            if (maxlen)
+                available = qMin(available, maxlen - totalSize);
+            const QStringView window(chPtr, available);
+            const int scanned = int(QtPrivate::qustrchr(window, u'\n') - window.utf16());
+            if (scanned < available) {
+                foundToken = true;
+                delimSize = ((scanned ? window[scanned - 1] : lastChar) == u'\r') ? 2 : 1;
+                consumeDelimiter = true;
+                lastChar = u'\n';
+                startOffset += scanned + 1;
+                totalSize += scanned + 1;
+            } else {
+                if (available)
+                    lastChar = window[available - 1];
+                startOffset += available;
+                totalSize += available;
+            }
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
@@ -1569,7 +1601,7 @@ QString QTextStream::readLine(qint64 maxlen)
     an error has occurred; otherwise returns \c true. The contents in
     \a line before the call are discarded in any case.
 
-    \sa readAll(), QIODevice::readLine(), QIODevice::readLineInto()
+    \sa readAll(), readLineView(), QIODevice::readLine(), QIODevice::readLineInto()
 */
 bool QTextStream::readLineInto(QString *line, qint64 maxlen)
 {
@@ -1596,6 +1628,52 @@ bool QTextStream::readLineInto(QString *line, qint64 maxlen)
     return true;
 }
 
+/*!
+    \since 6.9
+
+    Reads one line of text from the stream and returns a view of it, without
+    copying the characters out of the stream's internal buffer. The maximum
+    allowed line length is set to \a maxlen. If the stream contains lines
+    longer than this, then the lines will be split after \a maxlen
+    characters and returned in parts.
+
+    If \a maxlen is 0, the lines can be of any length.
+
+    The returned line has no trailing end-of-line characters ("\\n"
+    or "\\r\\n").
+
+    If the stream has read to the end of the file or an error has occurred,
+    a null QStringView is returned; an empty line is returned as an empty,
+    non-null view.
+
+    The returned view stays valid until the next read operation on the
+    stream, or until the stream is destroyed. If the stream operates on a
+    QString, modifying that string also invalidates the view. Convert the
+    view to a QString if the line is needed for longer.
+
+    \sa readLine(), readLineInto()
+*/
+QStringView QTextStream::readLineView(qint64 maxlen)
+{
+    Q_D(QTextStream);
+    CHECK_VALID_STREAM(QStringView());
+
+    d->lineViewBuffer.clear();
+
+    const QChar *readPtr;
+    int length;
+    if (!d->scan(&readPtr, &length, int(maxlen), QTextStreamPrivate::EndOfLine))
+        return QStringView();
+
+    const QStringView line(readPtr, length);
+    // consuming the token may release or compact the read buffer; keep the
+    // characters alive for the caller until the next read operation
+    if (d->device)
+        d->lineViewBuffer = d->readBuffer;
+    d->consumeLastToken();
+    return line;
+}
+
 /*!
     \since 4.1
 
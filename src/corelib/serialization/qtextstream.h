@@ -107,6 +107,7 @@ public:
 
     QString readLine(qint64 maxlen = 0);
     bool readLineInto(QString *line, qint64 maxlen = 0);
+    QStringView readLineView(qint64 maxlen = 0);
     QString readAll();
     QString read(qint64 maxlen);
 
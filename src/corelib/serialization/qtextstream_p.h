@@ -95,6 +95,7 @@ public:
 
     QString writeBuffer;
     QString readBuffer;
+    QString lineViewBuffer; // keeps the data of the last readLineView() alive
     int readBufferOffset;
     int readConverterSavedStateOffset; //the offset between readBufferStartDevicePos and that start of the buffer
     qint64 readBufferStartDevicePos;
@@ -16,8 +16,10 @@
 #include <qcoreapplication.h>
 
 #include <private/qoffsetstringarray_p.h>
+#include <private/qsimd_p.h>
 #include <private/qtools_p.h>
 
+#include <algorithm>
 #include <iterator>
 #include "qxmlstream_p.h"
 #include "qxmlstreamparser_p.h"
@@ -101,6 +103,43 @@ WRAP(contains, QLatin1StringView)
 WRAP(endsWith, char)
 WRAP(indexOf, QLatin1StringView)
 
+/*
+    Returns the length of the run of characters at the start of \a str that
+    the fast scanners can copy verbatim: characters in the range
+    [U+0020, U+D800) other than \a Specials. Anything else (control
+    characters, line breaks, surrogates, non-characters and the markup
+    delimiters) needs the per-character handling of the caller.
+*/
+template <char16_t... Specials>
+qsizetype plainCharRun(QStringView str) noexcept
+{
+    const char16_t *n = str.utf16();
+    const char16_t *const e = n + str.size();
+
+    auto isPlain = [](char16_t c) {
+        return c >= 0x20 && c < 0xd800 && ((c != Specials) && ...);
+    };
+
+#ifdef __SSE2__
+    // Adding 0x8000 - 0x20 maps [0x20, 0xd800) onto the signed range
+    // [SHRT_MIN, SHRT_MIN + 0xd7e0), so a single signed comparison finds
+    // every character outside of it.
+    const __m128i bias = _mm_set1_epi16(short(0x8000 - 0x20));
+    const __m128i limit = _mm_set1_epi16(short(0xd7e0 - 0x8000 - 1));
+    for (const char16_t *next = n + 8; next <= e; n = next, next += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n));
+        __m128i stop = _mm_cmpgt_epi16(_mm_add_epi16(data, bias), limit);
+        ((stop = _mm_or_si128(stop, _mm_cmpeq_epi16(data, _mm_set1_epi16(short(Specials))))), ...);
+        if (const uint mask = uint(_mm_movemask_epi8(stop)))
+            return n + qCountTrailingZeroBits(mask) / 2 - str.utf16();
+    }
+#endif
+
+    while (n < e && isPlain(*n))
+        ++n;
+    return n - str.utf16();
+}
+
 } // unnamed namespace
 
 /*!
@@ -1176,6 +1215,28 @@ bool QXmlStreamReaderPrivate::scanAttType()
     return false;
 }
 
+/*!
+  \internal
+
+  Appends the run of characters following the current read position that
+  need no individual treatment (see plainCharRun()) to the text buffer in
+  one go, and returns its length. Characters put back with putChar() are
+  not considered; the caller handles those one by one.
+ */
+template <char16_t... Specials>
+inline qsizetype QXmlStreamReaderPrivate::fastScanPlainChars()
+{
+    if (!putStack.isEmpty())
+        return 0;
+    const QStringView rest = QStringView(readBuffer).sliced(readBufferPos);
+    const qsizetype n = plainCharRun<Specials...>(rest);
+    if (n) {
+        textBuffer.append(rest.first(n));
+        readBufferPos += n;
+    }
+    return n;
+}
+
 /*!
  \internal
 
@@ -1233,6 +1294,7 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanLiteralContent()
             }
             textBuffer += QChar(ushort(c));
             ++n;
+            n += fastScanPlainChars<u'&', u'<', u'"', u'\''>();
         }
     }
     return n;
@@ -1256,6 +1318,15 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanSpace()
         case '\t':
             textBuffer += QChar(c);
             ++n;
+            if (putStack.isEmpty()) {
+                // copy the rest of an indentation run at once
+                const QStringView rest = QStringView(readBuffer).sliced(readBufferPos);
+                const auto blank = [](QChar ch) { return ch == u' ' || ch == u'\t'; };
+                const qsizetype run = std::find_if_not(rest.begin(), rest.end(), blank) - rest.begin();
+                textBuffer.append(rest.first(run));
+                readBufferPos += run;
+                n += run;
+            }
             break;
         default:
             putChar(c);
@@ -1330,6 +1401,7 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanContentCharList()
             isWhitespace = false;
             textBuffer += QChar(ushort(c));
             ++n;
+            n += fastScanPlainChars<u'&', u'<', u']'>();
         }
     }
     return n;
@@ -507,6 +507,8 @@ public:
 
     // scan optimization functions. Not strictly necessary but LALR is
     // not very well suited for scanning fast
+    template <char16_t... Specials>
+    inline qsizetype fastScanPlainChars();
     qsizetype fastScanLiteralContent();
     qsizetype fastScanSpace();
     qsizetype fastScanContentCharList();
@@ -140,6 +140,14 @@ QCtfTracePointPrivate *_initialize_tracepoint(const QCtfTracePointEvent &point)
     return s_plugin ? s_plugin->initializeTracepoint(point) : nullptr;
 }
 
+// Writes the events kept in memory when QTRACE_FLIGHT_RECORDER is set
+bool _dump_flight_recorder()
+{
+    if (!initialize())
+        return false;
+    return s_plugin ? s_plugin->dumpFlightRecorder() : false;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qctf_p.cpp"
@@ -67,6 +67,7 @@ struct Q_CORE_EXPORT QCtfTracePointEvent
 Q_CORE_EXPORT bool _tracepoint_enabled(const QCtfTracePointEvent &point);
 Q_CORE_EXPORT void _do_tracepoint(const QCtfTracePointEvent &point, const QByteArray &arr);
 Q_CORE_EXPORT QCtfTracePointPrivate *_initialize_tracepoint(const QCtfTracePointEvent &point);
+Q_CORE_EXPORT bool _dump_flight_recorder();
 
 #ifndef BUILD_LIBRARY
 #include <QtCore/qbytearray.h>
@@ -231,6 +232,7 @@ public:
     virtual bool sessionEnabled() = 0;
     virtual QCtfTracePointPrivate *initializeTracepoint(const QCtfTracePointEvent &point) = 0;
     virtual void shutdown(bool *shutdown) = 0;
+    virtual bool dumpFlightRecorder() = 0;
 };
 
 QT_END_NAMESPACE
@@ -382,7 +382,7 @@ void QDBusMetaObjectGenerator::write(QDBusMetaObject *obj)
             - methods.size(); // ditto
 
     QDBusMetaObjectPrivate *header = reinterpret_cast<QDBusMetaObjectPrivate *>(idata.data());
-    static_assert(QMetaObjectPrivate::OutputRevision == 13, "QtDBus meta-object generator should generate the same version as moc");
+    static_assert(QMetaObjectPrivate::OutputRevision == 14, "QtDBus meta-object generator should generate the same version as moc");
     header->revision = QMetaObjectPrivate::OutputRevision;
     header->className = 0;
     header->classInfoCount = 0;
@@ -398,6 +398,7 @@ void QDBusMetaObjectGenerator::write(QDBusMetaObject *obj)
     header->constructorData = 0;
     header->flags = RequiresVariantMetaObject | AllocatedMetaObject;
     header->signalCount = signals_.size();
+    header->lookupData = 0;
     // These are specific to QDBusMetaObject:
     header->propertyDBusData = int(header->propertyData + header->propertyCount
                                    * QMetaObjectPrivate::IntsPerProperty);
@@ -0,0 +1,487 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcompressiondevice_p.h"
+
+#include <limits>
+#include <zlib.h>
+
+#if QT_CONFIG(zstd)
+#    include <zstd.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+// how much compressed data is read from the source, or written to the sink, at a time
+static constexpr qsizetype ChunkSize = 64 * 1024;
+
+/*!
+    \class QDecompressingDevice
+    \internal
+    \inmodule QtNetwork
+    \since 6.9
+
+    \brief The QDecompressingDevice class decompresses data read from another
+    QIODevice.
+
+    QDecompressingDevice is a sequential, read-only device that reads
+    compressed data from its source device in chunks, as its own data is read,
+    and decompresses it with the same engines QNetworkAccessManager uses for
+    HTTP content encodings. Memory use is bounded regardless of how much data
+    passes through it.
+
+    The source device must be open for reading before this device is opened.
+    For non-sequential sources, such as QFile, reading returns -1 once the
+    source is at its end. Sequential sources, such as QTcpSocket or QProcess,
+    are read until they are closed; while no compressed data is available,
+    reading returns 0, and readyRead() is emitted when the source has more.
+*/
+
+/*!
+    Constructs a decompressing device that reads from \a source, with the
+    given \a parent.
+*/
+QDecompressingDevice::QDecompressingDevice(QIODevice *source, QObject *parent)
+    : QIODevice(parent), sourceDevice(source)
+{
+    Q_ASSERT(source);
+    connect(source, &QIODevice::readyRead, this, [this] {
+        if (isOpen())
+            emit readyRead();
+    });
+    connect(source, &QIODevice::readChannelFinished, this, [this] {
+        if (isOpen())
+            emit readChannelFinished();
+    });
+}
+
+/*!
+    Destroys the device. The source device is not closed.
+*/
+QDecompressingDevice::~QDecompressingDevice() = default;
+
+/*!
+    Sets the \a encoding of the data read from the source device, with the
+    names used for HTTP content encodings: "deflate", "gzip" and, if Qt was
+    built with support for them, "br" and "zstd". Returns \c false if the
+    encoding is not supported, or if the device is already open.
+*/
+bool QDecompressingDevice::setEncoding(QByteArrayView encoding)
+{
+    if (isOpen()) {
+        qWarning("QDecompressingDevice::setEncoding: device is already open");
+        return false;
+    }
+    if (!QDecompressHelper::isSupportedEncoding(encoding)) {
+        setErrorString(tr("Unsupported content encoding: %1").arg(QLatin1StringView(encoding)));
+        return false;
+    }
+    this->encoding = encoding.toByteArray();
+    return true;
+}
+
+/*!
+    Makes reading fail once the data decompressed exceeds \a threshold bytes
+    and the compression ratio looks like an archive bomb. This is disabled
+    (-1) by default; enable it for untrusted input.
+
+    \sa QNetworkRequest::setDecompressedSafetyCheckThreshold()
+*/
+void QDecompressingDevice::setDecompressedSafetyCheckThreshold(qint64 threshold)
+{
+    safetyCheckThreshold = threshold;
+}
+
+/*!
+    \reimp
+
+    Only QIODevice::ReadOnly is supported for \a mode.
+*/
+bool QDecompressingDevice::open(OpenMode mode)
+{
+    if (mode & WriteOnly) {
+        qWarning("QDecompressingDevice::open: device is read-only");
+        return false;
+    }
+    if (encoding.isEmpty()) {
+        setErrorString(tr("No content encoding set"));
+        return false;
+    }
+    if (!sourceDevice || !sourceDevice->isReadable()) {
+        setErrorString(tr("Source device is not readable"));
+        return false;
+    }
+
+    decompressHelper.clear();
+    decompressHelper.setEncoding(encoding);
+    decompressHelper.setDecompressedSafetyCheckThreshold(safetyCheckThreshold);
+    return QIODevice::open(mode);
+}
+
+/*!
+    \reimp
+*/
+void QDecompressingDevice::close()
+{
+    QIODevice::close();
+    decompressHelper.clear();
+}
+
+/*!
+    \reimp
+
+    The number of decompressed bytes is not known in advance, so this
+    includes the compressed bytes that are still to be decompressed.
+*/
+qint64 QDecompressingDevice::bytesAvailable() const
+{
+    qint64 available = QIODevice::bytesAvailable();
+    if (decompressHelper.hasData())
+        ++available;
+    if (sourceDevice)
+        available += sourceDevice->bytesAvailable();
+    return available;
+}
+
+bool QDecompressingDevice::sourceAtEnd() const
+{
+    return !sourceDevice || !sourceDevice->isOpen()
+            || (!sourceDevice->isSequential() && sourceDevice->atEnd());
+}
+
+/*!
+    \reimp
+*/
+qint64 QDecompressingDevice::readData(char *data, qint64 maxlen)
+{
+    const qsizetype maxSize = qsizetype(qMin(maxlen, qint64(std::numeric_limits<qsizetype>::max())));
+    for (;;) {
+        if (decompressHelper.hasData()) {
+            const qsizetype read = decompressHelper.read(data, maxSize);
+            if (read < 0)
+                break;
+            if (read > 0)
+                return read;
+        }
+        if (!decompressHelper.isValid())
+            break;
+        if (sourceAtEnd())
+            return -1;
+
+        QByteArray compressed = sourceDevice->read(ChunkSize);
+        if (compressed.isEmpty())
+            return sourceAtEnd() ? -1 : 0;
+        decompressHelper.feed(std::move(compressed));
+    }
+
+    setErrorString(decompressHelper.errorString());
+    return -1;
+}
+
+/*!
+    \reimp
+*/
+qint64 QDecompressingDevice::writeData(const char *data, qint64 len)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    return -1;
+}
+
+/*!
+    \class QCompressingDevice
+    \internal
+    \inmodule QtNetwork
+    \since 6.9
+
+    \brief The QCompressingDevice class compresses data written to it into
+    another QIODevice.
+
+    QCompressingDevice is a sequential, write-only device. Data written to it
+    is compressed incrementally and the compressed output is written to the
+    sink device in chunks, so memory use is bounded. The compressed stream is
+    completed by finish(), or when the device is closed.
+
+    The sink device must be open for writing before this device is opened. It
+    is not closed by QCompressingDevice.
+*/
+
+/*!
+    Constructs a compressing device that writes to \a sink, with the given
+    \a parent.
+*/
+QCompressingDevice::QCompressingDevice(QIODevice *sink, QObject *parent)
+    : QIODevice(parent), sinkDevice(sink)
+{
+    Q_ASSERT(sink);
+}
+
+/*!
+    Destroys the device, completing the compressed stream if it is open.
+*/
+QCompressingDevice::~QCompressingDevice()
+{
+    close();
+}
+
+/*!
+    Returns \c true if \a encoding is supported for compressing: "deflate",
+    "gzip" and, if Qt was built with support for it, "zstd".
+*/
+bool QCompressingDevice::isSupportedEncoding(QByteArrayView encoding)
+{
+    return encoding.compare("deflate", Qt::CaseInsensitive) == 0
+            || encoding.compare("gzip", Qt::CaseInsensitive) == 0
+#if QT_CONFIG(zstd)
+            || encoding.compare("zstd", Qt::CaseInsensitive) == 0
+#endif
+            ;
+}
+
+/*!
+    Sets the \a encoding of the data written to the sink device. Returns
+    \c false if the encoding is not supported, or if the device is already
+    open.
+
+    \sa isSupportedEncoding()
+*/
+bool QCompressingDevice::setEncoding(QByteArrayView encoding)
+{
+    if (isOpen()) {
+        qWarning("QCompressingDevice::setEncoding: device is already open");
+        return false;
+    }
+    if (encoding.compare("deflate", Qt::CaseInsensitive) == 0) {
+        contentEncoding = Deflate;
+    } else if (encoding.compare("gzip", Qt::CaseInsensitive) == 0) {
+        contentEncoding = GZip;
+#if QT_CONFIG(zstd)
+    } else if (encoding.compare("zstd", Qt::CaseInsensitive) == 0) {
+        contentEncoding = Zstandard;
+#endif
+    } else {
+        setErrorString(tr("Unsupported content encoding: %1").arg(QLatin1StringView(encoding)));
+        return false;
+    }
+    return true;
+}
+
+/*!
+    Sets the compression \a level, whose range depends on the encoding. The
+    default, -1, selects the encoding's default level.
+*/
+void QCompressingDevice::setCompressionLevel(int level)
+{
+    compressionLevel = level;
+}
+
+/*!
+    \reimp
+
+    Only QIODevice::WriteOnly is supported for \a mode.
+*/
+bool QCompressingDevice::open(OpenMode mode)
+{
+    if (mode & ReadOnly) {
+        qWarning("QCompressingDevice::open: device is write-only");
+        return false;
+    }
+    if (contentEncoding == None) {
+        setErrorString(tr("No content encoding set"));
+        return false;
+    }
+    if (!sinkDevice || !sinkDevice->isWritable()) {
+        setErrorString(tr("Sink device is not writable"));
+        return false;
+    }
+    if (!initEncoder()) {
+        setErrorString(tr("Failed to initialize the encoder"));
+        return false;
+    }
+    outputBuffer.resize(ChunkSize);
+    return QIODevice::open(mode);
+}
+
+/*!
+    Completes the compressed stream, writes the remaining compressed data to
+    the sink device and closes the device. Returns \c true on success;
+    otherwise returns \c false and errorString() describes the failure.
+
+    \sa close()
+*/
+bool QCompressingDevice::finish()
+{
+    if (!isOpen())
+        return false;
+    const bool finished = compress(nullptr, 0, true);
+    freeEncoder();
+    outputBuffer = QByteArray();
+    QIODevice::close();
+    return finished;
+}
+
+/*!
+    \reimp
+
+    Completes the compressed stream and writes the remaining compressed data
+    to the sink device. A failure is only reported with a warning; call
+    finish() to check whether the stream was completed.
+*/
+void QCompressingDevice::close()
+{
+    if (isOpen() && !finish())
+        qWarning("QCompressingDevice::close: %ls", qUtf16Printable(errorString()));
+}
+
+bool QCompressingDevice::initEncoder()
+{
+    switch (contentEncoding) {
+    case None:
+        Q_UNREACHABLE();
+        break;
+    case Deflate:
+    case GZip: {
+        auto *stream = new z_stream{};
+        // the gzip wrapper is selected by adding 16 to the window bits
+        const int windowBits = contentEncoding == GZip ? MAX_WBITS + 16 : MAX_WBITS;
+        const int level = compressionLevel == -1 ? Z_DEFAULT_COMPRESSION : compressionLevel;
+        if (deflateInit2(stream, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            delete stream;
+            return false;
+        }
+        encoderPointer = stream;
+        break;
+    }
+    case Zstandard: {
+#if QT_CONFIG(zstd)
+        ZSTD_CCtx *context = ZSTD_createCCtx();
+        const int level = compressionLevel == -1 ? ZSTD_CLEVEL_DEFAULT : compressionLevel;
+        if (!context || ZSTD_isError(ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level))) {
+            ZSTD_freeCCtx(context);
+            return false;
+        }
+        encoderPointer = context;
+#else
+        Q_UNREACHABLE();
+#endif
+        break;
+    }
+    }
+    return true;
+}
+
+void QCompressingDevice::freeEncoder()
+{
+    switch (contentEncoding) {
+    case None:
+        break;
+    case Deflate:
+    case GZip:
+        if (auto *stream = static_cast<z_stream *>(encoderPointer)) {
+            deflateEnd(stream);
+            delete stream;
+        }
+        break;
+    case Zstandard:
+#if QT_CONFIG(zstd)
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx *>(encoderPointer));
+#endif
+        break;
+    }
+    encoderPointer = nullptr;
+}
+
+bool QCompressingDevice::writeOutput(qsizetype size)
+{
+    if (size == 0)
+        return true;
+    if (sinkDevice && sinkDevice->write(outputBuffer.constData(), size) == size)
+        return true;
+    setErrorString(tr("Failed to write compressed data: %1")
+                           .arg(sinkDevice ? sinkDevice->errorString() : QString()));
+    return false;
+}
+
+bool QCompressingDevice::compress(const char *data, qint64 len, bool finish)
+{
+    if (!encoderPointer)
+        return false;
+
+    switch (contentEncoding) {
+    case None:
+        Q_UNREACHABLE();
+        break;
+    case Deflate:
+    case GZip: {
+        auto *stream = static_cast<z_stream *>(encoderPointer);
+        do {
+            const uInt chunk = uInt(qMin(len, qint64(std::numeric_limits<uInt>::max())));
+            stream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+            stream->avail_in = chunk;
+            data += chunk;
+            len -= chunk;
+
+            const int flush = finish && len == 0 ? Z_FINISH : Z_NO_FLUSH;
+            int res;
+            do {
+                stream->next_out = reinterpret_cast<Bytef *>(outputBuffer.data());
+                stream->avail_out = uInt(outputBuffer.size());
+                res = deflate(stream, flush);
+                if (res == Z_STREAM_ERROR) {
+                    setErrorString(tr("Failed to compress data"));
+                    return false;
+                }
+                if (!writeOutput(outputBuffer.size() - stream->avail_out))
+                    return false;
+            } while (stream->avail_out == 0 || (flush == Z_FINISH && res != Z_STREAM_END));
+        } while (len > 0);
+        break;
+    }
+    case Zstandard: {
+#if QT_CONFIG(zstd)
+        auto *context = static_cast<ZSTD_CCtx *>(encoderPointer);
+        ZSTD_inBuffer input = { data, size_t(len), 0 };
+        const ZSTD_EndDirective mode = finish ? ZSTD_e_end : ZSTD_e_continue;
+        for (;;) {
+            ZSTD_outBuffer output = { outputBuffer.data(), size_t(outputBuffer.size()), 0 };
+            const size_t remaining = ZSTD_compressStream2(context, &output, &input, mode);
+            if (ZSTD_isError(remaining)) {
+                setErrorString(tr("Failed to compress data: %1")
+                                       .arg(QLatin1StringView(ZSTD_getErrorName(remaining))));
+                return false;
+            }
+            if (!writeOutput(qsizetype(output.pos)))
+                return false;
+            if (finish ? remaining == 0 : input.pos == input.size)
+                break;
+        }
+#else
+        Q_UNREACHABLE();
+#endif
+        break;
+    }
+    }
+    return true;
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressingDevice::readData(char *data, qint64 maxlen)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxlen);
+    return -1;
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressingDevice::writeData(const char *data, qint64 len)
+{
+    return compress(data, len, false) ? len : -1;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qcompressiondevice_p.cpp"
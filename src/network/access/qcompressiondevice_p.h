@@ -0,0 +1,103 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCOMPRESSIONDEVICE_P_H
+#define QCOMPRESSIONDEVICE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include <QtNetwork/private/qdecompresshelper_p.h>
+
+#include <QtCore/qiodevice.h>
+#include <QtCore/qpointer.h>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class Q_NETWORK_EXPORT QDecompressingDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    explicit QDecompressingDevice(QIODevice *source, QObject *parent = nullptr);
+    ~QDecompressingDevice() override;
+
+    bool setEncoding(QByteArrayView encoding);
+    void setDecompressedSafetyCheckThreshold(qint64 threshold);
+
+    QIODevice *source() const { return sourceDevice; }
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    bool sourceAtEnd() const;
+
+    QPointer<QIODevice> sourceDevice;
+    QDecompressHelper decompressHelper;
+    QByteArray encoding;
+    qint64 safetyCheckThreshold = -1;
+};
+
+class Q_NETWORK_EXPORT QCompressingDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    explicit QCompressingDevice(QIODevice *sink, QObject *parent = nullptr);
+    ~QCompressingDevice() override;
+
+    bool setEncoding(QByteArrayView encoding);
+    void setCompressionLevel(int level);
+
+    QIODevice *sink() const { return sinkDevice; }
+
+    static bool isSupportedEncoding(QByteArrayView encoding);
+
+    bool open(OpenMode mode) override;
+    bool finish();
+    void close() override;
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    enum Encoding {
+        None,
+        Deflate,
+        GZip,
+        Zstandard,
+    };
+
+    bool initEncoder();
+    void freeEncoder();
+    bool compress(const char *data, qint64 len, bool finish);
+    bool writeOutput(qsizetype size);
+
+    QPointer<QIODevice> sinkDevice;
+    Encoding contentEncoding = None;
+    int compressionLevel = -1;
+    void *encoderPointer = nullptr;
+    QByteArray outputBuffer;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCOMPRESSIONDEVICE_P_H
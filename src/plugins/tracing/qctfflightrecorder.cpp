@@ -0,0 +1,371 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qctfflightrecorder_p.h"
+
+#include <qfile.h>
+#include <qplatformdefs.h>
+
+#include <string.h>
+
+#include <thread>
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+#ifdef QT_OPEN_BINARY
+static constexpr int openBinary = QT_OPEN_BINARY;
+#else
+static constexpr int openBinary = 0;
+#endif
+
+static std::atomic<QCtfFlightRecorder *> s_recorder = nullptr;
+// the signal handlers that may still use the recorder they loaded
+static std::atomic<int> s_runningHandlers = 0;
+
+#ifdef Q_OS_UNIX
+static const int crashSignals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+static constexpr int crashSignalCount = int(std::size(crashSignals));
+static struct sigaction s_previousActions[crashSignalCount + 1];
+static int s_dumpSignal = 0;
+
+// Gives the calling thread a stack of its own to run the signal handlers on,
+// unless it has one already, so that its events can also be dumped when it
+// overflows its stack. dumpRing() alone needs more than 8 KiB.
+static void installSignalStack()
+{
+    static thread_local struct SignalStack
+    {
+        SignalStack()
+        {
+            stack_t current;
+            if (sigaltstack(nullptr, &current) != 0 || !(current.ss_flags & SS_DISABLE))
+                return;
+            const size_t size = qMax(size_t(SIGSTKSZ), size_t(64 * 1024));
+            memory.reset(new char[size]);
+            stack_t stack = {};
+            stack.ss_sp = memory.get();
+            stack.ss_size = size;
+            if (sigaltstack(&stack, nullptr) != 0)
+                memory.reset();
+        }
+        ~SignalStack()
+        {
+            if (!memory)
+                return;
+            stack_t stack = {};
+            stack.ss_flags = SS_DISABLE;
+            sigaltstack(&stack, nullptr);
+        }
+        std::unique_ptr<char[]> memory;
+    } signalStack;
+}
+#endif
+
+template <typename T>
+static char *writeValue(char *at, T value) noexcept
+{
+    memcpy(at, &value, sizeof(value));
+    return at + sizeof(value);
+}
+
+// Returns the end of the decimal representation of value written at buffer
+static char *writeNumber(char *buffer, quint32 value) noexcept
+{
+    char digits[10];
+    int count = 0;
+    do {
+        digits[count++] = char('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (count)
+        *buffer++ = digits[--count];
+    return buffer;
+}
+
+QCtfFlightRecorder::QCtfFlightRecorder(const QString &location, quint64 window,
+                                       QElapsedTimer timer, QUuid traceUuid,
+                                       quint32 headerMagic)
+    : m_location(QFile::encodeName(location)),
+      m_window(window),
+      m_timer(timer),
+      m_traceUuid(traceUuid),
+      m_headerMagic(headerMagic)
+{
+}
+
+QCtfFlightRecorder::~QCtfFlightRecorder()
+{
+#ifdef Q_OS_UNIX
+    if (s_recorder.load(std::memory_order_relaxed) == this) {
+        for (int i = 0; i < crashSignalCount; ++i)
+            sigaction(crashSignals[i], &s_previousActions[i], nullptr);
+        if (s_dumpSignal)
+            sigaction(s_dumpSignal, &s_previousActions[crashSignalCount], nullptr);
+        s_dumpSignal = 0;
+    }
+#endif
+    // wait for the signal handlers of the other threads that got this
+    // recorder, then for a dump requested some other way
+    s_recorder.store(nullptr, std::memory_order_seq_cst);
+    while (s_runningHandlers.load(std::memory_order_seq_cst))
+        std::this_thread::yield();
+    bool dumping = false;
+    while (!m_dumping.compare_exchange_weak(dumping, true, std::memory_order_acquire))
+        dumping = false;
+
+    for (int i = 0; i < m_ringCount.load(std::memory_order_relaxed); ++i)
+        delete m_rings[i].load(std::memory_order_relaxed);
+}
+
+/*!
+    \internal
+    Returns the ring to record the events of the current thread in, or
+    \nullptr if there are too many threads. Also gives the thread an
+    alternate signal stack.
+
+    The ring of a thread that exited is reused once its events are older than
+    the window kept by the recorder, or when there are MaxRings rings. Must be
+    called with the lock of the trace library held.
+*/
+QCtfFlightRecorder::Ring *QCtfFlightRecorder::attachThread(quint32 threadIndex,
+                                                           QByteArrayView threadName)
+{
+#ifdef Q_OS_UNIX
+    installSignalStack();
+#endif
+
+    const quint64 now = quint64(m_timer.nsecsElapsed());
+    auto setup = [&](Ring *ring) {
+        const qsizetype nameLength = qMin(threadName.size(), MaxThreadNameLength);
+        memcpy(ring->threadName, threadName.data(), nameLength);
+        ring->threadName[nameLength] = 0;
+        ring->threadNameLength = quint32(nameLength + 1);
+        ring->capacity = quint32(sizeof(Packet::data) - ring->threadNameLength);
+        ring->threadIndex = threadIndex;
+        ring->current = nullptr;
+        ring->lastTimestamp.store(now, std::memory_order_relaxed);
+        ring->attached.store(true, std::memory_order_relaxed);
+    };
+
+    const int count = m_ringCount.load(std::memory_order_relaxed);
+
+    // don't change a ring while it's being dumped
+    if (!m_dumping.exchange(true, std::memory_order_acquire)) {
+        // the ring of the thread that exited first
+        Ring *ring = nullptr;
+        for (int i = 0; i < count; ++i) {
+            Ring *candidate = m_rings[i].load(std::memory_order_relaxed);
+            if (!candidate->attached.load(std::memory_order_relaxed)
+                    && (!ring || candidate->lastTimestamp.load(std::memory_order_relaxed)
+                                 < ring->lastTimestamp.load(std::memory_order_relaxed))) {
+                ring = candidate;
+            }
+        }
+        // keep its events if possible
+        if (ring && count < MaxRings
+                && ring->lastTimestamp.load(std::memory_order_relaxed) + m_window >= now) {
+            ring = nullptr;
+        }
+        if (ring) {
+            for (int i = 0; i < PacketCount; ++i)
+                ring->packets[i].sequence.store(0, std::memory_order_relaxed);
+            setup(ring);
+        }
+        m_dumping.store(false, std::memory_order_release);
+        if (ring)
+            return ring;
+    }
+
+    if (count == MaxRings)
+        return nullptr;
+    Ring *ring = new Ring;
+    setup(ring);
+    m_rings[count].store(ring, std::memory_order_relaxed);
+    m_ringCount.store(count + 1, std::memory_order_release);
+    return ring;
+}
+
+void QCtfFlightRecorder::detachThread(Ring *ring)
+{
+    ring->attached.store(false, std::memory_order_relaxed);
+}
+
+/*!
+    \internal
+    Adds an event to \a ring, overwriting the oldest packet of the ring if
+    needed. Only called by the thread the ring is attached to.
+*/
+void QCtfFlightRecorder::append(Ring *ring, quint32 eventId, quint64 timestamp,
+                                QByteArrayView payload) noexcept
+{
+    const quint32 eventSize = quint32(sizeof(eventId) + sizeof(timestamp) + payload.size());
+    if (eventSize > ring->capacity)
+        return;
+
+    Packet *packet = ring->current;
+    quint32 size = packet ? packet->size.load(std::memory_order_relaxed) : 0;
+    if (!packet || size + eventSize > ring->capacity) {
+        const quint64 sequence = ++ring->sequence;
+        packet = &ring->packets[sequence % PacketCount];
+        packet->size.store(0, std::memory_order_relaxed);
+        packet->sequence.store(sequence, std::memory_order_release);
+        // the readers that see the new contents must see the new sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        packet->minTimestamp.store(timestamp, std::memory_order_relaxed);
+        ring->current = packet;
+        size = 0;
+    }
+
+    char *at = packet->data + size;
+    at = writeValue(at, eventId);
+    at = writeValue(at, timestamp);
+    memcpy(at, payload.data(), payload.size());
+    packet->maxTimestamp.store(timestamp, std::memory_order_relaxed);
+    packet->size.store(size + eventSize, std::memory_order_release);
+    ring->lastTimestamp.store(timestamp, std::memory_order_relaxed);
+}
+
+/*!
+    \internal
+    Writes the packets of the last window of each thread to a channel file
+    in the trace location, replacing those of the previous dump. The metadata
+    is written there by the trace library as the tracepoints get used.
+
+    Only uses async-signal-safe functions. Returns \c false if another dump
+    is in progress or a channel file couldn't be written.
+*/
+bool QCtfFlightRecorder::dump() noexcept
+{
+    if (m_dumping.exchange(true, std::memory_order_acquire))
+        return false;
+
+    const quint64 now = quint64(m_timer.nsecsElapsed());
+    const quint64 oldest = now > m_window ? now - m_window : 0;
+    bool result = true;
+    const int count = m_ringCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i)
+        result &= dumpRing(*m_rings[i].load(std::memory_order_relaxed), i, oldest);
+
+    m_dumping.store(false, std::memory_order_release);
+    return result;
+}
+
+bool QCtfFlightRecorder::dumpRing(const Ring &ring, int index, quint64 oldest) noexcept
+{
+    constexpr QByteArrayView channelPrefix = "/channel_";
+    char path[4096];
+    if (size_t(m_location.size() + channelPrefix.size()) + 11 > sizeof(path))
+        return false;
+    char *end = path;
+    memcpy(end, m_location.constData(), m_location.size());
+    end += m_location.size();
+    memcpy(end, channelPrefix.data(), channelPrefix.size());
+    end += channelPrefix.size();
+    *writeNumber(end, quint32(index)) = 0;
+
+    const int fd = QT_OPEN(path, QT_OPEN_WRONLY | QT_OPEN_CREAT | QT_OPEN_TRUNC | openBinary, 0666);
+    if (fd == -1)
+        return false;
+
+    // the packet being written has the highest sequence
+    quint64 last = 0;
+    for (int i = 0; i < PacketCount; ++i)
+        last = qMax(last, ring.packets[i].sequence.load(std::memory_order_relaxed));
+    const quint64 first = last > PacketCount ? last - PacketCount + 1 : 1;
+
+    bool result = true;
+    char buffer[PacketSize];
+    const QUuid::Id128Bytes uuid = m_traceUuid.toBytes();
+    for (quint64 sequence = first; sequence <= last && result; ++sequence) {
+        const Packet &packet = ring.packets[sequence % PacketCount];
+        if (packet.sequence.load(std::memory_order_acquire) != sequence)
+            continue;
+        const quint32 size = qMin(packet.size.load(std::memory_order_acquire), ring.capacity);
+        const quint64 minTimestamp = packet.minTimestamp.load(std::memory_order_relaxed);
+        const quint64 maxTimestamp = packet.maxTimestamp.load(std::memory_order_relaxed);
+        char *data = buffer + PacketHeaderSize + ring.threadNameLength;
+        memcpy(data, packet.data, size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (packet.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;   // overwritten while copying it
+        if (!size || maxTimestamp < oldest)
+            continue;
+
+        // the packet header and context, as defined in metadata_template.txt
+        char *at = writeValue(buffer, m_headerMagic);
+        memcpy(at, uuid.data, sizeof(uuid.data));
+        at += sizeof(uuid.data);
+        at = writeValue(at, quint32(0));
+        at = writeValue(at, minTimestamp);
+        at = writeValue(at, maxTimestamp);
+        at = writeValue(at, quint64(PacketHeaderSize + ring.threadNameLength + size) * 8u);
+        at = writeValue(at, quint64(PacketSize) * 8u);
+        at = writeValue(at, sequence);
+        at = writeValue(at, quint64(0));
+        at = writeValue(at, ring.threadIndex);
+        memcpy(at, ring.threadName, ring.threadNameLength);
+        Q_ASSERT(at + ring.threadNameLength == data);
+        memset(data + size, 0, buffer + PacketSize - data - size);
+
+        result = QT_WRITE(fd, buffer, PacketSize) == qint64(PacketSize);
+    }
+    QT_CLOSE(fd);
+    return result;
+}
+
+void QCtfFlightRecorder::signalHandler(int signum)
+{
+#ifdef Q_OS_UNIX
+    s_runningHandlers.fetch_add(1, std::memory_order_seq_cst);
+    if (QCtfFlightRecorder *recorder = s_recorder.load(std::memory_order_seq_cst))
+        recorder->dump();
+    s_runningHandlers.fetch_sub(1, std::memory_order_release);
+    if (signum == s_dumpSignal)
+        return;
+
+    // let the previous handler deal with the crash
+    for (int i = 0; i < crashSignalCount; ++i) {
+        if (crashSignals[i] == signum)
+            sigaction(signum, &s_previousActions[i], nullptr);
+    }
+    raise(signum);
+#else
+    Q_UNUSED(signum);
+#endif
+}
+
+/*!
+    \internal
+    Dumps the events when the process crashes, and when it receives
+    \a dumpSignal if it isn't 0.
+*/
+void QCtfFlightRecorder::installSignalHandlers(int dumpSignal)
+{
+#ifdef Q_OS_UNIX
+    QCtfFlightRecorder *expected = nullptr;
+    if (!s_recorder.compare_exchange_strong(expected, this, std::memory_order_release))
+        return;
+
+    // on the stacks of installSignalStack(), if the thread has one
+    struct sigaction action = {};
+    action.sa_handler = signalHandler;
+    action.sa_flags = SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (int i = 0; i < crashSignalCount; ++i)
+        sigaction(crashSignals[i], &action, &s_previousActions[i]);
+    if (dumpSignal > 0) {
+        action.sa_flags |= SA_RESTART;
+        s_dumpSignal = dumpSignal;
+        sigaction(dumpSignal, &action, &s_previousActions[crashSignalCount]);
+    }
+#else
+    Q_UNUSED(dumpSignal);
+    s_recorder.store(this, std::memory_order_release);
+#endif
+}
+
+QT_END_NAMESPACE
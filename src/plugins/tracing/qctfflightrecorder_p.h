@@ -0,0 +1,94 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef Q_CTFFLIGHTRECORDER_P_H
+#define Q_CTFFLIGHTRECORDER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+//
+
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qelapsedtimer.h>
+#include <quuid.h>
+
+#include <atomic>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+// Keeps the last events of each thread in memory, in a ring of CTF packets
+// that only that thread writes to, and writes them to the trace location
+// when dump() is called. Dumping doesn't take locks or allocate memory, so it
+// can be done from a signal handler.
+class QCtfFlightRecorder
+{
+public:
+    static constexpr size_t PacketSize = 4096;
+    static constexpr size_t PacketHeaderSize = 24 + 6 * 8 + 4;
+    static constexpr qsizetype MaxThreadNameLength = 63;
+    static constexpr int PacketCount = 256;     // 1 MiB per thread
+    static constexpr int MaxRings = 256;
+
+    struct Packet
+    {
+        // 0 when unused, incremented for each packet written by the thread.
+        // Readers check that it didn't change while they copied the packet.
+        std::atomic<quint64> sequence = 0;
+        std::atomic<quint32> size = 0;
+        std::atomic<quint64> minTimestamp = 0;
+        std::atomic<quint64> maxTimestamp = 0;
+        char data[PacketSize - PacketHeaderSize];
+    };
+
+    struct Ring
+    {
+        std::unique_ptr<Packet[]> packets { new Packet[PacketCount] };
+        Packet *current = nullptr;
+        quint64 sequence = 0;
+        quint32 capacity = 0;       // of the packets, after the thread name
+        quint32 threadIndex = 0;
+        char threadName[MaxThreadNameLength + 1] = {};
+        quint32 threadNameLength = 0;   // including the terminating null
+        bool writing = false;
+        std::atomic<bool> attached = false;
+        std::atomic<quint64> lastTimestamp = 0;
+    };
+
+    QCtfFlightRecorder(const QString &location, quint64 window, QElapsedTimer timer,
+                       QUuid traceUuid, quint32 headerMagic);
+    ~QCtfFlightRecorder();
+
+    Ring *attachThread(quint32 threadIndex, QByteArrayView threadName);
+    void detachThread(Ring *ring);
+    void append(Ring *ring, quint32 eventId, quint64 timestamp, QByteArrayView payload) noexcept;
+
+    bool dump() noexcept;
+    void installSignalHandlers(int dumpSignal);
+
+private:
+    bool dumpRing(const Ring &ring, int index, quint64 oldest) noexcept;
+    static void signalHandler(int signum);
+
+    QByteArray m_location;
+    quint64 m_window;
+    QElapsedTimer m_timer;
+    QUuid m_traceUuid;
+    quint32 m_headerMagic;
+    std::atomic<Ring *> m_rings[MaxRings] = {};
+    std::atomic<int> m_ringCount = 0;
+    std::atomic<bool> m_dumping = false;
+};
+
+QT_END_NAMESPACE
+
+#endif
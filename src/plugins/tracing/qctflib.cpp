@@ -25,8 +25,8 @@ using namespace Qt::StringLiterals;
 
 Q_LOGGING_CATEGORY(lcDebugTrace, "qt.core.ctf", QtWarningMsg)
 
-static const size_t packetHeaderSize = 24 + 6 * 8 + 4;
-static const size_t packetSize = 4096;
+static const size_t packetHeaderSize = QCtfFlightRecorder::PacketHeaderSize;
+static const size_t packetSize = QCtfFlightRecorder::PacketSize;
 
 static const char traceMetadataTemplate[] =
 #include "metadata_template.h"
@@ -181,6 +181,23 @@ QCtfLibImpl::QCtfLibImpl()
     m_timer.start();
     if (!m_streaming)
         buildMetadata();
+
+    // Keep the last events in memory instead, and write them on request
+    if (qEnvironmentVariableIsSet("QTRACE_FLIGHT_RECORDER")) {
+        if (m_streaming) {
+            qCWarning(lcDebugTrace) << "The flight recorder can't stream the trace";
+            return;
+        }
+        bool ok = false;
+        int seconds = qEnvironmentVariableIntValue("QTRACE_FLIGHT_RECORDER", &ok);
+        if (!ok || seconds <= 0)
+            seconds = 10;
+        m_flightRecorder = std::make_unique<QCtfFlightRecorder>(
+                m_location, quint64(seconds) * 1000000000u, m_timer, s_TraceUuid,
+                s_CtfHeaderMagic);
+        m_flightRecorder->installSignalHandlers(
+                qEnvironmentVariableIntValue("QTRACE_FLIGHT_RECORDER_SIGNAL"));
+    }
 }
 
 void QCtfLibImpl::clearLocation()
@@ -271,7 +288,10 @@ void QCtfLibImpl::writeCtfPacket(QCtfLibImpl::Channel &ch)
 
 QCtfLibImpl::Channel::~Channel()
 {
-    impl->writeCtfPacket(*this);
+    if (!impl->m_flightRecorder)
+        impl->writeCtfPacket(*this);
+    else if (ring)
+        impl->m_flightRecorder->detachThread(ring);
     impl->removeChannel(this);
 }
 
@@ -357,10 +377,9 @@ void QCtfLibImpl::doTracepoint(const QCtfTracePointEvent &point, const QByteArra
     QThread *thread = nullptr;
     if (m_streaming && m_serverClosed)
         return;
-    {
+    if (!priv->metadataWritten.load(std::memory_order_acquire)) {
         QMutexLocker lock(&m_mutex);
-        if (!priv->metadataWritten) {
-            priv->metadataWritten = true;
+        if (!priv->metadataWritten.load(std::memory_order_relaxed)) {
             auto providerMetadata = point.provider.metadata;
             while (providerMetadata) {
                 registerMetadata(*providerMetadata);
@@ -372,9 +391,10 @@ void QCtfLibImpl::doTracepoint(const QCtfTracePointEvent &point, const QByteArra
                 m_newAdditionalMetadata.clear();
             }
             writeMetadata(priv->metadata);
+            priv->metadataWritten.store(true, std::memory_order_release);
         }
-        timestamp = m_timer.nsecsElapsed();
     }
+    timestamp = m_timer.nsecsElapsed();
     if (arr.size() != point.size) {
         if (arr.size() < point.size)
             return;
@@ -389,6 +409,7 @@ void QCtfLibImpl::doTracepoint(const QCtfTracePointEvent &point, const QByteArra
     Channel &ch = m_threadData.localData();
 
     if (ch.channelName[0] == 0) {
+        QMutexLocker lock(&m_mutex);
         ch.impl = this;
         m_channels.append(&ch);
         m_threadIndices.insert(thread, m_threadIndices.size());
@@ -402,6 +423,15 @@ void QCtfLibImpl::doTracepoint(const QCtfTracePointEvent &point, const QByteArra
             ch.threadName = QByteArray(obj->className());
         }
         ch.threadNameLength = ch.threadName.size() + 1;
+        if (m_flightRecorder)
+            ch.ring = m_flightRecorder->attachThread(ch.threadIndex, ch.threadName);
+    }
+    if (m_flightRecorder) {
+        if (ch.ring) {
+            m_flightRecorder->append(ch.ring, priv->id, timestamp,
+                                     point.metadata.isEmpty() ? QByteArrayView() : QByteArrayView(arr));
+        }
+        return;
     }
     if (ch.locked)
         return;
@@ -425,6 +455,11 @@ void QCtfLibImpl::doTracepoint(const QCtfTracePointEvent &point, const QByteArra
     ch.maxTimestamp = timestamp;
 }
 
+bool QCtfLibImpl::dumpFlightRecorder()
+{
+    return m_flightRecorder && m_flightRecorder->dump();
+}
+
 bool QCtfLibImpl::sessionEnabled()
 {
     return !m_session.name.isEmpty();
@@ -27,6 +27,10 @@
 #include <qthread.h>
 #include <qloggingcategory.h>
 #include "qctfserver_p.h"
+#include "qctfflightrecorder_p.h"
+
+#include <atomic>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -37,7 +41,7 @@ struct QCtfTracePointPrivate
     QString metadata;
     quint32 id = 0;
     quint32 payloadSize = 0;
-    bool metadataWritten = false;
+    std::atomic<bool> metadataWritten = false;
 };
 
 class QCtfLibImpl : public QCtfLib, public QCtfServer::ServerCallback
@@ -61,6 +65,7 @@ class QCtfLibImpl : public QCtfLib, public QCtfServer::ServerCallback
         quint32 threadNameLength = 0;
         bool locked = false;
         QCtfLibImpl *impl = nullptr;
+        QCtfFlightRecorder::Ring *ring = nullptr;
         Channel()
         {
             memset(channelName, 0, sizeof(channelName));
@@ -83,6 +88,7 @@ public:
     {
 
     }
+    bool dumpFlightRecorder() override;
 
     static QCtfLib *instance();
     static void cleanup();
@@ -117,6 +123,7 @@ private:
     std::atomic_bool m_sessionChanged = false;
     std::atomic_bool m_serverClosed = false;
     QScopedPointer<QCtfServer> m_server;
+    std::unique_ptr<QCtfFlightRecorder> m_flightRecorder;
     friend struct Channel;
 };
 
@@ -53,6 +53,12 @@ public:
             return nullptr;
         return QCtfLibImpl::instance()->initializeTracepoint(point);
     }
+    bool dumpFlightRecorder() override
+    {
+        if (m_cleanup)
+            return false;
+        return QCtfLibImpl::instance()->dumpFlightRecorder();
+    }
 private:
     bool m_cleanup = false;
     bool *m_shutdown = nullptr;
@@ -0,0 +1,83 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+
+#include <private/qbinarylog_p.h>
+
+#include <stdio.h>
+
+QT_USE_NAMESPACE
+
+static const char *typeName(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return "debug";
+    case QtInfoMsg: return "info";
+    case QtWarningMsg: return "warning";
+    case QtCriticalMsg: return "critical";
+    case QtFatalMsg: return "fatal";
+    }
+    return "unknown";
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QLatin1StringView(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+            "Prints the messages of a binary log written by a Qt application that was "
+            "run with QT_LOGGING_BINARY set."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption timestamps(QStringLiteral("timestamps"),
+                                  QStringLiteral("Print the time of each message instead of the "
+                                                 "seconds elapsed since the log was opened."));
+    parser.addOption(timestamps);
+    QCommandLineOption threads(QStringLiteral("thread"),
+                               QStringLiteral("Print the thread that logged each message."));
+    parser.addOption(threads);
+    parser.addPositionalArgument(QStringLiteral("file"), QStringLiteral("The binary log."));
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 1)
+        parser.showHelp(EXIT_FAILURE);
+
+    QFile file(arguments.first());
+    if (!file.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "qlogdecode: cannot open %s: %s\n", qPrintable(file.fileName()),
+                qPrintable(file.errorString()));
+        return EXIT_FAILURE;
+    }
+    const uchar *data = file.map(0, file.size());
+    const QByteArray contents = data ? QByteArray() : file.readAll();
+    QBinaryLogReader reader(data ? QByteArrayView(data, file.size()) : QByteArrayView(contents));
+    if (!reader.isValid()) {
+        fprintf(stderr, "qlogdecode: %s is not a binary log\n", qPrintable(file.fileName()));
+        return EXIT_FAILURE;
+    }
+
+    const bool printTimestamps = parser.isSet(timestamps);
+    const bool printThreads = parser.isSet(threads);
+    QBinaryLogReader::Message message;
+    while (reader.readNext(&message)) {
+        if (printTimestamps) {
+            const QDateTime time = QDateTime::fromMSecsSinceEpoch(
+                    reader.startTime() + message.timestamp / 1000000);
+            printf("[%s] ", qPrintable(time.toString(Qt::ISODateWithMs)));
+        } else {
+            printf("[%12.6f] ", message.timestamp / 1e9);
+        }
+        if (printThreads)
+            printf("%llu ", message.threadId);
+        printf("%s %s: %s\n", typeName(message.type), message.category.constData(),
+               message.text.toLocal8Bit().constData());
+    }
+    return EXIT_SUCCESS;
+}
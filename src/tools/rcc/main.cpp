@@ -163,6 +163,12 @@ int runRcc(int argc, char *argv[])
     QCommandLineOption thresholdOption(QStringLiteral("threshold"), QStringLiteral("Threshold to consider compressing files."), QStringLiteral("level"));
     parser.addOption(thresholdOption);
 
+    QCommandLineOption chunkSizeOption(QStringLiteral("compress-chunk-size"), QStringLiteral("Compress files larger than <bytes> in chunks of that size, which can be decompressed separately."), QStringLiteral("bytes"));
+    parser.addOption(chunkSizeOption);
+
+    QCommandLineOption alignOption(QStringLiteral("align-data"), QStringLiteral("Align uncompressed files of at least <bytes> bytes to a multiple of <bytes>, a power of two."), QStringLiteral("bytes"));
+    parser.addOption(alignOption);
+
     QCommandLineOption binaryOption(QStringLiteral("binary"), QStringLiteral("Output a binary file for use as a dynamic resource."));
     parser.addOption(binaryOption);
 
@@ -243,6 +249,24 @@ int runRcc(int argc, char *argv[])
     }
     if (parser.isSet(thresholdOption))
         library.setCompressThreshold(parser.value(thresholdOption).toInt());
+    if (parser.isSet(chunkSizeOption)) {
+        bool ok = false;
+        const int chunkSize = parser.value(chunkSizeOption).toInt(&ok);
+        if (!ok || chunkSize <= 0)
+            errorMsg = "Invalid compression chunk size: "_L1 + parser.value(chunkSizeOption);
+        else if (formatVersion < 3)
+            errorMsg = "Chunked compression requires format version 3 or higher"_L1;
+        else
+            library.setCompressChunkSize(chunkSize);
+    }
+    if (parser.isSet(alignOption)) {
+        bool ok = false;
+        const int alignment = parser.value(alignOption).toInt(&ok);
+        if (!ok || alignment <= 0 || (alignment & (alignment - 1)))
+            errorMsg = "Invalid data alignment: "_L1 + parser.value(alignOption);
+        else
+            library.setDataAlignment(alignment);
+    }
     if (parser.isSet(binaryOption))
         library.setFormat(RCCResourceLibrary::Binary);
     if (parser.isSet(generatorOption)) {
@@ -11,6 +11,7 @@
 #include <qdebug.h>
 #include <qdir.h>
 #include <qdirlisting.h>
+#include <qendian.h>
 #include <qfile.h>
 #include <qiodevice.h>
 #include <qlocale.h>
@@ -74,7 +75,8 @@ public:
         NoFlags = 0x00,
         Compressed = 0x01,
         Directory = 0x02,
-        CompressedZstd = 0x04
+        CompressedZstd = 0x04,
+        CompressedChunks = 0x08
     };
 
 
@@ -244,6 +246,29 @@ void RCCFileInfo::writeDataInfo(RCCResourceLibrary &lib)
     }
 }
 
+// Compresses \a data in independent chunks of \a chunkSize bytes, so that
+// QResource can decompress only the chunks that are read. Like the output of
+// qCompress(), the result starts with the uncompressed size; it continues with
+// the chunk size and the end offset of each compressed chunk.
+template <typename Compressor>
+static QByteArray compressChunks(const QByteArray &data, qsizetype chunkSize, Compressor compress)
+{
+    const qsizetype chunkCount = (data.size() + chunkSize - 1) / chunkSize;
+    const qsizetype headerSize = 8 + 4 * chunkCount;
+    QByteArray result(headerSize, Qt::Uninitialized);
+    qToBigEndian<quint32>(data.size(), result.data());
+    qToBigEndian<quint32>(chunkSize, result.data() + 4);
+    for (qsizetype i = 0; i < chunkCount; ++i) {
+        const QByteArray chunk = compress(QByteArrayView(data).sliced(i * chunkSize).first(
+                qMin(chunkSize, data.size() - i * chunkSize)));
+        if (chunk.isEmpty())
+            return QByteArray();
+        result += chunk;
+        qToBigEndian<quint32>(result.size() - headerSize, result.data() + 8 + 4 * i);
+    }
+    return result;
+}
+
 qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
                                   qint64 offset,
                                   DeduplicationMultiHash &dedupByContent,
@@ -296,6 +321,8 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
 
     // Check if compression is useful for this file
     if (data.size() != 0) {
+        const bool chunked = lib.m_compressChunkSize > 0 && data.size() > lib.m_compressChunkSize;
+        QByteArray chunks;
 #if QT_CONFIG(zstd)
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Best && !m_noZstd) {
             m_compressAlgo = RCCResourceLibrary::CompressionAlgorithm::Zstd;
@@ -320,9 +347,21 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
                 // compressing is worth it
                 if (m_compressLevel < 0) {
                     // heuristic compression, so recompress
+                    compressLevel = CONSTANT_ZSTDCOMPRESSLEVEL_STORE;
                     n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
                                           data.constData(), data.size(),
-                                          CONSTANT_ZSTDCOMPRESSLEVEL_STORE);
+                                          compressLevel);
+                }
+                if (chunked && !ZSTD_isError(n)) {
+                    chunks = compressChunks(data, lib.m_compressChunkSize,
+                                            [&](QByteArrayView chunk) {
+                        QByteArray out(ZSTD_COMPRESSBOUND(chunk.size()), Qt::Uninitialized);
+                        const size_t outSize = ZSTD_compressCCtx(lib.m_zstdCCtx, out.data(),
+                                                                 out.size(), chunk.data(),
+                                                                 chunk.size(), compressLevel);
+                        out.truncate(ZSTD_isError(outSize) ? 0 : outSize);
+                        return out;
+                    });
                 }
                 if (ZSTD_isError(n)) {
                     QString msg = "%1: error: compression with zstd failed: %2\n"_L1
@@ -336,8 +375,14 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
 
                 lib.m_overallFlags |= CompressedZstd;
                 m_flags |= CompressedZstd;
-                data = std::move(compressed);
-                data.truncate(n);
+                if (!chunks.isNull()) {
+                    lib.m_overallFlags |= CompressedChunks;
+                    m_flags |= CompressedChunks;
+                    data = std::move(chunks);
+                } else {
+                    data = std::move(compressed);
+                    data.truncate(n);
+                }
             } else if (lib.verbose()) {
                 QString msg = QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
                 lib.m_errorDevice->write(msg.toUtf8());
@@ -352,6 +397,16 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zlib) {
             QByteArray compressed =
                     qCompress(reinterpret_cast<uchar *>(data.data()), data.size(), m_compressLevel);
+            if (chunked) {
+                // qCompress() prefixes each stream with its size, which the chunk header has
+                chunks = compressChunks(data, lib.m_compressChunkSize,
+                                        [this](QByteArrayView chunk) {
+                    return qCompress(reinterpret_cast<const uchar *>(chunk.data()), chunk.size(),
+                                     m_compressLevel).sliced(4);
+                });
+                if (!chunks.isNull())
+                    compressed = chunks;
+            }
 
             int compressRatio = int(100.0 * (data.size() - compressed.size()) / data.size());
             if (compressRatio >= m_compressThreshold) {
@@ -363,12 +418,42 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib,
                 data = compressed;
                 lib.m_overallFlags |= Compressed;
                 m_flags |= Compressed;
+                if (!chunks.isNull()) {
+                    lib.m_overallFlags |= CompressedChunks;
+                    m_flags |= CompressedChunks;
+                }
             } else if (lib.verbose()) {
                 QString msg = QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
                 lib.m_errorDevice->write(msg.toUtf8());
             }
         }
 #endif // QT_NO_COMPRESS
+        if ((m_flags & CompressedChunks) && lib.verbose()) {
+            QString msg = QString::fromLatin1("%1: note: compressed in chunks of %2 bytes\n")
+                    .arg(m_name).arg(lib.m_compressChunkSize);
+            lib.m_errorDevice->write(msg.toUtf8());
+        }
+    }
+
+    // Align the payload of big uncompressed files, so that it can be used in
+    // place by mapping the file, without sharing its first and last pages
+    if (lib.m_dataAlignment > 0 && (text || binary) && !(m_flags & (Compressed | CompressedZstd))
+            && data.size() >= lib.m_dataAlignment) {
+        const qint64 base = binary ? lib.m_dataOffset : 0;
+        const qint64 padding = -(base + offset + 4) & (lib.m_dataAlignment - 1);
+        if (binary) {
+            lib.writeByteArray(QByteArray(padding, '\0'));
+        } else {
+            for (qint64 i = 0; i < padding; ++i) {
+                lib.writeHex(0);
+                if (i % 16 == 15)
+                    lib.writeString("\n  ");
+            }
+            if (padding)
+                lib.writeString("\n  ");
+        }
+        offset += padding;
+        m_dataOffset = offset;
     }
 
     // some info
@@ -494,6 +579,8 @@ RCCResourceLibrary::RCCResourceLibrary(quint8 formatVersion)
     m_compressionAlgo(CompressionAlgorithm::Best),
     m_compressLevel(CONSTANT_COMPRESSLEVEL_DEFAULT),
     m_compressThreshold(CONSTANT_COMPRESSTHRESHOLD_DEFAULT),
+    m_compressChunkSize(0),
+    m_dataAlignment(0),
     m_treeOffset(0),
     m_namesOffset(0),
     m_dataOffset(0),
@@ -1203,6 +1290,11 @@ bool RCCResourceLibrary::writeDataBlobs()
     Q_ASSERT(m_errorDevice);
     switch (m_format) {
     case C_Code:
+        if (m_dataAlignment > 0) {
+            writeString("alignas(");
+            writeByteArray(QByteArray::number(m_dataAlignment));
+            writeString(") ");
+        }
         writeString("static const unsigned char qt_resource_data[] = {\n");
         break;
     case Python_Code:
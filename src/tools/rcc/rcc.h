@@ -74,6 +74,12 @@ public:
     void setCompressThreshold(int t) { m_compressThreshold = t; }
     int compressThreshold() const { return m_compressThreshold; }
 
+    void setCompressChunkSize(int size) { m_compressChunkSize = size; }
+    int compressChunkSize() const { return m_compressChunkSize; }
+
+    void setDataAlignment(int alignment) { m_dataAlignment = alignment; }
+    int dataAlignment() const { return m_dataAlignment; }
+
     void setResourceRoot(const QString &root) { m_resourceRoot = root; }
     QString resourceRoot() const { return m_resourceRoot; }
 
@@ -141,6 +147,8 @@ private:
     CompressionAlgorithm m_compressionAlgo;
     int m_compressLevel;
     int m_compressThreshold;
+    int m_compressChunkSize;
+    int m_dataAlignment;
     int m_treeOffset;
     int m_namesOffset;
     int m_dataOffset;
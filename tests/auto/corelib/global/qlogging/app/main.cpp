@@ -57,6 +57,14 @@ int main(int argc, char **argv)
     MyClass cl;
     QMetaObject::invokeMethod(&cl, "mySlot1");
 
+    if (argc > 1 && qstrcmp(argv[1], "printf") == 0)
+        qWarning("%d %s %5.2f %c %lld%%", 42, "str", 3.14159, 'z', -1LL);
+
+    if (argc > 1 && qstrcmp(argv[1], "fatal") == 0) {
+        qSetMessagePattern("%{message}");
+        qFatal("qFatal");
+    }
+
     return 0;
 }
 
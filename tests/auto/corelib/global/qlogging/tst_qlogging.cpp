@@ -11,6 +11,9 @@
 #include <QtTest/QTest>
 #include <QList>
 #include <QMap>
+#include <QTemporaryDir>
+
+#include <QtCore/private/qbinarylog_p.h>
 
 class tst_qmessagehandler : public QObject
 {
@@ -37,6 +40,9 @@ private slots:
     void qMessagePattern_data();
     void qMessagePattern();
     void setMessagePattern();
+    void asyncOutput_data();
+    void asyncOutput();
+    void binaryOutput();
 
     void formatLogMessage_data();
     void formatLogMessage();
@@ -917,6 +923,124 @@ void tst_qmessagehandler::setMessagePattern()
 #endif // QT_CONFIG(process)
 }
 
+void tst_qmessagehandler::asyncOutput_data()
+{
+    QTest::addColumn<QString>("mode");
+    QTest::addColumn<QByteArray>("expectedTail");
+
+    QTest::newRow("exit") << QString() << QByteArray("[warning] qDebug with category\n");
+    QTest::newRow("qFatal") << QStringLiteral("fatal") << QByteArray("[warning] qDebug with category\nqFatal\n");
+}
+
+void tst_qmessagehandler::asyncOutput()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+    QFETCH(QString, mode);
+    QFETCH(QByteArray, expectedTail);
+
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+
+    QProcessEnvironment environment = m_baseEnvironment;
+    environment.insert("QT_LOGGING_ASYNC", "1");
+    process.setProcessEnvironment(environment);
+
+    // the messages queued when the process exits or aborts are still written
+    process.start(appExe, mode.isEmpty() ? QStringList() : QStringList(mode));
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    process.waitForFinished();
+
+    QByteArray output = process.readAllStandardError();
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+    const QByteArray expected = "static constructor\n"
+            "[debug] qDebug\n"
+            "[info] qInfo\n"
+            "[warning] qWarning\n"
+            "[critical] qCritical\n";
+    QVERIFY2(output.startsWith(expected), output.constData());
+    QVERIFY2(output.endsWith(expectedTail), output.constData());
+#endif // QT_CONFIG(process)
+}
+
+void tst_qmessagehandler::binaryOutput()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("binary.qlog");
+
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+
+    QProcessEnvironment environment = m_baseEnvironment;
+    environment.insert("QT_LOGGING_BINARY", fileName);
+    process.setProcessEnvironment(environment);
+
+    process.start(appExe, QStringList("printf"));
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    const qint64 pid = process.processId();
+    process.waitForFinished();
+
+    // the messages are written to the binary log instead of stderr
+    const QByteArray output = process.readAllStandardError();
+    QVERIFY2(!output.contains("qWarning"), output.constData());
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QBinaryLogReader reader(contents);
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.processId(), pid);
+
+    const QList<std::tuple<QtMsgType, QByteArray, QString>> expected = {
+        { QtDebugMsg, "default", "static constructor" },
+        { QtDebugMsg, "default", "qDebug" },
+        { QtInfoMsg, "default", "qInfo" },
+        { QtWarningMsg, "default", "qWarning" },
+        { QtCriticalMsg, "default", "qCritical" },
+        { QtWarningMsg, "category", "qDebug with category" },
+        { QtDebugMsg, "default", "qDebug2" },
+        { QtDebugMsg, "default", "from_a_function 34" },
+        { QtWarningMsg, "default", "42 str  3.14 z -1%" },
+        { QtDebugMsg, "default", "static destructor" },
+    };
+    QBinaryLogReader::Message message;
+    qint64 timestamp = 0;
+    for (const auto &[type, category, text] : expected) {
+        QVERIFY(reader.readNext(&message));
+        QCOMPARE(message.text, text);
+        QCOMPARE(int(message.type), int(type));
+        QCOMPARE(message.category, category);
+        QCOMPARE_GE(message.timestamp, timestamp);
+        timestamp = message.timestamp;
+    }
+    QVERIFY(!reader.readNext(&message));
+
+    // a warning made fatal is printed before aborting
+    environment.insert("QT_FATAL_WARNINGS", "1");
+    process.setProcessEnvironment(environment);
+    process.start(appExe, QStringList("printf"));
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitStatus(), QProcess::CrashExit);
+    const QByteArray fatalOutput = process.readAllStandardError();
+    QVERIFY2(fatalOutput.contains("qWarning"), fatalOutput.constData());
+#endif // QT_CONFIG(process)
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
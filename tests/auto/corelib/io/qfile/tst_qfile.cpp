@@ -13,6 +13,9 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 #include <QOperatingSystemVersion>
 #include <QRandomGenerator>
 #include <QStorageInfo>
@@ -190,6 +193,12 @@ private slots:
     void copyRemovesTemporaryFile() const;
     void copyShouldntOverwrite();
     void copyFallback();
+#if QT_CONFIG(future)
+    void readAsync_data();
+    void readAsync();
+    void writeAsync();
+    void copyAsync();
+#endif
     void link();
     void linkToDir();
     void absolutePathLinkToRelativePath();
@@ -268,6 +277,7 @@ private slots:
     void mapOpenMode();
     void mapWrittenFile_data();
     void mapWrittenFile();
+    void memoryMappedRead();
 
     void openStandardStreamsFileDescriptors();
     void openStandardStreamsBufferedStreams();
@@ -1605,6 +1615,94 @@ void tst_QFile::copyFallback()
             QFile::ReadOwner | QFile::WriteOwner);
 }
 
+#if QT_CONFIG(future)
+void tst_QFile::readAsync_data()
+{
+    QTest::addColumn<qint64>("offset");
+    QTest::addColumn<qint64>("maxSize");
+
+    QTest::newRow("all") << qint64(0) << qint64(-1);
+    QTest::newRow("offset") << qint64(100) << qint64(-1);
+    QTest::newRow("maxSize") << qint64(0) << qint64(100);
+    QTest::newRow("offset-maxSize") << qint64(100) << qint64(100);
+    QTest::newRow("past-end") << qint64(100) << qint64(1000000);
+    QTest::newRow("empty") << qint64(0) << qint64(0);
+}
+
+void tst_QFile::readAsync()
+{
+    QFETCH(qint64, offset);
+    QFETCH(qint64, maxSize);
+
+    QFile file(m_testFile);
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file).constData());
+    QVERIFY(file.seek(offset));
+    const QByteArray expected = maxSize < 0 ? file.readAll() : file.read(maxSize);
+    file.close();
+
+    QFuture<QByteArray> future = QFile::readAsync(m_testFile, offset, maxSize);
+    const QByteArray data = future.result();
+    QVERIFY(!data.isNull());
+    QCOMPARE(data, expected);
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+
+    // errors are reported by a null result
+    QVERIFY(QFile::readAsync("does-not-exist.txt").result().isNull());
+}
+
+void tst_QFile::writeAsync()
+{
+    const QString fileName = u"writeAsync.txt"_s;
+    QFile::remove(fileName);
+    const QByteArray data = QByteArray("0123456789abcdef").repeated(256 * 1024);
+
+    QFuture<qint64> future = QFile::writeAsync(fileName, data);
+    QCOMPARE(future.result(), data.size());
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+
+    QFile file(fileName);
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file).constData());
+    QCOMPARE(file.readAll(), data);
+    file.close();
+
+    // replaces the contents
+    QCOMPARE(QFile::writeAsync(fileName, "short"_ba).result(), 5);
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file).constData());
+    QCOMPARE(file.readAll(), "short"_ba);
+    file.close();
+
+    QCOMPARE(QFile::writeAsync(u"does-not-exist/writeAsync.txt"_s, data).result(), -1);
+}
+
+void tst_QFile::copyAsync()
+{
+    const QString fileName = u"copyAsync.txt"_s;
+    QFile::remove(fileName);
+
+    QFile source(m_testFile);
+    QVERIFY2(source.open(QIODevice::ReadOnly), msgOpenFailed(source).constData());
+    const QByteArray expected = source.readAll();
+    source.close();
+
+    QVERIFY(QFile::copyAsync(m_testFile, fileName).result());
+    QFile file(fileName);
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file).constData());
+    QCOMPARE(file.readAll(), expected);
+    file.close();
+
+    // doesn't overwrite
+    QVERIFY(!QFile::copyAsync(m_testFile, fileName).result());
+    QVERIFY(QFile::remove(fileName));
+
+    // the fallback copies in blocks and reports the progress
+    QFuture<bool> future = QFile::copyAsync(u":/copy-fallback.qrc"_s, fileName);
+    QVERIFY(future.result());
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+    QCOMPARE(QFileInfo(fileName).size(), QFileInfo(u":/copy-fallback.qrc"_s).size());
+    QVERIFY(QFile::setPermissions(fileName, QFile::ReadOwner | QFile::WriteOwner));
+}
+#endif // QT_CONFIG(future)
+
 #ifdef Q_OS_WIN
 #include <objbase.h>
 #include <shlobj.h>
@@ -3605,6 +3703,88 @@ void tst_QFile::mapWrittenFile()
     file.remove();
 }
 
+void tst_QFile::memoryMappedRead()
+{
+    QTemporaryFile temp;
+    QVERIFY2(temp.open(), qPrintable(temp.errorString()));
+    QByteArray contents;
+    for (int i = 0; i < 10000; ++i)
+        contents += "line " + QByteArray::number(i) + '\n';
+    QCOMPARE(temp.write(contents), qint64(contents.size()));
+    temp.close();
+
+    QFile file(temp.fileName());
+    QVERIFY2(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped), msgOpenFailed(file).constData());
+    QVERIFY(file.openMode() & QIODevice::MemoryMapped);
+    QVERIFY(file.openMode() & QIODevice::Unbuffered);
+
+    QCOMPARE(file.readLine(), "line 0\n");
+    QCOMPARE(file.peek(7), "line 1\n");
+    QCOMPARE(file.read(7), "line 1\n");
+    QVERIFY(file.seek(contents.indexOf("line 5000")));
+    QCOMPARE(file.readLine(), "line 5000\n");
+    QCOMPARE(file.pos(), qint64(contents.indexOf("line 5001")));
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.readAll(), contents);
+    QVERIFY(file.atEnd());
+    file.close();
+
+    // reads that go past the end of the mapping continue with regular reads
+    QVERIFY2(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped), msgOpenFailed(file).constData());
+    QFile appender(temp.fileName());
+    QVERIFY2(appender.open(QIODevice::Append), msgOpenFailed(appender).constData());
+    QCOMPARE(appender.write("appended\n"), 9);
+    appender.close();
+    QCOMPARE(file.readAll(), contents + "appended\n");
+    file.close();
+
+    // and so do line reads, also for a line that begins in the mapping
+    contents += "appended\npartial";
+    QVERIFY2(appender.open(QIODevice::Append), msgOpenFailed(appender).constData());
+    QCOMPARE(appender.write("partial"), 7);
+    appender.close();
+    QVERIFY2(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped), msgOpenFailed(file).constData());
+    QVERIFY(file.seek(contents.indexOf("line 9999")));
+    QCOMPARE(file.readLine(), "line 9999\n");
+    QVERIFY2(appender.open(QIODevice::Append), msgOpenFailed(appender).constData());
+    QCOMPARE(appender.write(" line\nlast\n"), 11);
+    appender.close();
+    contents += " line\nlast\n";
+    QCOMPARE(file.readLine(), "appended\n");
+    QCOMPARE(file.readLine(), "partial line\n");
+    QCOMPARE(file.pos(), qint64(contents.indexOf("last")));
+    QCOMPARE(file.readLine(), "last\n");
+    QCOMPARE(file.pos(), qint64(contents.size()));
+    QVERIFY(file.atEnd());
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.readLine(), "line 0\n");
+    file.close();
+
+    // mapping is only used for reading
+    QVERIFY2(file.open(QIODevice::ReadWrite | QIODevice::MemoryMapped), msgOpenFailed(file).constData());
+    QVERIFY(!(file.openMode() & QIODevice::MemoryMapped));
+    QCOMPARE(file.readLine(), "line 0\n");
+    file.close();
+
+    // adopted file descriptors are not mapped
+    QFile byName(temp.fileName());
+    QVERIFY2(byName.open(QIODevice::ReadOnly), msgOpenFailed(byName).constData());
+    QFile byHandle;
+    QVERIFY(byHandle.open(byName.handle(), QIODevice::ReadOnly | QIODevice::MemoryMapped));
+    QVERIFY(!(byHandle.openMode() & QIODevice::MemoryMapped));
+    QCOMPARE(byHandle.readLine(), "line 0\n");
+    byHandle.close();
+    byName.close();
+
+    // empty files can't be mapped, but can still be opened
+    QFile empty(temp.fileName());
+    QVERIFY2(empty.open(QIODevice::WriteOnly | QIODevice::Truncate), msgOpenFailed(empty).constData());
+    empty.close();
+    QVERIFY2(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped), msgOpenFailed(file).constData());
+    QVERIFY(!(file.openMode() & QIODevice::MemoryMapped));
+    QVERIFY(file.readAll().isEmpty());
+}
+
 void tst_QFile::openDirectory()
 {
     QFile f1(m_resourcesDir);
@@ -32,6 +32,7 @@
 #include <qplatformdefs.h>
 #include <qdebug.h>
 #include <private/qfileinfo_p.h>
+#include <private/qfilesystemmetadatacache_p.h>
 #include "../../../../shared/filesystem.h"
 
 #if defined(Q_OS_MACOS)
@@ -245,6 +246,7 @@ private slots:
 
     void stdfilesystem();
     void readSymLink();
+    void sharedCache();
 
 #if defined(Q_OS_DARWIN)
     void fileSystemCaseSensitivity_data();
@@ -2458,6 +2460,97 @@ void tst_QFileInfo::readSymLink()
     QCOMPARE(info.readSymLink(), QString("../../a"));
 }
 
+void tst_QFileInfo::sharedCache()
+{
+#ifndef QT_FILESYSTEMMETADATACACHE
+    QSKIP("The shared metadata cache is not available on this platform");
+#else
+    if (!QFileSystemMetaDataCache::setEnabled(true))
+        QSKIP("Could not enable the shared metadata cache");
+    auto cleanup = qScopeGuard([] { QFileSystemMetaDataCache::setEnabled(false); });
+
+    const QString dirPath = m_dir.path() + "/sharedCache";
+    QVERIFY(QDir().mkpath(dirPath + "/sub"));
+    const QString filePath = dirPath + "/file";
+    const QString subFilePath = dirPath + "/sub/file";
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write("abc"), 3);
+    QVERIFY(file.flush());
+
+    QCOMPARE(QFileInfo(filePath).size(), 3);
+    if (QFileSystemMetaDataCache::statistics().directories == 0)
+        QSKIP("The temporary directory is not on a file system supported by the cache");
+
+    // served from the cache
+    auto before = QFileSystemMetaDataCache::statistics();
+    QCOMPARE(QFileInfo(filePath).size(), 3);
+    QVERIFY(QFileInfo::exists(filePath));
+    auto after = QFileSystemMetaDataCache::statistics();
+    QCOMPARE(after.hits, before.hits + 2);
+    QCOMPARE(after.misses, before.misses);
+
+    // modified
+    QCOMPARE(file.write("def"), 3);
+    QVERIFY(file.flush());
+    QCOMPARE(QFileInfo(filePath).size(), 6);
+    file.close();
+
+    // permissions changed
+    QVERIFY(QFileInfo(filePath).isWritable());
+    QVERIFY(file.setPermissions(QFile::ReadOwner));
+    QCOMPARE(QFileInfo(filePath).permissions() & QFile::WriteOwner, QFile::Permissions());
+    QVERIFY(file.setPermissions(QFile::ReadOwner | QFile::WriteOwner));
+
+    // created and removed
+    QVERIFY(!QFileInfo::exists(subFilePath));
+    QVERIFY(QFile::copy(filePath, subFilePath));
+    QVERIFY(QFileInfo::exists(subFilePath));
+    QCOMPARE(QFileInfo(subFilePath).size(), 6);
+    QVERIFY(QFile::remove(subFilePath));
+    QVERIFY(!QFileInfo::exists(subFilePath));
+
+    // the directory of an entry renamed
+    QVERIFY(QFile::copy(filePath, subFilePath));
+    QVERIFY(QFileInfo(subFilePath).isFile());
+    QVERIFY(QDir(dirPath).rename("sub", "moved"));
+    QVERIFY(!QFileInfo::exists(subFilePath));
+    QVERIFY(QFileInfo(dirPath + "/moved/file").isFile());
+    QVERIFY(QDir(dirPath).rename("moved", "sub"));
+    QVERIFY(QFileInfo(subFilePath).isFile());
+
+    // symlinks and the paths through them see changes to the target
+    const QString linkPath = dirPath + "/link";
+    QVERIFY(QFile::link(subFilePath, linkPath));
+    QCOMPARE(QFileInfo(linkPath).size(), 6);
+    QVERIFY(QFile::link(dirPath + "/sub", dirPath + "/sublink"));
+    QCOMPARE(QFileInfo(dirPath + "/sublink/file").size(), 6);
+    file.setFileName(subFilePath);
+    QVERIFY(file.open(QIODevice::Append));
+    QCOMPARE(file.write("ghi"), 3);
+    file.close();
+    QCOMPARE(QFileInfo(linkPath).size(), 9);
+    QCOMPARE(QFileInfo(dirPath + "/sublink/file").size(), 9);
+
+    // directories see changes to their entries
+    const QString subPath = dirPath + "/sub";
+    const QDateTime subModified = QFileInfo(subPath).lastModified(QTimeZone::UTC);
+    QTest::qSleep(20);
+    QVERIFY(QFile::copy(filePath, subPath + "/other"));
+    QCOMPARE_GT(QFileInfo(subPath).lastModified(QTimeZone::UTC), subModified);
+
+    // relative paths aren't cached
+    before = QFileSystemMetaDataCache::statistics();
+    QVERIFY(QFileInfo("sharedCache/file").isFile());
+    after = QFileSystemMetaDataCache::statistics();
+    QCOMPARE(after.hits + after.misses, before.hits + before.misses);
+
+    QFileSystemMetaDataCache::clear();
+    QCOMPARE(QFileSystemMetaDataCache::statistics().directories, 0);
+    QCOMPARE(QFileInfo(filePath).size(), 6);
+#endif
+}
+
 #if defined(Q_OS_DARWIN)
 void tst_QFileInfo::fileSystemCaseSensitivity_data()
 {
@@ -84,6 +84,8 @@ private slots:
     void signalsEmittedAfterFileMoved();
 
     void watchUnicodeCharacters();
+    void watchDirectoryRecursively();
+    void watchDirectoryRecursivelyAfterOverflow();
 #if defined(Q_OS_WIN)
     void watchDirectoryAttributeChanges();
 #endif
@@ -842,6 +844,110 @@ void tst_QFileSystemWatcher::watchUnicodeCharacters()
     QTRY_COMPARE(changedSpy.count(), 1);
 }
 
+void tst_QFileSystemWatcher::watchDirectoryRecursively()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = temporaryDirectory.path();
+    QDir testDir(root);
+    QVERIFY(testDir.mkpath("a/b/c"));
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(root))
+        QSKIP("Recursive watching is not supported on this platform");
+    QCOMPARE(watcher.directories(), QStringList(root));
+
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    const auto changedPaths = [&changedSpy] {
+        QStringList paths;
+        for (const QList<QVariant> &arguments : std::as_const(changedSpy))
+            paths << arguments.at(0).toString();
+        return paths;
+    };
+
+    // The watcher reaches the subdirectories from the event loop, so keep
+    // changing a directory until the change is reported.
+    const auto changeReported = [&](const QString &dir) {
+        QDir(dir).mkdir("probe");
+        QDir(dir).rmdir("probe");
+        return changedPaths().contains(dir);
+    };
+    const QString deepDir = root + "/a/b/c";
+    QTRY_VERIFY(changeReported(deepDir));
+
+    // directories created later are watched as well
+    QVERIFY(testDir.mkdir("a/b/c/d"));
+    QTRY_VERIFY(changeReported(deepDir + "/d"));
+
+    // removing a subtree drops its watches, recreating it watches it again
+    QVERIFY(QDir(root + "/a/b").removeRecursively());
+    QVERIFY(testDir.mkpath("a/b/c"));
+    QTRY_VERIFY(changeReported(deepDir));
+
+    QVERIFY(watcher.removePath(root));
+    QVERIFY(watcher.directories().isEmpty());
+    changedSpy.clear();
+    QVERIFY(testDir.mkdir("a/b/c/f"));
+
+    // inotify reports events in order, so once a change made afterwards
+    // arrives, one for the removed tree would have arrived too
+    QTemporaryDir otherDirectory(m_tempDirPattern);
+    QVERIFY2(otherDirectory.isValid(), qPrintable(otherDirectory.errorString()));
+    QVERIFY(watcher.addPath(otherDirectory.path()));
+    QVERIFY(QDir(otherDirectory.path()).mkdir("g"));
+    QTRY_VERIFY(!changedSpy.isEmpty());
+    QCOMPARE(changedPaths(), QStringList(otherDirectory.path()));
+}
+
+void tst_QFileSystemWatcher::watchDirectoryRecursivelyAfterOverflow()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("This test overflows the event queue of inotify");
+#else
+    QFile maxQueuedEvents("/proc/sys/fs/inotify/max_queued_events");
+    if (!maxQueuedEvents.open(QIODevice::ReadOnly))
+        QSKIP("The size of the inotify event queue is unknown");
+    const int queueSize = maxQueuedEvents.readAll().trimmed().toInt();
+    if (queueSize <= 0 || queueSize > 100000)
+        QSKIP("The inotify event queue is too large to overflow it");
+
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    const QString root = temporaryDirectory.path();
+    QDir testDir(root);
+    QVERIFY(testDir.mkdir("a"));
+
+    QFileSystemWatcher watcher;
+    if (!watcher.addRecursivePath(root))
+        QSKIP("Recursive watching is not supported on this platform");
+
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    const auto changeReported = [&](const QString &dir) {
+        QDir(dir).mkdir("probe");
+        QDir(dir).rmdir("probe");
+        for (const QList<QVariant> &arguments : std::as_const(changedSpy)) {
+            if (arguments.at(0).toString() == dir)
+                return true;
+        }
+        return false;
+    };
+    QTRY_VERIFY(changeReported(root + "/a"));
+
+    // Fill the queue without returning to the event loop, so that the
+    // creation of the new directories is dropped
+    for (int i = 0; i < queueSize; ++i) {
+        QVERIFY(testDir.mkdir("flood"));
+        QVERIFY(testDir.rmdir("flood"));
+    }
+    QVERIFY(testDir.mkpath("b/c"));
+
+    // the tree is scanned again once the overflow is reported
+    QTRY_VERIFY(changeReported(root + "/b/c"));
+    QTRY_VERIFY(changeReported(root + "/a"));
+#endif
+}
+
 #if defined(Q_OS_WIN)
 void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 {
@@ -7,6 +7,8 @@
 #include <QMap>
 #include <QStringList>
 
+#include <atomic>
+
 Q_LOGGING_CATEGORY(TST_LOG, "tst.log")
 Q_LOGGING_CATEGORY(Digia_Oslo_Office_com, "Digia.Oslo.Office.com")
 Q_LOGGING_CATEGORY(Digia_Oulu_Office_com, "Digia.Oulu.Office.com")
@@ -911,6 +913,95 @@ private slots:
         }
     }
 
+    void setFilterRulesIncremental()
+    {
+        QLoggingCategory a("incremental.a");
+        QLoggingCategory b("incremental.b");
+        QLoggingCategory c("other.c", QtInfoMsg);
+
+        QLoggingCategory::setFilterRules("incremental.*=false");
+        QVERIFY(!a.isDebugEnabled());
+        QVERIFY(!b.isWarningEnabled());
+        QVERIFY(!c.isDebugEnabled());
+        QVERIFY(c.isInfoEnabled());
+
+        // appending a rule
+        QLoggingCategory::setFilterRules("incremental.*=false\nincremental.b.warning=true");
+        QVERIFY(!a.isWarningEnabled());
+        QVERIFY(b.isWarningEnabled());
+        QVERIFY(!b.isDebugEnabled());
+
+        // removing the rule matching a category reverts it to its defaults
+        QLoggingCategory::setFilterRules("incremental.b.warning=true");
+        QVERIFY(a.isDebugEnabled());
+        QVERIFY(b.isDebugEnabled());
+        QVERIFY(!c.isDebugEnabled());
+
+        // reordering the rules
+        QLoggingCategory::setFilterRules("*.debug=true\nincremental.a.debug=false");
+        QVERIFY(!a.isDebugEnabled());
+        QVERIFY(c.isDebugEnabled());
+        QLoggingCategory::setFilterRules("incremental.a.debug=false\n*.debug=true");
+        QVERIFY(a.isDebugEnabled());
+
+        QLoggingCategory::setFilterRules(QString());
+        QVERIFY(a.isDebugEnabled());
+        QVERIFY(!c.isDebugEnabled());
+    }
+
+    void setFilterRulesCustomFilter()
+    {
+        // a custom filter is called even if the rules didn't change
+        static int calls = 0;
+        QLoggingCategory category("customfilter.category");
+        QLoggingCategory::setFilterRules("customfilter.*=false");
+        QLoggingCategory::CategoryFilter oldFilter = QLoggingCategory::installFilter(
+                [](QLoggingCategory *cat) {
+                    if (qstrcmp(cat->categoryName(), "customfilter.category") == 0)
+                        ++calls;
+                });
+        calls = 0;
+        QLoggingCategory::setFilterRules("customfilter.*=false");
+        QCOMPARE(calls, 1);
+        QLoggingCategory::setFilterRules("customfilter.*=false");
+        QCOMPARE(calls, 2);
+        QLoggingCategory::installFilter(oldFilter);
+        QLoggingCategory::setFilterRules(QString());
+        QVERIFY(category.isDebugEnabled());
+    }
+
+    void concurrentRegistration()
+    {
+        // the categories created while the rules change end up with the final rules
+        std::atomic<bool> done = false;
+        auto create = [&done] {
+            while (!done.load(std::memory_order_relaxed)) {
+                QLoggingCategory category("concurrent.category");
+                QLoggingCategory other("concurrent.other");
+            }
+        };
+        QList<QThread *> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.append(QThread::create(create));
+            threads.last()->start();
+        }
+        QLoggingCategory category("concurrent.category");
+        for (int i = 0; i < 100; ++i) {
+            QLoggingCategory::setFilterRules(i % 2 ? "concurrent.category.debug=false"
+                                                   : "concurrent.*.debug=false");
+            QVERIFY(!category.isDebugEnabled());
+            QLoggingCategory::setFilterRules(QString());
+            QVERIFY(category.isDebugEnabled());
+            QLoggingCategory other("concurrent.other");
+            QVERIFY(other.isDebugEnabled());
+        }
+        done = true;
+        for (QThread *thread : std::as_const(threads)) {
+            thread->wait();
+            delete thread;
+        }
+    }
+
     void cleanupTestCase()
     {
         delete _config;
@@ -1,9 +1,12 @@
 #!/bin/sh
 # Copyright (C) 2016 Intel Corporation.
 # SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
-count=`awk '/ZERO_FILE_LEN/ { print $3 }' tst_qresourceengine.cpp`
+count=`awk '/#define ZERO_FILE_LEN/ { print $3 }' tst_qresourceengine.cpp`
 dd if=/dev/zero of=zero.txt bs=1 count=$count
+awk -v count=$count 'BEGIN { for (offset = 0; offset < count; offset += 16) printf "%015d\n", offset }' > pattern.txt
 rcc --binary -o uncompressed.rcc --no-compress compressed.qrc
 rcc --binary -o zlib.rcc --compress-algo zlib --compress 9 compressed.qrc
 rcc --binary -o zstd.rcc --compress-algo zstd --compress 19 compressed.qrc
-rm zero.txt
+rcc --binary -o zlib-chunked.rcc --compress-algo zlib --compress 9 --compress-chunk-size 4096 chunked.qrc
+rcc --binary -o zstd-chunked.rcc --compress-algo zstd --compress 19 --compress-chunk-size 4096 chunked.qrc
+rm zero.txt pattern.txt
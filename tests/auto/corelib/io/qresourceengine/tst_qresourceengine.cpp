@@ -104,38 +104,64 @@ void tst_QResourceEngine::cleanupTestCase()
     QVERIFY(QResource::unregisterResource(resourcePtr, "/secondary_root/"));
 }
 
+// Note: generateResource.sh parses this line. Make sure it's a simple number.
+#define ZERO_FILE_LEN   16384
+// End note
+
+// What generateResources.sh writes to pattern.txt: the offset of each line of
+// 16 bytes, so that data read from the wrong place doesn't compare equal.
+static QByteArray patternedData()
+{
+    QByteArray data;
+    for (int offset = 0; offset < ZERO_FILE_LEN; offset += 16)
+        data += QByteArray::number(offset).rightJustified(15, '0') + '\n';
+    return data;
+}
+
 void tst_QResourceEngine::compressedResource_data()
 {
     QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QString>("resourceName");
+    QTest::addColumn<QByteArray>("expectedData");
     QTest::addColumn<int>("compressionAlgo");
     QTest::addColumn<bool>("supported");
 
+    const QByteArray zeroData(ZERO_FILE_LEN, '\0');
+    const QByteArray patterned = patternedData();
     QTest::newRow("uncompressed")
-            << QFINDTESTDATA("uncompressed.rcc") << int(QResource::NoCompression) << true;
+            << QFINDTESTDATA("uncompressed.rcc") << QStringLiteral("zero.txt") << zeroData
+            << int(QResource::NoCompression) << true;
     QTest::newRow("zlib")
-            << QFINDTESTDATA("zlib.rcc") << int(QResource::ZlibCompression) << true;
+            << QFINDTESTDATA("zlib.rcc") << QStringLiteral("zero.txt") << zeroData
+            << int(QResource::ZlibCompression) << true;
     QTest::newRow("zstd")
-            << QFINDTESTDATA("zstd.rcc") << int(QResource::ZstdCompression) << QT_CONFIG(zstd);
+            << QFINDTESTDATA("zstd.rcc") << QStringLiteral("zero.txt") << zeroData
+            << int(QResource::ZstdCompression) << QT_CONFIG(zstd);
+    QTest::newRow("zlib-chunked")
+            << QFINDTESTDATA("zlib-chunked.rcc") << QStringLiteral("pattern.txt") << patterned
+            << int(QResource::ZlibCompression) << true;
+    QTest::newRow("zstd-chunked")
+            << QFINDTESTDATA("zstd-chunked.rcc") << QStringLiteral("pattern.txt") << patterned
+            << int(QResource::ZstdCompression) << QT_CONFIG(zstd);
 }
 
-// Note: generateResource.sh parses this line. Make sure it's a simple number.
-#define ZERO_FILE_LEN   16384
-// End note
 void tst_QResourceEngine::compressedResource()
 {
     QFETCH(QString, fileName);
+    QFETCH(QString, resourceName);
+    QFETCH(QByteArray, expectedData);
     QFETCH(int, compressionAlgo);
     QFETCH(bool, supported);
-    const QByteArray expectedData(ZERO_FILE_LEN, '\0');
+    QCOMPARE(expectedData.size(), ZERO_FILE_LEN);
 
-    QVERIFY(!QResource("zero.txt").isValid());
+    QVERIFY(!QResource(resourceName).isValid());
     QCOMPARE(QResource::registerResource(fileName), supported);
     if (!supported)
         return;
 
     auto unregister = qScopeGuard([=] { QResource::unregisterResource(fileName); });
 
-    QResource resource("zero.txt");
+    QResource resource(resourceName);
     QVERIFY(resource.isValid());
     QVERIFY(resource.size() > 0);
     QVERIFY(resource.data());
@@ -154,7 +180,7 @@ void tst_QResourceEngine::compressedResource()
     }
 
     // using the engine
-    QFile f(":/zero.txt");
+    QFile f(u':' + resourceName);
     QVERIFY(f.exists());
     QVERIFY(f.open(QIODevice::ReadOnly));
 
@@ -170,6 +196,22 @@ void tst_QResourceEngine::compressedResource()
     data = f.readAll();
     QCOMPARE(data.size(), expectedData.size());
     QCOMPARE(data, expectedData);
+
+    // reads that start and end in the middle of (chunked) compressed data
+    QVERIFY(f.seek(ZERO_FILE_LEN / 4 - 100));
+    data = f.read(ZERO_FILE_LEN / 2 + 200);
+    QCOMPARE(data, expectedData.sliced(ZERO_FILE_LEN / 4 - 100, ZERO_FILE_LEN / 2 + 200));
+    QVERIFY(f.seek(ZERO_FILE_LEN - 10));
+    data = f.read(100);
+    QCOMPARE(data, expectedData.last(10));
+    QVERIFY(f.seek(ZERO_FILE_LEN / 4 + 8));
+    data = f.read(16);
+    QCOMPARE(data, expectedData.sliced(ZERO_FILE_LEN / 4 + 8, 16));
+
+    // mapping decompresses the whole file
+    const uchar *mapped = f.map(0, ZERO_FILE_LEN);
+    QVERIFY(mapped);
+    QCOMPARE(memcmp(mapped, expectedData.constData(), ZERO_FILE_LEN), 0);
 }
 
 
@@ -212,7 +254,9 @@ void tst_QResourceEngine::checkStructure_data()
                                            << "search_file.txt"
 #if defined(BUILTIN_TESTDATA)
                                            << "uncompressed.rcc"
+                                           << "zlib-chunked.rcc"
                                            << "zlib.rcc"
+                                           << "zstd-chunked.rcc"
                                            << "zstd.rcc"
 #endif
                                            )
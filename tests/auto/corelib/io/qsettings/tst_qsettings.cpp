@@ -202,6 +202,7 @@ private slots:
     void embeddedZeroByte();
     void spaceAfterComment();
     void floatAsQVariant();
+    void iniCache();
 
     void testXdg();
 
@@ -855,6 +856,110 @@ void tst_QSettings::floatAsQVariant()
     QCOMPARE(s.value("float_qvariant").toFloat(), 0.5);
 }
 
+void tst_QSettings::iniCache()
+{
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    const QString fileName = tempDir.filePath(u"cached.ini"_s);
+    const QString journalFileName = fileName + u".qtjournal"_s;
+    auto fileContents = [](const QString &fileName) {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+
+    const auto restoreEnvironment = qScopeGuard([] {
+        qunsetenv("QT_SETTINGS_INI_CACHE");
+        QConfFile::clearCache();
+    });
+    auto setCacheEnabled = [](bool enabled) {
+        QConfFile::clearCache();
+        if (enabled)
+            qputenv("QT_SETTINGS_INI_CACHE", "1");
+        else
+            qunsetenv("QT_SETTINGS_INI_CACHE");
+    };
+
+    const QStringList keys = { u"string"_s, u"Group/Int"_s, u"Group/list"_s, u"Group/new"_s,
+                               u"rect"_s, u"bytes"_s, u"date"_s, u"missing"_s };
+    auto read = [&](bool useCache) {
+        setCacheEnabled(useCache);
+        QSettings settings(fileName, QSettings::IniFormat);
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QVariantMap values;
+        // look the keys up before allKeys() needs the whole file
+        for (const QString &key : keys)
+            values.insert(key, settings.value(key));
+        values.insert(u"allKeys"_s, settings.allKeys());
+        return values;
+    };
+
+    setCacheEnabled(true);
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        settings.setValue("string", "hello");
+        settings.setValue("Group/Int", 42);
+        settings.setValue("Group/list", QStringList{ u"a"_s, u"b"_s });
+        settings.setValue("rect", QRect(1, 2, 3, 4));
+        settings.setValue("bytes", QByteArray("\0\1", 2));
+        settings.setValue("date", QDate(2024, 1, 2));
+    }
+    QVERIFY(!QFile::exists(journalFileName));
+
+    // once from the INI file, then from the cache written by the first reader
+    const QVariantMap expected = read(false);
+    QCOMPARE(expected.value(u"Group/Int"_s), QVariant(u"42"_s));
+    QCOMPARE(read(true), expected);
+    QVERIFY(QFile::exists(fileName + u".qtcache"_s));
+    QCOMPARE(read(true), expected);
+
+    // small changes go to the journal
+    const QByteArray iniContents = fileContents(fileName);
+    setCacheEnabled(true);
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        settings.setValue("string", "changed");
+        settings.setValue("Group/new", QStringList{ u"x"_s, u"y"_s, u"z"_s });
+        settings.remove("rect");
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+    }
+    QVERIFY(QFile::exists(journalFileName));
+    QCOMPARE(fileContents(fileName), iniContents);
+
+    const QVariantMap journaled = read(true);
+    QCOMPARE(journaled.value(u"string"_s), QVariant(u"changed"_s));
+    QCOMPARE(journaled.value(u"Group/new"_s).toStringList(),
+             QStringList({ u"x"_s, u"y"_s, u"z"_s }));
+    QVERIFY(!journaled.value(u"rect"_s).isValid());
+    QCOMPARE(journaled.value(u"date"_s), expected.value(u"date"_s));
+    QCOMPARE(read(true), journaled);
+
+    // until the journal grows too large and is folded into the INI file
+    setCacheEnabled(true);
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        for (int i = 0; QFile::exists(journalFileName); ++i) {
+            QVERIFY(i < 1000);
+            settings.setValue(u"big/"_s + QString::number(i), QString(1000, u'x'));
+            settings.sync();
+            QCOMPARE(settings.status(), QSettings::NoError);
+        }
+    }
+    QVERIFY(fileContents(fileName) != iniContents);
+    const QVariantMap folded = read(false);
+    QCOMPARE(folded.value(u"string"_s), QVariant(u"changed"_s));
+    QVERIFY(!folded.value(u"rect"_s).isValid());
+    QCOMPARE(read(true), folded);
+
+    // the cache is no more readable than the INI file
+    const QString cacheFileName = fileName + u".qtcache"_s;
+    QVERIFY(QFile::setPermissions(fileName, QFile::ReadOwner | QFile::WriteOwner));
+    QVERIFY(QFile::remove(cacheFileName));
+    QCOMPARE(read(true), folded);
+    QVERIFY(QFile::exists(cacheFileName));
+    QCOMPARE(QFileInfo(cacheFileName).permissions(), QFileInfo(fileName).permissions());
+}
+
 void tst_QSettings::testErrorHandling_data()
 {
 #ifdef Q_OS_WIN
@@ -4,6 +4,8 @@
 #include <QTest>
 #include <QDebug>
 #include <QBuffer>
+#include <QTemporaryDir>
+#include <QtEndian>
 
 #include <private/qzipwriter_p.h>
 #include <private/qzipreader_p.h>
@@ -17,6 +19,9 @@ private slots:
     void symlinks();
     void readTest();
     void createArchive();
+    void zip64();
+    void largeEntry();
+    void zstdEntry();
 };
 
 void tst_QZip::basicUnpack()
@@ -112,5 +117,113 @@ void tst_QZip::createArchive()
     QCOMPARE(zip2.fileData("My Filename"), fileContents);
 }
 
+void tst_QZip::zip64()
+{
+    QZipReader zip(QFINDTESTDATA("/testdata/zip64.zip"), QIODevice::ReadOnly);
+    QList<QZipReader::FileInfo> files = zip.fileInfoList();
+    QCOMPARE(files.size(), 1);
+    QCOMPARE(files.at(0).filePath, QString("data.txt"));
+    QCOMPARE(files.at(0).size, qint64(14));
+    QCOMPARE(zip.fileData("data.txt"), QByteArray("zip64 content\n"));
+}
+
+void tst_QZip::largeEntry()
+{
+    // big enough to be compressed in several blocks, and partly incompressible
+    QByteArray fileContents;
+    quint32 seed = 1;
+    for (int i = 0; i < 300000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        fileContents += "line " + QByteArray::number(i) + ' ' + QByteArray::number(seed, 16) + '\n';
+    }
+    QVERIFY(fileContents.size() > 4 * 1024 * 1024);
+
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    writer.addFile("large", fileContents);
+    writer.addFile("small", QByteArray("small contents"));
+    writer.close();
+    QByteArray zipFile = buffer.buffer();
+    QVERIFY(zipFile.size() < fileContents.size());
+
+    QBuffer buffer2(&zipFile);
+    QZipReader reader(&buffer2);
+    QCOMPARE(reader.fileData("large"), fileContents);
+
+    // read both entries interleaved, in small pieces
+    std::unique_ptr<QIODevice> large = reader.fileDevice("large");
+    std::unique_ptr<QIODevice> small = reader.fileDevice("small");
+    QVERIFY(large);
+    QVERIFY(small);
+    QVERIFY(!reader.fileDevice("missing"));
+    QCOMPARE(large->size(), qint64(fileContents.size()));
+
+    QByteArray streamed;
+    char chunk[1000];
+    qint64 read;
+    while ((read = large->read(chunk, sizeof(chunk))) > 0) {
+        streamed.append(chunk, read);
+        if (streamed.size() == 10 * qsizetype(sizeof(chunk)))
+            QCOMPARE(small->readAll(), QByteArray("small contents"));
+    }
+    QVERIFY(large->atEnd());
+    QCOMPARE(streamed, fileContents);
+}
+
+void tst_QZip::zstdEntry()
+{
+    QByteArray fileContents;
+    for (int i = 0; i < 20000; ++i)
+        fileContents += "line " + QByteArray::number(i) + '\n';
+
+    QFile archive(QFINDTESTDATA("testdata/zstd.zip"));
+    QVERIFY(archive.open(QIODevice::ReadOnly));
+    QByteArray zipFile = archive.readAll();
+    QBuffer buffer(&zipFile);
+    QZipReader reader(&buffer);
+    const QList<QZipReader::FileInfo> files = reader.fileInfoList();
+    QCOMPARE(files.size(), 1);
+    QCOMPARE(files.at(0).filePath, QString("zstd.txt"));
+    QCOMPARE(files.at(0).size, qint64(fileContents.size()));
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+
+#if QT_CONFIG(zstd)
+    QCOMPARE(reader.fileData("zstd.txt"), fileContents);
+
+    std::unique_ptr<QIODevice> entry = reader.fileDevice("zstd.txt");
+    QVERIFY(entry);
+    QByteArray streamed;
+    char chunk[1000];
+    qint64 read;
+    while ((read = entry->read(chunk, sizeof(chunk))) > 0)
+        streamed.append(chunk, read);
+    QVERIFY(entry->atEnd());
+    QCOMPARE(streamed, fileContents);
+
+    QVERIFY(reader.extractAll(dir.path()));
+    QFile extracted(dir.filePath("zstd.txt"));
+    QVERIFY(extracted.open(QIODevice::ReadOnly));
+    QCOMPARE(extracted.readAll(), fileContents);
+    extracted.close();
+
+    // cut the entry short in the central directory: extraction must fail
+    const qsizetype centralDirectory = zipFile.indexOf("PK\x01\x02");
+    QVERIFY(centralDirectory > 0);
+    const quint32 compressedSize = qFromLittleEndian<quint32>(zipFile.constData() + centralDirectory + 20);
+    qToLittleEndian<quint32>(compressedSize / 2, zipFile.data() + centralDirectory + 20);
+    QBuffer truncatedBuffer(&zipFile);
+    QZipReader truncated(&truncatedBuffer);
+    QTest::ignoreMessage(QtWarningMsg, "QZip: Unexpected end of compressed data");
+    QTemporaryDir truncatedDir;
+    QVERIFY2(truncatedDir.isValid(), qPrintable(truncatedDir.errorString()));
+    QVERIFY(!truncated.extractAll(truncatedDir.path()));
+#else
+    QTest::ignoreMessage(QtWarningMsg, "QZip: Unsupported compression method 93 is needed to extract the data.");
+    QVERIFY(!reader.extractAll(dir.path()));
+#endif
+}
+
 QTEST_MAIN(tst_QZip)
 #include "tst_qzip.moc"
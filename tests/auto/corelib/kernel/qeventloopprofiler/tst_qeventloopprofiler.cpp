@@ -0,0 +1,265 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTimer>
+
+#include <private/qeventloopprofiler_p.h>
+#include <private/qmetaobjectbuilder_p.h>
+
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+class tst_QEventLoopProfiler : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void bucketIndex_data();
+    void bucketIndex();
+    void bucketBounds();
+    void summary();
+    void disabled();
+    void sendEvent();
+    void deleteReceiver();
+    void allocatedMetaObject();
+    void postEvent();
+    void timerLateness();
+    void report();
+};
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::User) {
+            QTest::qSleep(2);
+            return true;
+        }
+        if (e->type() == QEvent::Type(QEvent::User + 1)) {
+            delete this;
+            return true;
+        }
+        return QObject::event(e);
+    }
+};
+
+// Has a meta-object of its own, like the objects created by QML
+class AllocatedReceiver : public Receiver
+{
+public:
+    AllocatedReceiver()
+    {
+        QMetaObjectBuilder builder;
+        builder.setClassName("AllocatedReceiver_QML_0");
+        builder.setSuperClass(&Receiver::staticMetaObject);
+        allocated = builder.toMetaObject();
+    }
+    ~AllocatedReceiver() override { free(allocated); }
+    const QMetaObject *metaObject() const override { return allocated; }
+
+private:
+    QMetaObject *allocated;
+};
+
+void tst_QEventLoopProfiler::init()
+{
+    QEventLoopProfiler::reset();
+    QEventLoopProfiler::setEnabled(true);
+}
+
+void tst_QEventLoopProfiler::cleanup()
+{
+    QEventLoopProfiler::setEnabled(false);
+}
+
+void tst_QEventLoopProfiler::bucketIndex_data()
+{
+    QTest::addColumn<quint64>("value");
+    QTest::addColumn<int>("index");
+
+    QTest::newRow("0") << Q_UINT64_C(0) << 0;
+    QTest::newRow("7") << Q_UINT64_C(7) << 7;
+    QTest::newRow("8") << Q_UINT64_C(8) << 8;
+    QTest::newRow("15") << Q_UINT64_C(15) << 15;
+    QTest::newRow("16") << Q_UINT64_C(16) << 16;
+    QTest::newRow("17") << Q_UINT64_C(17) << 16;
+    QTest::newRow("18") << Q_UINT64_C(18) << 17;
+    QTest::newRow("31") << Q_UINT64_C(31) << 23;
+    QTest::newRow("32") << Q_UINT64_C(32) << 24;
+    QTest::newRow("max") << std::numeric_limits<quint64>::max()
+                         << QEventLoopHistogram::BucketCount - 1;
+}
+
+void tst_QEventLoopProfiler::bucketIndex()
+{
+    QFETCH(quint64, value);
+    QFETCH(int, index);
+    QCOMPARE(QEventLoopHistogram::bucketIndex(value), index);
+}
+
+void tst_QEventLoopProfiler::bucketBounds()
+{
+    // every bucket ends right before the next one starts
+    for (int i = 0; i < QEventLoopHistogram::BucketCount; ++i) {
+        const quint64 upper = QEventLoopHistogram::bucketUpperBound(i);
+        QCOMPARE(QEventLoopHistogram::bucketIndex(upper), i);
+        if (i + 1 < QEventLoopHistogram::BucketCount)
+            QCOMPARE(QEventLoopHistogram::bucketIndex(upper + 1), i + 1);
+    }
+    QCOMPARE(QEventLoopHistogram::bucketUpperBound(QEventLoopHistogram::BucketCount - 1),
+             std::numeric_limits<quint64>::max());
+}
+
+void tst_QEventLoopProfiler::summary()
+{
+    QEventLoopHistogram histogram;
+    QCOMPARE(histogram.summary().count, 0u);
+    QCOMPARE(histogram.summary().p99, 0u);
+
+    for (quint64 i = 1; i <= 1000; ++i)
+        histogram.record(i);
+
+    const QEventLoopHistogram::Summary summary = histogram.summary();
+    QCOMPARE(summary.count, 1000u);
+    QCOMPARE(summary.total, 500500u);
+    QCOMPARE(summary.max, 1000u);
+    // within the precision of the buckets, rounded up
+    QCOMPARE_GE(summary.p50, 500u);
+    QCOMPARE_LE(summary.p50, 500u * 9 / 8);
+    QCOMPARE_GE(summary.p90, 900u);
+    QCOMPARE_LE(summary.p90, 1000u);
+    QCOMPARE_GE(summary.p99, 990u);
+    QCOMPARE_LE(summary.p99, 1000u);
+
+    histogram.reset();
+    QCOMPARE(histogram.summary().count, 0u);
+    QCOMPARE(histogram.summary().max, 0u);
+}
+
+void tst_QEventLoopProfiler::disabled()
+{
+    QEventLoopProfiler::setEnabled(false);
+    QVERIFY(!QEventLoopProfiler::isEnabled());
+
+    Receiver receiver;
+    QEvent event(QEvent::User);
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(QEventLoopProfiler::dispatchTime(QEvent::User).count, 0u);
+    QCOMPARE(QEventLoopProfiler::dispatchTime(&Receiver::staticMetaObject).count, 0u);
+}
+
+void tst_QEventLoopProfiler::sendEvent()
+{
+    Receiver receiver;
+    QEvent event(QEvent::User);
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCoreApplication::sendEvent(&receiver, &event);
+
+    const QEventLoopHistogram::Summary byType = QEventLoopProfiler::dispatchTime(QEvent::User);
+    QCOMPARE(byType.count, 2u);
+    QCOMPARE_GE(byType.max, quint64(std::chrono::nanoseconds(2ms).count()));
+    QCOMPARE_GE(byType.total, quint64(std::chrono::nanoseconds(4ms).count()));
+
+    const QEventLoopHistogram::Summary byClass =
+            QEventLoopProfiler::dispatchTime(&Receiver::staticMetaObject);
+    QCOMPARE(byClass.count, 2u);
+    QCOMPARE(byClass.total, byType.total);
+}
+
+void tst_QEventLoopProfiler::deleteReceiver()
+{
+    auto receiver = new Receiver;
+    QEvent event(QEvent::Type(QEvent::User + 1));
+    QCoreApplication::sendEvent(receiver, &event);
+    QCOMPARE(QEventLoopProfiler::dispatchTime(&Receiver::staticMetaObject).count, 1u);
+}
+
+void tst_QEventLoopProfiler::allocatedMetaObject()
+{
+    // recorded as the class it derives from, which outlives it
+    {
+        AllocatedReceiver receiver;
+        QCOMPARE(receiver.metaObject()->superClass(), &Receiver::staticMetaObject);
+        QEvent event(QEvent::User);
+        QCoreApplication::sendEvent(&receiver, &event);
+    }
+    QCOMPARE(QEventLoopProfiler::dispatchTime(&Receiver::staticMetaObject).count, 1u);
+    for (const QJsonValue &entry : QEventLoopProfiler::report()["dispatchTimeByReceiverClass"_L1].toArray())
+        QCOMPARE(entry["class"_L1].toString(), u"Receiver"_s);
+}
+
+void tst_QEventLoopProfiler::postEvent()
+{
+    Receiver receiver;
+    for (int i = 0; i < 10; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+
+    QEventLoopHistogram::Summary depth = QEventLoopProfiler::postedEventQueueDepth();
+    QCOMPARE(depth.count, 10u);
+    QCOMPARE_GE(depth.max, 10u);
+
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::User);
+    QCOMPARE(QEventLoopProfiler::dispatchTime(QEvent::User).count, 10u);
+}
+
+void tst_QEventLoopProfiler::timerLateness()
+{
+    int fired = 0;
+    QTimer timer;
+    timer.setTimerType(Qt::PreciseTimer);
+    timer.setInterval(1ms);
+    connect(&timer, &QTimer::timeout, this, [&] {
+        // block the event loop, so that the next timeout is late
+        QTest::qSleep(5);
+        ++fired;
+    });
+    timer.start();
+    QTRY_VERIFY(fired >= 3);
+    timer.stop();
+
+    const QEventLoopHistogram::Summary lateness = QEventLoopProfiler::timerLateness();
+    QCOMPARE_GE(lateness.count, 3u);
+    QCOMPARE_GE(lateness.max, quint64(std::chrono::nanoseconds(3ms).count()));
+    QCOMPARE_GE(QEventLoopProfiler::dispatchTime(QEvent::Timer).count, 3u);
+}
+
+void tst_QEventLoopProfiler::report()
+{
+    Receiver receiver;
+    QEvent event(QEvent::User);
+    QCoreApplication::sendEvent(&receiver, &event);
+
+    const QJsonObject report = QEventLoopProfiler::report();
+
+    auto find = [](const QJsonArray &entries, QLatin1StringView key, const QJsonValue &value) {
+        for (const QJsonValue &entry : entries) {
+            if (entry[key] == value)
+                return entry.toObject();
+        }
+        return QJsonObject();
+    };
+
+    const QJsonObject byType =
+            find(report["dispatchTimeByEventType"_L1].toArray(), "name"_L1, u"User"_s);
+    QCOMPARE(byType["type"_L1].toInt(), int(QEvent::User));
+    QCOMPARE(byType["count"_L1].toInteger(), 1);
+    QCOMPARE_GE(byType["p99"_L1].toInteger(), std::chrono::nanoseconds(2ms).count());
+
+    const QJsonObject byClass =
+            find(report["dispatchTimeByReceiverClass"_L1].toArray(), "class"_L1, u"Receiver"_s);
+    QCOMPARE(byClass["count"_L1].toInteger(), 1);
+
+    QVERIFY(report["postedEventQueueDepth"_L1].isObject());
+    QVERIFY(report["timerLateness"_L1].isObject());
+}
+
+QTEST_MAIN(tst_QEventLoopProfiler)
+#include "tst_qeventloopprofiler.moc"
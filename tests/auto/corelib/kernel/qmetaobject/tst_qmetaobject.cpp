@@ -335,6 +335,8 @@ private slots:
 
     void firstMethod_data();
     void firstMethod();
+    void lookupTables_data();
+    void lookupTables();
 
     void indexOfMethodPMF();
 
@@ -2752,6 +2754,66 @@ void tst_QMetaObject::firstMethod()
     QCOMPARE(firstMethod, method);
 }
 
+void tst_QMetaObject::lookupTables_data()
+{
+    QTest::addColumn<const QMetaObject *>("metaObject");
+    QTest::addColumn<bool>("hasLookupTables");
+
+    QTest::newRow("tst_QMetaObject") << &tst_QMetaObject::staticMetaObject << true;
+    QTest::newRow("QtTestObject") << &QtTestObject::staticMetaObject << true;
+    QTest::newRow("Derived") << &Derived::staticMetaObject << false;
+    QTest::newRow("QObject") << &QObject::staticMetaObject << false;
+}
+
+void tst_QMetaObject::lookupTables()
+{
+    QFETCH(const QMetaObject *, metaObject);
+    QFETCH(bool, hasLookupTables);
+
+    // the classes with enough methods and properties have tables
+    QCOMPARE(QMetaObjectPrivate::get(metaObject)->lookupData != 0, hasLookupTables);
+
+    // same results as searching each class, from the most derived one, for
+    // the method with the highest index and the property with the lowest one
+    auto expectedMethodIndex = [&](const QByteArray &signature) {
+        for (const QMetaObject *m = metaObject; m; m = m->superClass()) {
+            for (int i = m->methodCount() - 1; i >= m->methodOffset(); --i) {
+                if (m->method(i).methodSignature() == signature)
+                    return i;
+            }
+        }
+        return -1;
+    };
+    auto expectedPropertyIndex = [&](const QByteArray &name) {
+        for (const QMetaObject *m = metaObject; m; m = m->superClass()) {
+            for (int i = m->propertyOffset(); i < m->propertyCount(); ++i) {
+                if (name == m->property(i).name())
+                    return i;
+            }
+        }
+        return -1;
+    };
+
+    for (int i = 0; i < metaObject->methodCount(); ++i) {
+        const QMetaMethod method = metaObject->method(i);
+        const QByteArray signature = method.methodSignature();
+        QCOMPARE(metaObject->indexOfMethod(signature), expectedMethodIndex(signature));
+        if (method.methodType() == QMetaMethod::Signal)
+            QCOMPARE(metaObject->indexOfSignal(signature), expectedMethodIndex(signature));
+        QCOMPARE(QMetaObjectPrivate::firstMethod(metaObject, method.name()).name(), method.name());
+    }
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QByteArray name = metaObject->property(i).name();
+        QCOMPARE(metaObject->indexOfProperty(name), expectedPropertyIndex(name));
+    }
+
+    QCOMPARE(metaObject->indexOfMethod("notAMethod()"), -1);
+    QCOMPARE(metaObject->indexOfMethod("deleteLater(int)"), -1);
+    QCOMPARE(metaObject->indexOfSignal("deleteLater()"), -1);
+    QCOMPARE(metaObject->indexOfProperty("notAProperty"), -1);
+    QVERIFY(!QMetaObjectPrivate::firstMethod(metaObject, "notAMethod").isValid());
+}
+
 void tst_QMetaObject::indexOfMethodPMF()
 {
 #define INDEXOFMETHODPMF_HELPER(ObjectType, Name, Arguments)  { \
@@ -107,6 +107,8 @@ private slots:
     void convertCustomType_data();
     void convertCustomType();
     void convertConstNonConst();
+    void unregisterConverter();
+    void unregisterDynamicType();
     void compareCustomEqualOnlyType();
     void customDebugStream();
     void unknownType();
@@ -319,6 +319,92 @@ void tst_QMetaType::convertConstNonConst()
     QVERIFY(QMetaType::canConvert(mtObj, mtConstDerived));
 }
 
+struct UnregisteredFrom {};
+struct UnregisteredTo {};
+
+void tst_QMetaType::unregisterConverter()
+{
+    const QMetaType from = QMetaType::fromType<UnregisteredFrom>();
+    const QMetaType to = QMetaType::fromType<UnregisteredTo>();
+    const auto alive = std::make_shared<int>();
+
+    QVERIFY(QMetaType::registerConverterFunction([alive](const void *, void *) {
+        return true;
+    }, from, to));
+    QVERIFY(QMetaType::registerMutableViewFunction([alive](void *, void *) {
+        return true;
+    }, from, to));
+    QVERIFY(QMetaType::canConvert(from, to));
+    QVERIFY(QMetaType::canView(from, to));
+    QCOMPARE(alive.use_count(), 3);
+
+    // the functions are destroyed right away, as they may come from a plugin
+    QMetaType::unregisterConverterFunction(from, to);
+    QVERIFY(!QMetaType::canConvert(from, to));
+    QCOMPARE(alive.use_count(), 2);
+    QMetaType::unregisterMutableViewFunction(from, to);
+    QVERIFY(!QMetaType::canView(from, to));
+    QCOMPARE(alive.use_count(), 1);
+
+    // and can be registered again
+    for (int i = 0; i < 3; ++i) {
+        int calls = 0;
+        QVERIFY(QMetaType::registerConverterFunction([&calls](const void *, void *) {
+            ++calls;
+            return true;
+        }, from, to));
+        UnregisteredFrom fromValue;
+        UnregisteredTo toValue;
+        QVERIFY(QMetaType::convert(from, &fromValue, to, &toValue));
+        QCOMPARE(calls, 1);
+        QMetaType::unregisterConverterFunction(from, to);
+        QVERIFY(!QMetaType::canConvert(from, to));
+    }
+}
+
+void tst_QMetaType::unregisterDynamicType()
+{
+    struct DynamicType : QtPrivate::QMetaTypeInterface
+    {
+        explicit DynamicType(const char *name)
+            : QtPrivate::QMetaTypeInterface {
+                0, alignof(int), sizeof(int), QMetaType::RelocatableType, 0, nullptr,
+                name,
+                nullptr, nullptr, nullptr, nullptr,
+                nullptr, nullptr, nullptr,
+                nullptr, nullptr, nullptr
+            }
+        {}
+    };
+    static const char name[] = "tst_QMetaType::DynamicType";
+    DynamicType type(name);
+    const int id = QMetaType(&type).id();
+    QCOMPARE_GE(id, int(QMetaType::User));
+    QMetaType::unregisterMetaType(QMetaType(&type));
+    QVERIFY(!QMetaType::fromName(name).isValid());
+
+    // the lookups don't lock, look the type up while it comes and goes
+    std::atomic<bool> done = false;
+    std::atomic<int> wrong = 0;
+    std::unique_ptr<QThread> reader(QThread::create([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            const QMetaType found = QMetaType::fromName(name);
+            if (found.isValid() && found.iface() != &type)
+                ++wrong;
+        }
+    }));
+    reader->start();
+    for (int i = 0; i < 10000; ++i) {
+        QCOMPARE(QMetaType(&type).id(), id);
+        QCOMPARE(QMetaType::fromName(name).id(), id);
+        QMetaType::unregisterMetaType(QMetaType(&type));
+        QVERIFY(!QMetaType::fromName(name).isValid());
+    }
+    done = true;
+    QVERIFY(reader->wait());
+    QCOMPARE(wrong.load(), 0);
+}
+
 void tst_QMetaType::compareCustomEqualOnlyType()
 {
     QMetaType type = QMetaType::fromType<CustomEqualsOnlyType>();
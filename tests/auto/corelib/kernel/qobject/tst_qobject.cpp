@@ -36,6 +36,7 @@
 #endif
 
 #include <functional>
+#include <memory>
 
 #include <math.h>
 
@@ -86,6 +87,7 @@ private slots:
     void installEventFilter();
     void installEventFilterOrder();
     void deleteSelfInSlot();
+    void deleteContextInFunctor();
     void disconnectSelfInSlotAndDeleteAfterEmit();
     void dumpObjectInfo();
     void dumpObjectTree();
@@ -3530,6 +3532,59 @@ void tst_QObject::deleteSelfInSlot()
     }
 }
 
+void tst_QObject::deleteContextInFunctor()
+{
+    // the functor must outlive its call when it deletes its context
+    struct Captured
+    {
+        explicit Captured(int *destroyed) : destroyed(destroyed) {}
+        ~Captured() { ++*destroyed; }
+        int *destroyed;
+        int value = 42;
+    };
+
+    {
+        int destroyed = 0;
+        SenderObject sender;
+        QObject *context = new QObject;
+        auto captured = std::make_shared<Captured>(&destroyed);
+        int value = 0;
+        connect(&sender, &SenderObject::signal1, context, [&, context, captured] {
+            delete context;
+            QCOMPARE(destroyed, 0);
+            value = captured->value;
+        });
+        captured.reset();
+        sender.emitSignal1();
+        QCOMPARE(value, 42);
+        QCOMPARE(destroyed, 1);
+    }
+
+    {
+        // deleted by a nested emission: kept until the outer call returns
+        int destroyed = 0;
+        SenderObject sender;
+        QObject *context = new QObject;
+        auto captured = std::make_shared<Captured>(&destroyed);
+        int calls = 0;
+        int value = 0;
+        connect(&sender, &SenderObject::signal1, context, [&, context, captured] {
+            if (calls++ == 0) {
+                sender.emitSignal1();
+                QCOMPARE(destroyed, 0);
+                value = captured->value;
+            } else {
+                delete context;
+            }
+        });
+        captured.reset();
+        sender.emitSignal1();
+        QCOMPARE(calls, 2);
+        QCOMPARE(value, 42);
+        QCOMPARE(destroyed, 1);
+    }
+}
+
 class DisconnectObject : public QObject
 {
     Q_OBJECT
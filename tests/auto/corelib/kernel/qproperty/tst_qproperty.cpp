@@ -90,7 +90,10 @@ private slots:
 
     void bindablePropertyWithInitialization();
     void noDoubleNotification();
+    void noDoubleEvaluation();
+    void dependencyAddedDuringEvaluation();
     void groupedNotifications();
+    void groupedEvaluation();
     void groupedNotificationConsistency();
     void bindingGroupMovingBindingData();
     void bindingGroupBindingDeleted();
@@ -2193,6 +2196,75 @@ void tst_QProperty::noDoubleNotification()
     QCOMPARE(nNotifications, 3);
 }
 
+void tst_QProperty::noDoubleEvaluation()
+{
+    /* dependency graph for this test
+       x --> y means y depends on x
+      a-->b-->d-->e
+      \       ^
+       \->c--/
+    */
+    QProperty<int> a(0);
+    QProperty<int> b;
+    b.setBinding([&](){ return a.value(); });
+    QProperty<int> c;
+    c.setBinding([&](){ return a.value() / 10; });
+    int dEvaluations = 0;
+    QProperty<int> d;
+    d.setBinding([&](){ ++dEvaluations; return b.value() + c.value(); });
+    int eEvaluations = 0;
+    QProperty<int> e;
+    e.setBinding([&](){ ++eEvaluations; return d.value() * 2; });
+    QCOMPARE(dEvaluations, 1);
+    QCOMPARE(eEvaluations, 1);
+
+    a = 10;
+    QCOMPARE(d.value(), 11);
+    QCOMPARE(e.value(), 22);
+    QCOMPARE(dEvaluations, 2);
+    QCOMPARE(eEvaluations, 2);
+
+    // only b changes
+    a = 11;
+    QCOMPARE(d.value(), 12);
+    QCOMPARE(e.value(), 24);
+    QCOMPARE(dEvaluations, 3);
+    QCOMPARE(eEvaluations, 3);
+
+    // f doesn't change, so g isn't evaluated
+    QProperty<int> f;
+    f.setBinding([&](){ return b.value() - a.value(); });
+    int gEvaluations = 0;
+    QProperty<int> g;
+    g.setBinding([&](){ ++gEvaluations; return f.value(); });
+    a = 12;
+    QCOMPARE(g.value(), 0);
+    QCOMPARE(gEvaluations, 1);
+    QCOMPARE(dEvaluations, 4);
+}
+
+void tst_QProperty::dependencyAddedDuringEvaluation()
+{
+    QProperty<int> a(0);
+    QProperty<int> b;
+    b.setBinding([&](){ return a.value() * 10; });
+    QProperty<int> c;
+    // starts depending on b when a changes, whichever is evaluated first
+    c.setBinding([&](){ return a.value() ? b.value() + 1 : 0; });
+    QProperty<int> d;
+    d.setBinding([&](){ return c.value() + b.value(); });
+    QCOMPARE(c.value(), 0);
+
+    a = 1;
+    QCOMPARE(b.value(), 10);
+    QCOMPARE(c.value(), 11);
+    QCOMPARE(d.value(), 21);
+
+    a = 2;
+    QCOMPARE(c.value(), 21);
+    QCOMPARE(d.value(), 41);
+}
+
 void tst_QProperty::groupedNotifications()
 {
     QProperty<int> a(0);
@@ -2243,6 +2315,39 @@ void tst_QProperty::groupedNotifications()
 
 }
 
+void tst_QProperty::groupedEvaluation()
+{
+    QProperty<int> a(0);
+    QProperty<int> b(0);
+    QProperty<int> c;
+    c.setBinding([&](){ return a.value() + b.value(); });
+    int dEvaluations = 0;
+    QProperty<int> d;
+    d.setBinding([&](){ ++dEvaluations; return a.value() + c.value(); });
+    QCOMPARE(dEvaluations, 1);
+
+    {
+        const QScopedPropertyUpdateGroup guard;
+        a = 1;
+        b = 2;
+        QCOMPARE(dEvaluations, 1);
+    }
+    QCOMPARE(c.value(), 3);
+    QCOMPARE(d.value(), 4);
+    QCOMPARE(dEvaluations, 2);
+
+    // the binding loop is still reported
+    QProperty<int> e;
+    QProperty<int> f;
+    e.setBinding([&](){ return a.value() + f.value(); });
+    f.setBinding([&](){ return e.value(); });
+    {
+        const QScopedPropertyUpdateGroup guard;
+        a = 5;
+    }
+    QCOMPARE(e.binding().error().type(), QPropertyBindingError::BindingLoop);
+}
+
 void tst_QProperty::groupedNotificationConsistency()
 {
     QProperty<int> i(0);
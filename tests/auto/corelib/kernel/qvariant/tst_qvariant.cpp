@@ -827,6 +827,22 @@ void tst_QVariant::convert()
    var.convert(QMetaType::fromType<int>());
    QCOMPARE(var.metaType(), QMetaType::fromType<int>());
    QCOMPARE(var.toInt(), 0);
+
+   // the copies of a converted variant keep the old value
+   QVariant number = QVariant::fromValue(QString("42"));
+   QVariant copy = number;
+   QVERIFY(number.convert(QMetaType::fromType<int>()));
+   QCOMPARE(number, QVariant(42));
+   QCOMPARE(copy, QVariant(QString("42")));
+
+   QVariant rect = QVariant::fromValue(QRectF(1.5, 2, 3, 4));
+   copy = rect;
+   QVERIFY(rect.convert(QMetaType::fromType<QRect>()));
+   QCOMPARE(rect, QVariant(QRect(2, 2, 3, 4)));
+   QCOMPARE(copy, QVariant(QRectF(1.5, 2, 3, 4)));
+   QVERIFY(!copy.convert(QMetaType::fromType<QLineF>()));
+   QCOMPARE(copy.metaType(), QMetaType::fromType<QLineF>());
+   QVERIFY(copy.isNull());
 }
 
 void tst_QVariant::toInt_data()
@@ -22,6 +22,11 @@
 #include <QtCore/QTextStream>
 #include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/private/qduplicatetracker_p.h>
+#ifdef QT_BUILD_INTERNAL
+#  include <QtCore/QXmlStreamReader>
+#  include <QtCore/QtEndian>
+#  include <QtCore/private/qmimeprovider_p.h>
+#endif
 
 #include <QTest>
 #include <QBuffer>
@@ -622,6 +627,198 @@ void tst_QMimeDatabase::mimeTypeForFileWithContent()
     QVERIFY(mime.isDefault());
 }
 
+void tst_QMimeDatabase::mimeTypesForFiles_data()
+{
+    QTest::addColumn<int>("mode");
+
+    QTest::newRow("default") << int(QMimeDatabase::MatchDefault);
+    QTest::newRow("extension") << int(QMimeDatabase::MatchExtension);
+    QTest::newRow("content") << int(QMimeDatabase::MatchContent);
+}
+
+void tst_QMimeDatabase::mimeTypesForFiles()
+{
+    QFETCH(int, mode);
+    const auto matchMode = QMimeDatabase::MatchMode(mode);
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const auto writeFile = [&dir](const QString &name, const QByteArray &contents) {
+        QFile file(dir.filePath(name));
+        if (!file.open(QIODevice::WriteOnly) || file.write(contents) != contents.size())
+            return QString();
+        return file.fileName();
+    };
+
+    QStringList fileNames;
+    for (int i = 0; i < 20; ++i) {
+        fileNames << writeFile(u"pdf%1"_s.arg(i), "%PDF-")
+                  << writeFile(u"pdf%1.txt"_s.arg(i), "%PDF-")
+                  << writeFile(u"text%1"_s.arg(i), "Hello world\n")
+                  << writeFile(u"binary%1.qml"_s.arg(i), QByteArray("\x01\x02\x03", 3))
+                  << writeFile(u"empty%1"_s.arg(i), QByteArray());
+    }
+    QVERIFY(!fileNames.contains(QString()));
+    QVERIFY(QDir(dir.path()).mkdir(u"directory.txt"_s));
+    fileNames << dir.filePath(u"directory.txt"_s)
+              << dir.filePath(u"does-not-exist.pdf"_s)
+              << dir.filePath(u"does-not-exist"_s)
+              << u":/files/test.txt"_s
+              << s_additionalFilesResourcePrefix + "magic-and-hierarchy.foo"_L1;
+
+    QMimeDatabase db;
+    const QList<QMimeType> mimes = db.mimeTypesForFiles(fileNames, matchMode);
+    QCOMPARE(mimes.size(), fileNames.size());
+    for (qsizetype i = 0; i < fileNames.size(); ++i) {
+        const QMimeType expected = db.mimeTypeForFile(fileNames.at(i), matchMode);
+        QVERIFY2(mimes.at(i) == expected,
+                 qPrintable(fileNames.at(i) + ": "_L1 + mimes.at(i).name()
+                            + " != "_L1 + expected.name()));
+    }
+
+    if (matchMode != QMimeDatabase::MatchExtension) {
+        QCOMPARE(mimes.at(0).name(), "application/pdf"_L1);
+        QCOMPARE(mimes.at(fileNames.indexOf(dir.filePath(u"directory.txt"_s))).name(),
+                 s_inodeMimetype);
+    }
+
+    QVERIFY(db.mimeTypesForFiles(QStringList(), matchMode).isEmpty());
+}
+
+#ifdef QT_BUILD_INTERNAL
+// Unescapes the value of a <match type="string">, like QMimeMagicRule does
+static QByteArray unescapeMagicString(const QByteArray &value)
+{
+    QByteArray result;
+    for (qsizetype i = 0; i < value.size(); ++i) {
+        const char c = value.at(i);
+        if (c != '\\' || i + 1 == value.size()) {
+            result += c;
+            continue;
+        }
+        const char next = value.at(++i);
+        if (next == 'x') {
+            qsizetype end = i + 1;
+            while (end < value.size() && end < i + 3 && isxdigit(uchar(value.at(end))))
+                ++end;
+            result += char(value.mid(i + 1, end - i - 1).toUInt(nullptr, 16));
+            i = end - 1;
+        } else if (next >= '0' && next <= '7') {
+            qsizetype end = i;
+            while (end < value.size() && end < i + 3 && value.at(end) >= '0' && value.at(end) <= '7')
+                ++end;
+            result += char(value.mid(i, end - i).toUInt(nullptr, 8));
+            i = end - 1;
+        } else {
+            static const char escapes[] = "n\nr\rt\tb\bf\fv\va\a";
+            const char *escape = strchr(escapes, next);
+            result += escape && (escape - escapes) % 2 == 0 ? escape[1] : next;
+        }
+    }
+    return result;
+}
+
+// Returns data that satisfies the <match> the reader is at, on top of
+// \a base, or a null QByteArray for types that aren't handled here.
+static QByteArray sampleForMatch(const QXmlStreamAttributes &attributes, const QByteArray &base)
+{
+    const QString type = attributes.value("type"_L1).toString();
+    const QByteArray value = attributes.value("value"_L1).toLatin1();
+    const qsizetype offset = attributes.value("offset"_L1).toString().section(u':', 0, 0).toInt();
+
+    QByteArray bytes;
+    bool ok = true;
+    const uint number = type == "string"_L1 ? 0 : value.toUInt(&ok, 0);
+    if (type == "string"_L1) {
+        bytes = unescapeMagicString(value);
+    } else if (type == "byte"_L1) {
+        bytes = QByteArray(1, char(number));
+    } else if (type == "big16"_L1 || type == "little16"_L1 || type == "host16"_L1) {
+        const quint16 n = type == "big16"_L1 ? qToBigEndian(quint16(number))
+                        : type == "little16"_L1 ? qToLittleEndian(quint16(number))
+                        : quint16(number);
+        bytes = QByteArray(reinterpret_cast<const char *>(&n), sizeof(n));
+    } else if (type == "big32"_L1 || type == "little32"_L1 || type == "host32"_L1) {
+        const quint32 n = type == "big32"_L1 ? qToBigEndian(quint32(number))
+                        : type == "little32"_L1 ? qToLittleEndian(quint32(number))
+                        : quint32(number);
+        bytes = QByteArray(reinterpret_cast<const char *>(&n), sizeof(n));
+    }
+    if (bytes.isEmpty() || !ok)
+        return QByteArray();
+
+    QByteArray sample = base;
+    if (sample.size() < offset + bytes.size())
+        sample.resize(offset + bytes.size(), ' ');
+    sample.replace(offset, bytes.size(), bytes);
+    return sample;
+}
+
+void tst_QMimeDatabase::magicIndex()
+{
+    // the shared MIME database from freedesktop.org
+    const QString xmlFileName = QFINDTESTDATA("../3rdparty/freedesktop.org.xml");
+    if (xmlFileName.isEmpty())
+        QSKIP("freedesktop.org.xml not found");
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    QVERIFY(QDir(dir.path()).mkdir(u"packages"_s));
+    QString errorMessage;
+    QVERIFY2(copyResourceFile(xmlFileName, dir.filePath(u"packages/freedesktop.org.xml"_s),
+                              &errorMessage),
+             qPrintable(errorMessage));
+    QMimeXMLProvider provider(nullptr, dir.path());
+
+    // Data for every <match> in the database, built on the data for the
+    // enclosing ones, and some variations of it.
+    QList<QByteArray> samples = { QByteArray(), QByteArray(1, '\0'), "Hello world\n"_ba };
+    {
+        QFile file(xmlFileName);
+        QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(file.errorString()));
+        QXmlStreamReader reader(&file);
+        QList<QByteArray> enclosing;
+        while (!reader.atEnd()) {
+            reader.readNext();
+            if (reader.name() != "match"_L1)
+                continue;
+            if (reader.isEndElement()) {
+                enclosing.removeLast();
+                continue;
+            }
+            if (!reader.isStartElement())
+                continue;
+            const QByteArray base = enclosing.isEmpty() ? QByteArray() : enclosing.constLast();
+            QByteArray sample = sampleForMatch(reader.attributes(), base);
+            if (sample.isNull())
+                sample = base;
+            enclosing.append(sample);
+            samples << sample << sample + QByteArray(64, '\0') << sample.left(sample.size() - 1);
+            if (!sample.isEmpty())
+                samples << char(~sample.at(0)) + sample.mid(1);
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    }
+    QVERIFY(samples.size() > 1000);
+
+    qsizetype matched = 0;
+    for (const QByteArray &sample : std::as_const(samples)) {
+        QMimeMagicResult indexed;
+        provider.findByMagic(sample, indexed);
+        QMimeMagicResult unindexed;
+        provider.findByMagicWithoutIndex(sample, unindexed);
+        QVERIFY2(indexed.candidate == unindexed.candidate
+                         && indexed.accuracy == unindexed.accuracy,
+                 qPrintable(QString::fromLatin1(sample.left(32).toHex(' ')) + u": "_s
+                            + indexed.candidate + u" != "_s + unindexed.candidate));
+        if (indexed.isValid())
+            ++matched;
+    }
+    // most of the samples must match something for the comparison to be useful
+    QVERIFY(matched > samples.size() / 4);
+}
+#endif
+
 void tst_QMimeDatabase::mimeTypeForUrl()
 {
     QMimeDatabase db;
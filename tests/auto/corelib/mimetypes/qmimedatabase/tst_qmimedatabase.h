@@ -32,6 +32,11 @@ private slots:
     void icons();
     void comment();
     void mimeTypeForFileWithContent();
+    void mimeTypesForFiles_data();
+    void mimeTypesForFiles();
+#ifdef QT_BUILD_INTERNAL
+    void magicIndex();
+#endif
     void mimeTypeForUrl();
     void mimeTypeForData_data();
     void mimeTypeForData();
@@ -56,6 +56,7 @@ private slots:
     void readLineMaxlen();
     void readLinesFromBufferCRCR();
     void readLineInto();
+    void readLineView();
 
     // all
     void readAllFromDevice_data();
@@ -642,6 +643,48 @@ void tst_QTextStream::readLineInto()
     QVERIFY(line.isEmpty());
 }
 
+void tst_QTextStream::readLineView()
+{
+    QByteArray data = "1\r\n\n3";
+
+    QTextStream ts(&data);
+    QStringView line = ts.readLineView();
+    QCOMPARE(line, QStringView(u"1"));
+    line = ts.readLineView();
+    QVERIFY(!line.isNull());
+    QVERIFY(line.isEmpty());
+    QCOMPARE(ts.readLineView(), QStringView(u"3"));
+    QVERIFY(ts.readLineView().isNull());
+
+    QString string = QStringLiteral("a\nccc");
+    ts.setString(&string, QIODevice::ReadOnly);
+    QCOMPARE(ts.readLineView(2), QStringView(u"a"));
+    QCOMPARE(ts.readLineView(2), QStringView(u"cc"));
+    QCOMPARE(ts.readLineView(2), QStringView(u"c"));
+    QVERIFY(ts.readLineView().isNull());
+
+    // compare against readLine() on a file bigger than the internal buffers
+    QFile file(m_rfc3261FilePath);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QStringList expected = QString::fromLatin1(file.readAll()).split(u'\n');
+    QVERIFY(file.seek(0));
+    ts.setDevice(&file);
+    qsizetype i = 0;
+    for (line = ts.readLineView(); !line.isNull(); line = ts.readLineView(), ++i) {
+        QVERIFY(i < expected.size());
+        QString expectedLine = expected.at(i);
+        if (expectedLine.endsWith(u'\r'))
+            expectedLine.chop(1);
+        QCOMPARE(line, expectedLine);
+    }
+    QCOMPARE(i, expected.last().isEmpty() ? expected.size() - 1 : expected.size());
+
+    ErrorDevice errorDevice;
+    QVERIFY(errorDevice.open(QIODevice::ReadOnly));
+    ts.setDevice(&errorDevice);
+    QVERIFY(ts.readLineView().isNull());
+}
+
 // ------------------------------------------------------------------------------
 void tst_QTextStream::readLineFromString_data()
 {
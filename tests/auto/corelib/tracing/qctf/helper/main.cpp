@@ -0,0 +1,52 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <private/qctf_p.h>
+
+#include <limits>
+#include <memory>
+
+QT_USE_NAMESPACE
+
+TRACEPOINT_PROVIDER(qtctftest);
+TRACEPOINT_EVENT(qtctftest, qtctftest_event, QStringLiteral("int32_t value;"), sizeof(qint32),
+                 false);
+
+// more than fit in the ring of the main thread
+static constexpr qint32 MainEvents = 100000;
+static constexpr qint32 WorkerEvents = 1000;
+
+static int overflowStack(qint32 depth)
+{
+    volatile char frame[512];
+    frame[0] = char(depth);
+    tracepoint(qtctftest, qtctftest_event, depth);
+    if (depth == std::numeric_limits<qint32>::max())
+        return 0;
+    return overflowStack(depth + 1) + frame[0];
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    if (!tracepoint_enabled(qtctftest, qtctftest_event))
+        return 2;
+
+    std::unique_ptr<QThread> worker(QThread::create([] {
+        for (qint32 i = 0; i < WorkerEvents; ++i)
+            tracepoint(qtctftest, qtctftest_event, i);
+    }));
+    worker->setObjectName("worker");
+    worker->start();
+    worker->wait();
+
+    for (qint32 i = 0; i < MainEvents; ++i)
+        tracepoint(qtctftest, qtctftest_event, i);
+
+    if (argc > 1 && qstrcmp(argv[1], "overflow") == 0)
+        return overflowStack(0);
+    return _dump_flight_recorder() ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QUuid>
+#include <QtEndian>
+
+using namespace Qt::StringLiterals;
+
+class tst_QCtf : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void dump();
+    void stackOverflow();
+
+private:
+    struct Event
+    {
+        quint32 id;
+        quint64 timestamp;
+        qint32 value;
+    };
+    struct Channel
+    {
+        QByteArray threadName;
+        quint32 threadId = 0;
+        quint64 firstSequence = 0;
+        QList<Event> events;
+    };
+
+    void runHelper(const QStringList &arguments, QProcess::ExitStatus expectedStatus);
+    void readChannels(QList<Channel> *channels);
+    void readChannel(const QByteArray &contents, const QUuid &uuid, Channel *channel);
+
+    QTemporaryDir m_location;
+};
+
+// what the helper traces, see helper/main.cpp
+static constexpr qint32 MainEvents = 100000;
+static constexpr qint32 WorkerEvents = 1000;
+
+// the layout of the packets, see metadata_template.txt
+static constexpr qsizetype PacketSize = 4096;
+static constexpr qsizetype PacketHeaderSize = 4 + 16 + 4 + 6 * 8 + 4;
+static constexpr qsizetype EventSize = 4 + 8 + 4;
+static constexpr quint32 HeaderMagic = 0xC1FC1FC1;
+
+void tst_QCtf::initTestCase()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#endif
+    QVERIFY(m_location.isValid());
+    QFile session(m_location.filePath(u"session.json"_s));
+    QVERIFY(session.open(QIODevice::WriteOnly));
+    session.write(R"({ "test": [ "qtctftest" ] })");
+}
+
+void tst_QCtf::runHelper(const QStringList &arguments, QProcess::ExitStatus expectedStatus)
+{
+    QDir(m_location.filePath(u"ust"_s)).removeRecursively();
+
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert(u"QTRACE_LOCATION"_s, m_location.path());
+    environment.insert(u"QTRACE_FLIGHT_RECORDER"_s, u"60"_s);
+
+    QProcess process;
+    process.setProcessEnvironment(environment);
+    process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process.start(QCoreApplication::applicationDirPath() + "/qctf_helper"_L1, arguments);
+    QVERIFY2(process.waitForStarted(), qPrintable(process.errorString()));
+    QVERIFY(process.waitForFinished(60000));
+    if (process.exitStatus() == QProcess::NormalExit && process.exitCode() == 2)
+        QSKIP("The CTF tracing plugin could not be loaded");
+    QCOMPARE(process.exitStatus(), expectedStatus);
+    if (expectedStatus == QProcess::NormalExit)
+        QCOMPARE(process.exitCode(), 0);
+}
+
+void tst_QCtf::readChannels(QList<Channel> *channels)
+{
+    const QDir ust(m_location.filePath(u"ust"_s));
+    QFile metadata(ust.filePath(u"metadata"_s));
+    QVERIFY(metadata.open(QIODevice::ReadOnly));
+    // the trace block comes before the clock, which has a uuid too
+    const QRegularExpressionMatch match =
+            QRegularExpression(u"uuid = \"([-0-9a-fA-F]+)\""_s).match(metadata.readAll());
+    QVERIFY(match.hasMatch());
+    const QUuid uuid(match.captured(1));
+    QVERIFY(!uuid.isNull());
+
+    const QStringList files = ust.entryList({ u"channel_*"_s }, QDir::Files, QDir::Name);
+    QVERIFY(!files.isEmpty());
+    for (const QString &fileName : files) {
+        QFile file(ust.filePath(fileName));
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        Channel channel;
+        readChannel(file.readAll(), uuid, &channel);
+        if (QTest::currentTestFailed()) {
+            qWarning() << "in" << fileName;
+            return;
+        }
+        channels->append(std::move(channel));
+    }
+}
+
+void tst_QCtf::readChannel(const QByteArray &contents, const QUuid &uuid, Channel *channel)
+{
+    QVERIFY(!contents.isEmpty());
+    QCOMPARE(contents.size() % PacketSize, 0);
+
+    quint64 lastTimestamp = 0;
+    quint64 lastSequence = 0;
+    for (qsizetype offset = 0; offset < contents.size(); offset += PacketSize) {
+        const char *packet = contents.constData() + offset;
+        const auto read = [packet](qsizetype at, auto *value) {
+            *value = qFromLittleEndian<std::remove_pointer_t<decltype(value)>>(packet + at);
+        };
+
+        // the packet header
+        quint32 magic, streamId;
+        read(0, &magic);
+        QCOMPARE(magic, HeaderMagic);
+        QCOMPARE(QUuid::fromRfc4122(QByteArrayView(packet + 4, 16)), uuid);
+        read(20, &streamId);
+        QCOMPARE(streamId, 0u);
+
+        // the packet context
+        quint64 timestampBegin, timestampEnd, contentSize, packetSize, sequence, discarded;
+        quint32 threadId;
+        read(24, &timestampBegin);
+        read(32, &timestampEnd);
+        read(40, &contentSize);
+        read(48, &packetSize);
+        read(56, &sequence);
+        read(64, &discarded);
+        read(72, &threadId);
+        const QByteArray threadName(packet + PacketHeaderSize);
+        QCOMPARE_LE(timestampBegin, timestampEnd);
+        QCOMPARE_GE(timestampBegin, lastTimestamp);
+        QCOMPARE(packetSize, quint64(PacketSize) * 8);
+        QCOMPARE(contentSize % 8, 0u);
+        QCOMPARE_LE(contentSize, packetSize);
+        QCOMPARE(discarded, 0u);
+        if (offset == 0) {
+            channel->threadName = threadName;
+            channel->threadId = threadId;
+            channel->firstSequence = sequence;
+        } else {
+            QCOMPARE(sequence, lastSequence + 1);
+            QCOMPARE(threadName, channel->threadName);
+            QCOMPARE(threadId, channel->threadId);
+        }
+        lastSequence = sequence;
+
+        // the events, all of the type traced by the helper
+        const qsizetype eventsBegin = PacketHeaderSize + threadName.size() + 1;
+        const qsizetype eventsEnd = qsizetype(contentSize / 8);
+        QCOMPARE_LT(eventsBegin, eventsEnd);
+        QCOMPARE((eventsEnd - eventsBegin) % EventSize, 0);
+        for (qsizetype at = eventsBegin; at < eventsEnd; at += EventSize) {
+            Event event;
+            read(at, &event.id);
+            read(at + 4, &event.timestamp);
+            read(at + 12, &event.value);
+            QCOMPARE_GE(event.timestamp, timestampBegin);
+            QCOMPARE_LE(event.timestamp, timestampEnd);
+            QCOMPARE_GE(event.timestamp, lastTimestamp);
+            if (!channel->events.isEmpty())
+                QCOMPARE(event.id, channel->events.constFirst().id);
+            lastTimestamp = event.timestamp;
+            channel->events.append(event);
+        }
+        QCOMPARE(lastTimestamp, timestampEnd);
+    }
+}
+
+void tst_QCtf::dump()
+{
+    runHelper({}, QProcess::NormalExit);
+    QList<Channel> channels;
+    readChannels(&channels);
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(channels.size(), 2);
+
+    // all the events of the worker, which exited before the dump
+    const auto worker = std::find_if(channels.cbegin(), channels.cend(), [](const Channel &c) {
+        return c.threadName == "worker";
+    });
+    QVERIFY(worker != channels.cend());
+    QCOMPARE(worker->firstSequence, 1u);
+    QCOMPARE(worker->events.size(), WorkerEvents);
+    for (qint32 i = 0; i < WorkerEvents; ++i)
+        QCOMPARE(worker->events.at(i).value, i);
+
+    // the last events of the main thread, which overwrote the first ones
+    const Channel &main = channels.at(worker == channels.cbegin() ? 1 : 0);
+    QCOMPARE_NE(main.threadId, worker->threadId);
+    QCOMPARE_GT(main.firstSequence, 1u);
+    QCOMPARE_LT(main.events.size(), MainEvents);
+    QCOMPARE(main.events.constLast().value, MainEvents - 1);
+    for (qsizetype i = 1; i < main.events.size(); ++i)
+        QCOMPARE(main.events.at(i).value, main.events.at(i - 1).value + 1);
+}
+
+void tst_QCtf::stackOverflow()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("The flight recorder is only dumped on crashes on Unix");
+#else
+    // the signal handler runs on an alternate stack
+    runHelper({ u"overflow"_s }, QProcess::CrashExit);
+    QList<Channel> channels;
+    readChannels(&channels);
+    if (QTest::currentTestFailed())
+        return;
+
+    const auto main = std::find_if(channels.cbegin(), channels.cend(), [](const Channel &c) {
+        return c.threadName != "worker";
+    });
+    QVERIFY(main != channels.cend());
+    // the events of the recursion, after those of the loop
+    const QList<Event> &events = main->events;
+    const qint32 depth = events.constLast().value;
+    QCOMPARE_GT(depth, 1000);
+    QCOMPARE_GT(events.size(), depth);
+    for (qsizetype i = events.size() - depth; i < events.size(); ++i)
+        QCOMPARE(events.at(i).value, events.at(i - 1).value + 1);
+    QCOMPARE(events.at(events.size() - depth - 1).value, 0);
+#endif
+}
+
+QTEST_MAIN(tst_QCtf)
+
+#include "tst_qctf.moc"
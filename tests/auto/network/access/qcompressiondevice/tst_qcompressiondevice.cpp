@@ -0,0 +1,207 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QBuffer>
+#include <QtEndian>
+
+#include <QtNetwork/private/qcompressiondevice_p.h>
+
+class tst_QCompressionDevice : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void unsupportedEncoding();
+    void roundTrip_data();
+    void roundTrip();
+    void qUncompressCompatible();
+    void sequentialSource();
+    void corruptData();
+    void failingSink();
+};
+
+static QByteArray testData()
+{
+    QByteArray data;
+    for (int i = 0; i < 100000; ++i)
+        data += "line " + QByteArray::number(i) + " of the test data\n";
+    return data;
+}
+
+void tst_QCompressionDevice::unsupportedEncoding()
+{
+    QBuffer buffer;
+    QCompressingDevice compressor(&buffer);
+    QVERIFY(!compressor.setEncoding("identity"));
+    QVERIFY(!QCompressingDevice::isSupportedEncoding("identity"));
+    QVERIFY(!compressor.open(QIODevice::WriteOnly));
+
+    QDecompressingDevice decompressor(&buffer);
+    QVERIFY(!decompressor.setEncoding("identity"));
+    QVERIFY(!decompressor.open(QIODevice::ReadOnly));
+}
+
+void tst_QCompressionDevice::roundTrip_data()
+{
+    QTest::addColumn<QByteArray>("encoding");
+
+    QTest::newRow("deflate") << QByteArray("deflate");
+    QTest::newRow("gzip") << QByteArray("gzip");
+#if QT_CONFIG(zstd)
+    QTest::newRow("zstd") << QByteArray("zstd");
+#endif
+}
+
+void tst_QCompressionDevice::roundTrip()
+{
+    QFETCH(QByteArray, encoding);
+    const QByteArray data = testData();
+
+    QBuffer compressed;
+    QVERIFY(compressed.open(QIODevice::WriteOnly));
+    {
+        QCompressingDevice compressor(&compressed);
+        QVERIFY(compressor.setEncoding(encoding));
+        QVERIFY(compressor.open(QIODevice::WriteOnly));
+        // in pieces of odd sizes
+        for (qsizetype pos = 0; pos < data.size(); pos += 4093)
+            QCOMPARE(compressor.write(data.mid(pos, 4093)), qint64(data.mid(pos, 4093).size()));
+        QVERIFY2(compressor.finish(), qPrintable(compressor.errorString()));
+        QVERIFY(!compressor.isOpen());
+    }
+    compressed.close();
+    QVERIFY(compressed.size() > 0);
+    QVERIFY(compressed.size() < data.size() / 4);
+
+    QVERIFY(compressed.open(QIODevice::ReadOnly));
+    QDecompressingDevice decompressor(&compressed);
+    QVERIFY(decompressor.setEncoding(encoding));
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QVERIFY(decompressor.isSequential());
+    QCOMPARE(decompressor.readAll(), data);
+    QVERIFY(decompressor.atEnd());
+}
+
+void tst_QCompressionDevice::qUncompressCompatible()
+{
+    const QByteArray data = testData();
+
+    QBuffer compressed;
+    QVERIFY(compressed.open(QIODevice::WriteOnly));
+    QCompressingDevice compressor(&compressed);
+    QVERIFY(compressor.setEncoding("deflate"));
+    QVERIFY(compressor.open(QIODevice::WriteOnly));
+    QCOMPARE(compressor.write(data), qint64(data.size()));
+    compressor.close();
+
+    // qUncompress() expects the zlib format, prefixed with the size
+    QByteArray prefixed(4, Qt::Uninitialized);
+    qToBigEndian(quint32(data.size()), prefixed.data());
+    QCOMPARE(qUncompress(prefixed + compressed.data()), data);
+}
+
+void tst_QCompressionDevice::sequentialSource()
+{
+    const QByteArray data = testData();
+    QByteArray compressed = qCompress(data);
+    compressed.remove(0, 4); // qCompress() prefixes the size
+
+    // a sequential source that has not received everything yet, like a socket
+    class PartialSource : public QIODevice
+    {
+    public:
+        QByteArray received;
+
+        bool isSequential() const override { return true; }
+        qint64 bytesAvailable() const override
+        { return received.size() + QIODevice::bytesAvailable(); }
+
+    protected:
+        qint64 readData(char *data, qint64 maxlen) override
+        {
+            const qsizetype read = qMin(qsizetype(maxlen), received.size());
+            memcpy(data, received.constData(), read);
+            received.remove(0, read);
+            return read;
+        }
+        qint64 writeData(const char *, qint64) override { return -1; }
+    };
+    PartialSource source;
+    QVERIFY(source.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+
+    QDecompressingDevice decompressor(&source);
+    QVERIFY(decompressor.setEncoding("deflate"));
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+
+    QByteArray decompressed;
+    char chunk[1000];
+    for (qsizetype pos = 0; pos < compressed.size(); pos += 1000) {
+        source.received += compressed.mid(pos, 1000);
+        qint64 read;
+        while ((read = decompressor.read(chunk, sizeof(chunk))) > 0)
+            decompressed.append(chunk, read);
+        QCOMPARE(read, 0); // waiting for more
+    }
+    source.close();
+    QCOMPARE(decompressor.read(chunk, sizeof(chunk)), -1);
+    QCOMPARE(decompressed, data);
+}
+
+void tst_QCompressionDevice::corruptData()
+{
+    QByteArray garbage(1000, 'x');
+    QBuffer source(&garbage);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+
+    QDecompressingDevice decompressor(&source);
+    QVERIFY(decompressor.setEncoding("gzip"));
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    char chunk[100];
+    QCOMPARE(decompressor.read(chunk, sizeof(chunk)), -1);
+    QVERIFY(!decompressor.errorString().isEmpty());
+}
+
+void tst_QCompressionDevice::failingSink()
+{
+    // a sink that rejects everything once it is full, like a disk
+    class FullDevice : public QIODevice
+    {
+    public:
+        bool full = false;
+
+    protected:
+        qint64 readData(char *, qint64) override { return -1; }
+        qint64 writeData(const char *, qint64 len) override
+        {
+            if (!full)
+                return len;
+            setErrorString(QStringLiteral("No space left on device"));
+            return -1;
+        }
+    };
+    FullDevice sink;
+    QVERIFY(sink.open(QIODevice::WriteOnly | QIODevice::Unbuffered));
+
+    QCompressingDevice compressor(&sink);
+    QVERIFY(compressor.setEncoding("gzip"));
+    QVERIFY(compressor.open(QIODevice::WriteOnly));
+    // small enough to stay in the encoder until the stream is completed
+    QCOMPARE(compressor.write("data"), 4);
+    sink.full = true;
+    QVERIFY(!compressor.finish());
+    QVERIFY(compressor.errorString().contains("No space left on device"));
+    QVERIFY(!compressor.isOpen());
+
+    sink.full = false;
+    QVERIFY(compressor.open(QIODevice::WriteOnly));
+    QCOMPARE(compressor.write("data"), 4);
+    sink.full = true;
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QCompressingDevice::close: Failed to write compressed data: "
+                         "No space left on device");
+    compressor.close();
+}
+
+QTEST_MAIN(tst_QCompressionDevice)
+#include "tst_qcompressiondevice.moc"
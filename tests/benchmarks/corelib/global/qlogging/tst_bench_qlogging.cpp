@@ -0,0 +1,103 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QThread>
+#include <QtCore/private/qbinarylog_p.h>
+#include <QtCore/private/qlogging_p.h>
+
+#include <stdio.h>
+
+class tst_QLogging : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void throughput_data();
+    void throughput();
+
+private:
+    QTemporaryDir dir;
+};
+
+enum class Output { Sync, Async, Binary };
+Q_DECLARE_METATYPE(Output)
+
+void tst_QLogging::initTestCase()
+{
+    // measure the logging, not the terminal
+    qputenv("QT_FORCE_STDERR_LOGGING", "1");
+#ifdef Q_OS_WIN
+    if (!freopen("NUL", "w", stderr))
+#else
+    if (!freopen("/dev/null", "w", stderr))
+#endif
+        QSKIP("Could not redirect stderr");
+}
+
+void tst_QLogging::cleanup()
+{
+    QBinaryLogWriter::close();
+#ifdef QT_BUILD_INTERNAL
+    // disabling writes out what is still queued
+    QtPrivate::setAsyncMessageOutput(false);
+#endif
+}
+
+void tst_QLogging::throughput_data()
+{
+    QTest::addColumn<Output>("output");
+    QTest::addColumn<int>("threadCount");
+
+    QTest::addRow("sync, 1 thread") << Output::Sync << 1;
+    QTest::addRow("sync, 4 threads") << Output::Sync << 4;
+#ifdef QT_BUILD_INTERNAL
+    QTest::addRow("async, 1 thread") << Output::Async << 1;
+    QTest::addRow("async, 4 threads") << Output::Async << 4;
+#endif
+    QTest::addRow("binary, 1 thread") << Output::Binary << 1;
+    QTest::addRow("binary, 4 threads") << Output::Binary << 4;
+}
+
+void tst_QLogging::throughput()
+{
+    QFETCH(Output, output);
+    QFETCH(int, threadCount);
+#ifdef QT_BUILD_INTERNAL
+    QtPrivate::setAsyncMessageOutput(output == Output::Async);
+#endif
+    if (output == Output::Binary && !QBinaryLogWriter::open(dir.filePath("throughput.qlog")))
+        QSKIP("Could not open the binary log");
+
+    // measure the default output, not the message handler of QTestLog
+    const QtMessageHandler testMessageHandler = qInstallMessageHandler(nullptr);
+    const auto restoreMessageHandler = qScopeGuard([testMessageHandler] {
+        qInstallMessageHandler(testMessageHandler);
+    });
+
+    auto log = [] {
+        for (int i = 0; i < 1000; ++i)
+            qDebug("message %d of a logging throughput benchmark", i);
+    };
+
+    QBENCHMARK {
+        QList<QThread *> threads;
+        for (int i = 1; i < threadCount; ++i) {
+            threads.append(QThread::create(log));
+            threads.last()->start();
+        }
+        log();
+        for (QThread *thread : std::as_const(threads)) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+QTEST_MAIN(tst_QLogging)
+
+#include "tst_bench_qlogging.moc"
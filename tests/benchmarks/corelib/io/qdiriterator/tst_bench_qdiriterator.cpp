@@ -48,6 +48,8 @@ private slots:
     void diriterator_data() { data(); }
     void dirlisting();
     void dirlisting_data() { data(); }
+    void dirlistingFiltered();
+    void dirlistingFiltered_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
@@ -226,6 +228,29 @@ void tst_QDirIterator::dirlisting()
     qDebug() << count;
 }
 
+void tst_QDirIterator::dirlistingFiltered()
+{
+    QFETCH(QByteArray, dirpath);
+
+    using F = QDirListing::IteratorFlag;
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+
+        // needs the type of every entry, but nothing else
+        QDirListing dir(dirpath, F::Recursive | F::FilesOnly | F::ResolveSymlinks);
+
+        for (const auto &dirEntry : dir) {
+            const auto path = dirEntry.filePath();
+            ++c;
+        }
+        count = c;
+    }
+    qDebug() << count;
+}
+
 void tst_QDirIterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
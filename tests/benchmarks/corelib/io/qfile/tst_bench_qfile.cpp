@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QDebug>
+#include <QSaveFile>
 #include <QTemporaryFile>
 #include <QString>
 #include <QDirIterator>
@@ -81,6 +82,11 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+    void copy_data();
+    void copy();
+    void saveFile_data();
+    void saveFile();
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -170,6 +176,11 @@ void tst_qfile::readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t,
             flagstring += ' ';
         flagstring += "unbuffered";
     }
+    if (b & QIODevice::MemoryMapped) {
+        if (flagstring.size())
+            flagstring += ' ';
+        flagstring += "mapped";
+    }
     if (flagstring.isEmpty())
         flagstring = "none";
 
@@ -187,7 +198,8 @@ void tst_qfile::readBigFile_QFile_data()
     readFile_data(QFileBenchmark, QIODevice::NotOpen, QIODevice::Unbuffered);
     readFile_data(QFileBenchmark, QIODevice::Text, QIODevice::NotOpen);
     readFile_data(QFileBenchmark, QIODevice::Text, QIODevice::Unbuffered);
-
+    readFile_data(QFileBenchmark, QIODevice::NotOpen, QIODevice::MemoryMapped);
+    readFile_data(QFileBenchmark, QIODevice::Text, QIODevice::MemoryMapped);
 }
 
 void tst_qfile::readBigFile_QFSFileEngine_data()
@@ -458,7 +470,8 @@ void tst_qfile::readSmallFiles_QFile_data()
     readFile_data(QFileBenchmark, QIODevice::NotOpen, QIODevice::Unbuffered);
     readFile_data(QFileBenchmark, QIODevice::Text, QIODevice::NotOpen);
     readFile_data(QFileBenchmark, QIODevice::Text, QIODevice::Unbuffered);
-
+    readFile_data(QFileBenchmark, QIODevice::NotOpen, QIODevice::MemoryMapped);
+    readFile_data(QFileBenchmark, QIODevice::Text, QIODevice::MemoryMapped);
 }
 
 void tst_qfile::readSmallFiles_QFSFileEngine_data()
@@ -588,6 +601,54 @@ void tst_qfile::readSmallFiles()
     }
 }
 
+void tst_qfile::copy_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::newRow("small file") << tempDir.filePath(QStringLiteral("0"));
+    QTest::newRow("big file") << tempDir.filename;
+}
+
+void tst_qfile::copy()
+{
+    QFETCH(QString, fileName);
+    QTemporaryDir targetDir;
+    QVERIFY(targetDir.isValid());
+    const QString newName = targetDir.filePath(QStringLiteral("copy"));
+
+    QBENCHMARK {
+        QVERIFY(QFile::copy(fileName, newName));
+        QVERIFY(QFile::remove(newName));
+    }
+}
+
+void tst_qfile::saveFile_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("4 KB") << 4 * 1024;
+    QTest::newRow("1 MB") << 1024 * 1024;
+}
+
+void tst_qfile::saveFile()
+{
+    QFETCH(int, size);
+    QTemporaryDir targetDir;
+    QVERIFY(targetDir.isValid());
+    const QString fileName = targetDir.filePath(QStringLiteral("saved"));
+    const QByteArray data(size, 'a');
+
+    // replace an existing file, as in the common case
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    QBENCHMARK {
+        QSaveFile saveFile(fileName);
+        QVERIFY(saveFile.open(QIODevice::WriteOnly));
+        QCOMPARE(saveFile.write(data), size);
+        QVERIFY(saveFile.commit());
+    }
+}
+
 QTEST_MAIN(tst_qfile)
 
 #include "tst_bench_qfile.moc"
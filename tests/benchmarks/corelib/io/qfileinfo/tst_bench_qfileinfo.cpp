@@ -6,8 +6,12 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFileInfo>
 #include <QtCore/QFile>
+#include <QtCore/QDir>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QTemporaryDir>
 
 #include "private/qfsfileengine_p.h"
+#include "private/qfilesystemmetadatacache_p.h"
 #include "../../../../shared/filesystem.h"
 
 class tst_QFileInfo : public QObject
@@ -22,6 +26,11 @@ private slots:
 #endif
     void comparison_data();
     void comparison();
+#ifdef QT_FILESYSTEMMETADATACACHE
+    void sharedCache_data();
+    void sharedCache();
+#endif
+    void sortByTime();
 };
 
 void tst_QFileInfo::existsTemporary()
@@ -104,6 +113,58 @@ void tst_QFileInfo::comparison()
     }
 }
 
+#ifdef QT_FILESYSTEMMETADATACACHE
+void tst_QFileInfo::sharedCache_data()
+{
+    QTest::addColumn<bool>("enabled");
+    QTest::addRow("disabled") << false;
+    QTest::addRow("enabled") << true;
+}
+
+void tst_QFileInfo::sharedCache()
+{
+    QTemporaryDir tmpDir;
+    QVERIFY2(tmpDir.isValid(), qPrintable(tmpDir.errorString()));
+    QVERIFY(QDir(tmpDir.path()).mkpath("a/b/c/d"));
+    const QString dirPath = tmpDir.filePath("a/b/c/d");
+
+    QStringList files;
+    for (int i = 0; i < 100; ++i) {
+        QFile file(dirPath + "/file" + QString::number(i));
+        QVERIFY(file.open(QFile::WriteOnly));
+        files << file.fileName();
+    }
+
+    QFETCH(bool, enabled);
+    if (enabled && !QFileSystemMetaDataCache::setEnabled(true))
+        QSKIP("Could not enable the shared metadata cache");
+    auto cleanup = qScopeGuard([] { QFileSystemMetaDataCache::setEnabled(false); });
+
+    QBENCHMARK {
+        for (const QString &file : files) {
+            QFileInfo info(file);
+            [[maybe_unused]] auto r = info.size() + info.isReadable();
+        }
+    }
+}
+#endif
+
+void tst_QFileInfo::sortByTime()
+{
+    QTemporaryDir tmpDir;
+    QVERIFY2(tmpDir.isValid(), qPrintable(tmpDir.errorString()));
+    for (int i = 0; i < 1000; ++i) {
+        QFile file(tmpDir.filePath("file" + QString::number(i)));
+        QVERIFY(file.open(QFile::WriteOnly));
+    }
+
+    QDir dir(tmpDir.path());
+    QBENCHMARK {
+        dir.refresh();
+        QCOMPARE(dir.entryInfoList(QDir::Files, QDir::Time).size(), 1000);
+    }
+}
+
 QTEST_MAIN(tst_QFileInfo)
 
 #include "tst_bench_qfileinfo.moc"
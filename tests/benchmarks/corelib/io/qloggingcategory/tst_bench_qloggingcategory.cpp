@@ -0,0 +1,113 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QThread>
+
+#include <memory>
+#include <vector>
+
+class tst_QLoggingCategory : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void registration_data();
+    void registration();
+    void setFilterRules_data();
+    void setFilterRules();
+
+private:
+    QList<QByteArray> names;
+};
+
+static QList<QByteArray> categoryNames(int count)
+{
+    QList<QByteArray> names;
+    names.reserve(count);
+    for (int i = 0; i < count; ++i)
+        names.append("plugin." + QByteArray::number(i % 100) + ".category" + QByteArray::number(i));
+    return names;
+}
+
+void tst_QLoggingCategory::init()
+{
+    QLoggingCategory::setFilterRules("plugin.*.warning=false\nplugin.7*.critical=false");
+}
+
+void tst_QLoggingCategory::cleanup()
+{
+    QLoggingCategory::setFilterRules(QString());
+}
+
+void tst_QLoggingCategory::registration_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    QTest::addRow("1 thread") << 1;
+    QTest::addRow("4 threads") << 4;
+}
+
+void tst_QLoggingCategory::registration()
+{
+    QFETCH(int, threadCount);
+    names = categoryNames(4000);
+
+    // every thread creates and destroys its share of the categories
+    auto create = [this, threadCount](int thread) {
+        std::vector<std::unique_ptr<QLoggingCategory>> categories;
+        for (qsizetype i = thread; i < names.size(); i += threadCount)
+            categories.push_back(std::make_unique<QLoggingCategory>(names.at(i).constData()));
+    };
+
+    QBENCHMARK {
+        QList<QThread *> threads;
+        for (int i = 1; i < threadCount; ++i) {
+            threads.append(QThread::create(create, i));
+            threads.last()->start();
+        }
+        create(0);
+        for (QThread *thread : std::as_const(threads)) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+void tst_QLoggingCategory::setFilterRules_data()
+{
+    QTest::addColumn<int>("categoryCount");
+    QTest::addColumn<QString>("rule");
+
+    // the rule is toggled, in addition to the ones set by init()
+    QTest::addRow("1000 categories, one matching") << 1000 << "plugin.42.category42.debug=false";
+    QTest::addRow("10000 categories, one matching") << 10000 << "plugin.42.category42.debug=false";
+    QTest::addRow("10000 categories, 100 matching") << 10000 << "plugin.42.*.debug=false";
+    QTest::addRow("10000 categories, all matching") << 10000 << "plugin.*.debug=false";
+}
+
+void tst_QLoggingCategory::setFilterRules()
+{
+    QFETCH(int, categoryCount);
+    QFETCH(QString, rule);
+    names = categoryNames(categoryCount);
+
+    std::vector<std::unique_ptr<QLoggingCategory>> categories;
+    for (const QByteArray &name : std::as_const(names))
+        categories.push_back(std::make_unique<QLoggingCategory>(name.constData()));
+
+    const QString rules = QStringLiteral("plugin.*.warning=false\nplugin.7*.critical=false");
+    const QString toggledRules = rules + u'\n' + rule;
+    bool toggled = false;
+    QBENCHMARK {
+        toggled = !toggled;
+        QLoggingCategory::setFilterRules(toggled ? toggledRules : rules);
+    }
+}
+
+QTEST_MAIN(tst_QLoggingCategory)
+
+#include "tst_bench_qloggingcategory.moc"
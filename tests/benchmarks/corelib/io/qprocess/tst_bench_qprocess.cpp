@@ -5,6 +5,7 @@
 #include <QSignalSpy>
 #include <QtCore/QProcess>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
 
 class tst_QProcess : public QObject
 {
@@ -13,6 +14,8 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void spawnRate_data();
+    void spawnRate();
 };
 
 #ifdef Q_OS_WIN
@@ -66,5 +69,50 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::spawnRate_data()
+{
+    QTest::addColumn<bool>("useEventLoop");
+    QTest::addColumn<bool>("useModifier");
+
+    QTest::newRow("blocking") << false << false;
+    QTest::newRow("event-loop") << true << false;
+#ifdef Q_OS_UNIX
+    // a child process modifier needs our code to run in the child, so this
+    // measures the fork() path
+    QTest::newRow("blocking-modifier") << false << true;
+#endif
+}
+
+void tst_QProcess::spawnRate()
+{
+    QFETCH(bool, useEventLoop);
+    QFETCH(bool, useModifier);
+    const QString program = QFINDTESTDATA("../testProcessLoopback/testProcessLoopback" EXE);
+    constexpr int Count = 100;
+
+    QBENCHMARK {
+        for (int i = 0; i < Count; ++i) {
+            QProcess process;
+#ifdef Q_OS_UNIX
+            if (useModifier)
+                process.setChildProcessModifier([] {});
+#else
+            Q_UNUSED(useModifier);
+#endif
+            process.start(program);
+            // the loopback program exits when its stdin is closed
+            process.closeWriteChannel();
+            if (useEventLoop) {
+                QEventLoop loop;
+                connect(&process, &QProcess::finished, &loop, &QEventLoop::quit);
+                loop.exec();
+            } else {
+                QVERIFY(process.waitForFinished());
+            }
+            QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+        }
+    }
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
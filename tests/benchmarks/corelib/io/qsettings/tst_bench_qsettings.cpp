@@ -0,0 +1,121 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <private/qsettings_p.h>
+
+class tst_QSettings : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanup();
+    void startup_data();
+    void startup();
+    void sync_data();
+    void sync();
+
+private:
+    void setCacheEnabled(bool enabled);
+
+    QTemporaryDir dir;
+    QString fileName;
+};
+
+static constexpr int GroupCount = 500;
+static constexpr int KeyCount = 100;
+
+void tst_QSettings::initTestCase()
+{
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    fileName = dir.filePath(QStringLiteral("large.ini"));
+
+    // about 4 MB, the size of a large fleet-wide configuration file
+    QSettings settings(fileName, QSettings::IniFormat);
+    for (int group = 0; group < GroupCount; ++group) {
+        settings.beginGroup(QStringLiteral("group%1").arg(group));
+        for (int key = 0; key < KeyCount; ++key) {
+            settings.setValue(QStringLiteral("key%1").arg(key),
+                              QStringLiteral("value %1 of group %2, with some escaping: \"%3\"")
+                                      .arg(key).arg(group).arg(QString(40, u'x')));
+        }
+        settings.endGroup();
+    }
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+}
+
+void tst_QSettings::cleanup()
+{
+    qunsetenv("QT_SETTINGS_INI_CACHE");
+    QConfFile::clearCache();
+}
+
+void tst_QSettings::setCacheEnabled(bool enabled)
+{
+    if (enabled)
+        qputenv("QT_SETTINGS_INI_CACHE", "1");
+    else
+        qunsetenv("QT_SETTINGS_INI_CACHE");
+    QConfFile::clearCache();
+}
+
+void tst_QSettings::startup_data()
+{
+    QTest::addColumn<bool>("useCache");
+
+    QTest::newRow("parse") << false;
+    QTest::newRow("cache") << true;
+}
+
+// what an application does at startup: open the file and read a few keys
+void tst_QSettings::startup()
+{
+    QFETCH(bool, useCache);
+    setCacheEnabled(useCache);
+    {
+        // let the first reader compile the cache
+        QSettings settings(fileName, QSettings::IniFormat);
+    }
+
+    QBENCHMARK {
+        QConfFile::clearCache();
+        QSettings settings(fileName, QSettings::IniFormat);
+        for (int i = 0; i < 100; ++i) {
+            const int group = (i * 37) % GroupCount;
+            const QString value = settings.value(QStringLiteral("group%1/key%2")
+                                                         .arg(group).arg(i % KeyCount)).toString();
+            QVERIFY(!value.isEmpty());
+        }
+    }
+}
+
+void tst_QSettings::sync_data()
+{
+    QTest::addColumn<bool>("useCache");
+
+    QTest::newRow("rewrite") << false;
+    QTest::newRow("journal") << true;
+}
+
+// changing a single key: a full rewrite without the cache, a journal
+// record (and now and then folding the journal into the file) with it
+void tst_QSettings::sync()
+{
+    QFETCH(bool, useCache);
+    setCacheEnabled(useCache);
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    int i = 0;
+    QBENCHMARK {
+        settings.setValue(QStringLiteral("group0/key0"), i++);
+        settings.sync();
+    }
+    QCOMPARE(settings.status(), QSettings::NoError);
+}
+
+QTEST_MAIN(tst_QSettings)
+#include "tst_bench_qsettings.moc"
@@ -13,6 +13,8 @@ class tst_QTextStream : public QObject
 private slots:
     void writeSingleChar_data();
     void writeSingleChar();
+    void readLine_data();
+    void readLine();
 
 private:
 };
@@ -90,6 +92,64 @@ void tst_QTextStream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+enum ReadMethod { ReadLine, ReadLineInto, ReadLineView };
+Q_DECLARE_METATYPE(ReadMethod);
+
+void tst_QTextStream::readLine_data()
+{
+    QTest::addColumn<ReadMethod>("method");
+    QTest::addColumn<int>("lineLength");
+
+    for (int lineLength : {16, 100, 1000}) {
+        QTest::addRow("readLine_%d", lineLength) << ReadLine << lineLength;
+        QTest::addRow("readLineInto_%d", lineLength) << ReadLineInto << lineLength;
+        QTest::addRow("readLineView_%d", lineLength) << ReadLineView << lineLength;
+    }
+}
+
+void tst_QTextStream::readLine()
+{
+    QFETCH(ReadMethod, method);
+    QFETCH(int, lineLength);
+
+    const int lineCount = 8 * 1024 * 1024 / (lineLength + 1);
+    QByteArray data = QByteArray(lineLength, 'x').append('\n').repeated(lineCount);
+    QBuffer buffer(&data);
+
+    QBENCHMARK {
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        int lines = 0;
+        qsizetype characters = 0;
+        switch (method) {
+        case ReadLine:
+            for (QString line = stream.readLine(); !line.isNull(); line = stream.readLine()) {
+                characters += line.size();
+                ++lines;
+            }
+            break;
+        case ReadLineInto: {
+            QString line;
+            while (stream.readLineInto(&line)) {
+                characters += line.size();
+                ++lines;
+            }
+            break;
+        }
+        case ReadLineView:
+            for (QStringView line = stream.readLineView(); !line.isNull();
+                 line = stream.readLineView()) {
+                characters += line.size();
+                ++lines;
+            }
+            break;
+        }
+        QCOMPARE(lines, lineCount);
+        QCOMPARE(characters, qsizetype(lineCount) * lineLength);
+        buffer.close();
+    }
+}
+
 QTEST_MAIN(tst_QTextStream)
 
 #include "tst_bench_qtextstream.moc"
@@ -0,0 +1,107 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QBuffer>
+#include <QTest>
+
+#include <private/qzipreader_p.h>
+#include <private/qzipwriter_p.h>
+
+class tst_QZip : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void write_data();
+    void write();
+    void readFileData_data() { write_data(); }
+    void readFileData();
+    void readFileDevice_data() { write_data(); }
+    void readFileDevice();
+
+private:
+    QByteArray archive(int fileSize);
+
+    QByteArray contents;
+};
+
+void tst_QZip::initTestCase()
+{
+    // compresses about 4:1, like text and object files tend to
+    quint32 seed = 1;
+    contents.reserve(64 * 1024 * 1024);
+    for (int i = 0; contents.size() < 64 * 1024 * 1024; ++i) {
+        seed = seed * 1103515245 + 12345;
+        contents += "record " + QByteArray::number(i) + " value "
+                + QByteArray::number(seed >> 8, 16) + '\n';
+    }
+}
+
+QByteArray tst_QZip::archive(int fileSize)
+{
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    for (qsizetype pos = 0; pos < contents.size(); pos += fileSize)
+        writer.addFile(QString::number(pos), contents.mid(pos, fileSize));
+    writer.close();
+    return buffer.buffer();
+}
+
+void tst_QZip::write_data()
+{
+    QTest::addColumn<int>("fileSize");
+
+    QTest::newRow("64KiB") << 64 * 1024;
+    QTest::newRow("1MiB") << 1024 * 1024;
+    QTest::newRow("64MiB") << 64 * 1024 * 1024;
+}
+
+void tst_QZip::write()
+{
+    QFETCH(int, fileSize);
+
+    QBENCHMARK {
+        QByteArray zip = archive(fileSize);
+        QVERIFY(!zip.isEmpty());
+    }
+}
+
+void tst_QZip::readFileData()
+{
+    QFETCH(int, fileSize);
+    QByteArray zip = archive(fileSize);
+
+    QBENCHMARK {
+        QBuffer buffer(&zip);
+        QZipReader reader(&buffer);
+        qint64 total = 0;
+        for (const QZipReader::FileInfo &info : reader.fileInfoList())
+            total += reader.fileData(info.filePath).size();
+        QCOMPARE(total, qint64(contents.size()));
+    }
+}
+
+void tst_QZip::readFileDevice()
+{
+    QFETCH(int, fileSize);
+    QByteArray zip = archive(fileSize);
+    QByteArray chunk(64 * 1024, Qt::Uninitialized);
+
+    QBENCHMARK {
+        QBuffer buffer(&zip);
+        QZipReader reader(&buffer);
+        qint64 total = 0;
+        for (const QZipReader::FileInfo &info : reader.fileInfoList()) {
+            const std::unique_ptr<QIODevice> entry = reader.fileDevice(info.filePath);
+            QVERIFY(entry);
+            qint64 read;
+            while ((read = entry->read(chunk.data(), chunk.size())) > 0)
+                total += read;
+        }
+        QCOMPARE(total, qint64(contents.size()));
+    }
+}
+
+QTEST_MAIN(tst_QZip)
+
+#include "tst_bench_qzip.moc"
@@ -5,6 +5,8 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#include <private/qeventloopprofiler_p.h>
+
 class PingPong : public QObject
 {
 public:
@@ -94,31 +96,38 @@ void EventsBench::noEvent()
 void EventsBench::sendEvent_data()
 {
     QTest::addColumn<bool>("filterEvents");
-    QTest::newRow("no eventfilter") << false;
-    QTest::newRow("eventfilter") << true;
+    QTest::addColumn<bool>("profile");
+    QTest::newRow("no eventfilter") << false << false;
+    QTest::newRow("eventfilter") << true << false;
+    QTest::newRow("no eventfilter, profiler") << false << true;
 }
 
 void EventsBench::sendEvent()
 {
     QFETCH(bool, filterEvents);
+    QFETCH(bool, profile);
     EventTester tst;
     if (filterEvents)
         tst.installEventFilter(this);
+    QEventLoopProfiler::setEnabled(profile);
     QEvent evt(QEvent::Type(QEvent::User+1));
     QBENCHMARK {
         QCoreApplication::sendEvent(&tst, &evt);
     }
+    QEventLoopProfiler::setEnabled(false);
 }
 
 void EventsBench::postEvent_data()
 {
     QTest::addColumn<bool>("filterEvents");
+    QTest::addColumn<bool>("profile");
     // The first time an eventloop is executed, the case runs radically slower at least
     // on some platforms, so test the "no eventfilter" case to get a comparable results
     // with the "eventfilter" case.
-    QTest::newRow("first time, no eventfilter") << false;
-    QTest::newRow("no eventfilter") << false;
-    QTest::newRow("eventfilter") << true;
+    QTest::newRow("first time, no eventfilter") << false << false;
+    QTest::newRow("no eventfilter") << false << false;
+    QTest::newRow("eventfilter") << true << false;
+    QTest::newRow("no eventfilter, profiler") << false << true;
 }
 
 void EventsBench::postEvent()
@@ -132,6 +141,8 @@ void EventsBench::postEvent()
         ping.installEventFilter(this);
         pong.installEventFilter(this);
     }
+    QFETCH(bool, profile);
+    QEventLoopProfiler::setEnabled(profile);
 
     QBENCHMARK {
         // In case multiple iterations are done, event needs to be created inside the QBENCHMARK,
@@ -143,6 +154,7 @@ void EventsBench::postEvent()
         QCoreApplication::postEvent(&ping, e);
         QTestEventLoop::instance().enterLoop( 61 );
     }
+    QEventLoopProfiler::setEnabled(false);
 }
 
 QTEST_MAIN(EventsBench)
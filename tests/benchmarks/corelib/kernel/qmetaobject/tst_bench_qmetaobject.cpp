@@ -94,6 +94,8 @@ private slots:
     void indexOfSignal();
     void indexOfSlot_data();
     void indexOfSlot();
+    void indexOfSignalInLargeClass_data();
+    void indexOfSignalInLargeClass();
 
     void unconnected_data();
     void unconnected();
@@ -186,6 +188,25 @@ void tst_QMetaObject::indexOfSlot()
     }
 }
 
+void tst_QMetaObject::indexOfSignalInLargeClass_data()
+{
+    QTest::addColumn<QByteArray>("signal");
+    QTest::newRow("first") << QByteArray("extraSignal1()");
+    QTest::newRow("last") << QByteArray("extraSignal70()");
+    QTest::newRow("inherited") << QByteArray("destroyed(QObject*)");
+    QTest::newRow("missing") << QByteArray("extraSignal11()");
+}
+
+void tst_QMetaObject::indexOfSignalInLargeClass()
+{
+    QFETCH(QByteArray, signal);
+    const char *p = signal.constData();
+    const QMetaObject *mo = &LotsOfSignals::staticMetaObject;
+    QBENCHMARK {
+        (void)mo->indexOfSignal(p);
+    }
+}
+
 void tst_QMetaObject::unconnected_data()
 {
     QTest::addColumn<int>("signal_index");
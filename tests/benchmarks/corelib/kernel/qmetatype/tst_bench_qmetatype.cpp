@@ -3,6 +3,10 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <vector>
 
 class tst_QMetaType : public QObject
 {
@@ -23,6 +27,10 @@ private slots:
     void typeCustomNotNormalized();
     void typeNotRegistered();
     void typeNotRegisteredNotNormalized();
+    void typeCustomThreads_data();
+    void typeCustomThreads();
+    void canConvertCustomThreads_data();
+    void canConvertCustomThreads();
 
     void typeNameBuiltin_data();
     void typeNameBuiltin();
@@ -148,6 +156,58 @@ void tst_QMetaType::typeNotRegisteredNotNormalized()
     }
 }
 
+// Runs function in threadCount threads at the same time
+template <typename Function>
+static void runInThreads(int threadCount, Function function)
+{
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 1; i < threadCount; ++i) {
+        threads.emplace_back(QThread::create(function));
+        threads.back()->start();
+    }
+    function();
+    for (const auto &thread : threads)
+        thread->wait();
+}
+
+void tst_QMetaType::typeCustomThreads_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void tst_QMetaType::typeCustomThreads()
+{
+    QFETCH(int, threadCount);
+    qRegisterMetaType<Foo>("Foo");
+    QBENCHMARK {
+        runInThreads(threadCount, [] {
+            for (int i = 0; i < 10000; ++i)
+                QMetaType::fromName("Foo");
+        });
+    }
+}
+
+struct Baz { int i; };
+
+void tst_QMetaType::canConvertCustomThreads_data()
+{
+    typeCustomThreads_data();
+}
+
+void tst_QMetaType::canConvertCustomThreads()
+{
+    QFETCH(int, threadCount);
+    QMetaType::registerConverter<Foo, Baz>([](const Foo &foo) { return Baz{ foo.i }; });
+    QBENCHMARK {
+        runInThreads(threadCount, [] {
+            for (int i = 0; i < 10000; ++i)
+                QMetaType::canConvert(QMetaType::fromType<Foo>(), QMetaType::fromType<Baz>());
+        });
+    }
+}
+
 void tst_QMetaType::typeNameBuiltin_data()
 {
     QTest::addColumn<int>("type");
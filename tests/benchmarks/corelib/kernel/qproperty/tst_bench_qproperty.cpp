@@ -8,6 +8,9 @@
 
 #include "propertytester.h"
 
+#include <memory>
+#include <vector>
+
 class tst_QProperty : public QObject
 {
     Q_OBJECT
@@ -26,8 +29,37 @@ private slots:
     void cppNotifyingReadOnce();
     void cppNotifyingDirect();
     void cppNotifyingDirectReadOnce();
+
+    void layeredBindings_data();
+    void layeredBindings();
+    void groupedUpdate_data();
+    void groupedUpdate();
 };
 
+using Layer = std::vector<std::unique_ptr<QProperty<int>>>;
+
+// Returns depth layers of width properties, each bound to the sum of the
+// properties of the previous layer, the first one to the sum of sources
+static std::vector<Layer> makeLayers(const Layer &sources, int width, int depth)
+{
+    std::vector<Layer> layers(depth);
+    const Layer *previous = &sources;
+    for (Layer &layer : layers) {
+        for (int i = 0; i < width; ++i) {
+            auto property = std::make_unique<QProperty<int>>();
+            property->setBinding([previous] {
+                int sum = 0;
+                for (const auto &dependency : *previous)
+                    sum += dependency->value();
+                return sum;
+            });
+            layer.push_back(std::move(property));
+        }
+        previous = &layer;
+    }
+    return layers;
+}
+
 void tst_QProperty::cppOldBinding()
 {
     QScopedPointer<PropertyTester> tester {new PropertyTester};
@@ -202,6 +234,61 @@ void tst_QProperty::cppNotifyingDirectReadOnce()
     QCOMPARE(tester->yNotified.value(), i);
 }
 
+void tst_QProperty::layeredBindings_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("depth");
+
+    QTest::newRow("chain") << 1 << 16;
+    QTest::newRow("2 wide") << 2 << 8;
+    QTest::newRow("4 wide") << 4 << 4;
+}
+
+void tst_QProperty::layeredBindings()
+{
+    QFETCH(int, width);
+    QFETCH(int, depth);
+
+    Layer sources;
+    sources.push_back(std::make_unique<QProperty<int>>(0));
+    const std::vector<Layer> layers = makeLayers(sources, width, depth);
+    int i = 0;
+    QBENCHMARK {
+        *sources.front() = ++i;
+    }
+    int expected = i;
+    for (int j = 1; j < depth; ++j)
+        expected *= width;
+    QCOMPARE(layers.back().front()->value(), expected);
+}
+
+void tst_QProperty::groupedUpdate_data()
+{
+    QTest::addColumn<int>("sourceCount");
+
+    QTest::newRow("1 source") << 1;
+    QTest::newRow("4 sources") << 4;
+    QTest::newRow("16 sources") << 16;
+}
+
+void tst_QProperty::groupedUpdate()
+{
+    QFETCH(int, sourceCount);
+
+    Layer sources;
+    for (int j = 0; j < sourceCount; ++j)
+        sources.push_back(std::make_unique<QProperty<int>>(0));
+    const std::vector<Layer> layers = makeLayers(sources, 2, 2);
+    int i = 0;
+    QBENCHMARK {
+        const QScopedPropertyUpdateGroup guard;
+        ++i;
+        for (const auto &source : sources)
+            *source = i;
+    }
+    QCOMPARE(layers.back().front()->value(), i * sourceCount * 2);
+}
+
 QTEST_MAIN(tst_QProperty)
 
 #include "tst_bench_qproperty.moc"
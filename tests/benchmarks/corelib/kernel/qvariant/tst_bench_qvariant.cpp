@@ -27,6 +27,8 @@ private slots:
     void doubleVariantCreation();
     void floatVariantCreation();
     void rectVariantCreation();
+    void rectFVariantCreation();
+    void lineFVariantCreation();
     void stringVariantCreation();
 #ifdef QT_GUI_LIB
     void pixmapVariantCreation();
@@ -54,8 +56,12 @@ private slots:
     void doubleVariantValue();
     void floatVariantValue();
     void rectVariantValue();
+    void rectFVariantValue();
     void stringVariantValue();
 
+    void convert_data();
+    void convert();
+
     void createCoreType_data();
     void createCoreType();
     void createCoreTypeCopy_data();
@@ -148,6 +154,16 @@ void tst_QVariant::rectVariantCreation()
     variantCreation<QRect>(QRect(1, 2, 3, 4));
 }
 
+void tst_QVariant::rectFVariantCreation()
+{
+    variantCreation<QRectF>(QRectF(1, 2, 3, 4));
+}
+
+void tst_QVariant::lineFVariantCreation()
+{
+    variantCreation<QLineF>(QLineF(1, 2, 3, 4));
+}
+
 void tst_QVariant::stringVariantCreation()
 {
     variantCreation<QString>(QString());
@@ -298,6 +314,16 @@ void tst_QVariant::rectVariantValue()
     }
 }
 
+void tst_QVariant::rectFVariantValue()
+{
+    QVariant v(QRectF(1, 2, 3, 4));
+    QBENCHMARK {
+        for(int i = 0; i < ITERATION_COUNT; ++i) {
+            v.toRectF();
+        }
+    }
+}
+
 void tst_QVariant::stringVariantValue()
 {
     QVariant v = QString();
@@ -308,6 +334,31 @@ void tst_QVariant::stringVariantValue()
     }
 }
 
+void tst_QVariant::convert_data()
+{
+    QTest::addColumn<QVariant>("value");
+    QTest::addColumn<QMetaType>("targetType");
+
+    QTest::newRow("int->double") << QVariant(42) << QMetaType::fromType<double>();
+    QTest::newRow("double->int") << QVariant(42.0) << QMetaType::fromType<int>();
+    QTest::newRow("string->int") << QVariant(QStringLiteral("42")) << QMetaType::fromType<int>();
+    QTest::newRow("int->string") << QVariant(42) << QMetaType::fromType<QString>();
+    QTest::newRow("rect->rectf") << QVariant(QRect(1, 2, 3, 4)) << QMetaType::fromType<QRectF>();
+    QTest::newRow("rectf->rect") << QVariant(QRectF(1, 2, 3, 4)) << QMetaType::fromType<QRect>();
+}
+
+void tst_QVariant::convert()
+{
+    QFETCH(QVariant, value);
+    QFETCH(QMetaType, targetType);
+    QBENCHMARK {
+        for (int i = 0; i < ITERATION_COUNT; ++i) {
+            QVariant v = value;
+            v.convert(targetType);
+        }
+    }
+}
+
 void tst_QVariant::createCoreType_data()
 {
     QTest::addColumn<int>("typeId");
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QTest>
+#include <QDir>
 #include <QMimeDatabase>
 
 using namespace Qt::StringLiterals;
@@ -47,6 +48,10 @@ private slots:
     void benchMimeTypeForName();
     void benchMimeTypeForFile_data();
     void benchMimeTypeForFile();
+    void benchMimeTypeForData_data();
+    void benchMimeTypeForData();
+    void benchMimeTypesForFiles_data();
+    void benchMimeTypesForFiles();
 };
 
 void tst_QMimeDatabase::inheritsPerformance()
@@ -141,6 +146,77 @@ void tst_QMimeDatabase::benchMimeTypeForFile()
     }
 }
 
+void tst_QMimeDatabase::benchMimeTypeForData_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QString>("expectedMimeName");
+
+    const auto addDataRow = [](const char *tag, const QString &fileName,
+                               const QString &expectedMimeName) {
+        QFile file(QFINDTESTDATA("files/" + fileName));
+        QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(file.errorString()));
+        QTest::newRow(tag) << file.read(16384) << expectedMimeName;
+    };
+    addDataRow("archive", "N.tar.gz", "application/gzip");
+    addDataRow("C", "X", "text/x-csrc");
+    addDataRow("patch", "y", "text/x-patch");
+    addDataRow("text", "u.txt", "text/plain");
+    QTest::newRow("unknown binary") << QByteArray(64, '\x01') << "application/octet-stream";
+}
+
+void tst_QMimeDatabase::benchMimeTypeForData()
+{
+    QFETCH(const QByteArray, data);
+    QFETCH(const QString, expectedMimeName);
+
+    QMimeDatabase db;
+
+    QBENCHMARK {
+        const auto mimeType = db.mimeTypeForData(data);
+        QCOMPARE(mimeType.name(), expectedMimeName);
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypesForFiles_data()
+{
+    QTest::addColumn<QMimeDatabase::MatchMode>("mode");
+    QTest::addColumn<bool>("batch");
+
+    for (const MatchModeInfo &info : matchModes) {
+        QTest::addRow("%s - loop", info.name) << info.mode << false;
+        QTest::addRow("%s - batch", info.name) << info.mode << true;
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypesForFiles()
+{
+    QFETCH(const QMimeDatabase::MatchMode, mode);
+    QFETCH(const bool, batch);
+
+    const QString filesDir = QFINDTESTDATA("files");
+    QVERIFY(!filesDir.isEmpty());
+    const QFileInfoList entries = QDir(filesDir).entryInfoList(QDir::Files);
+    QStringList fileNames;
+    for (int i = 0; i < 100; ++i) {
+        for (const QFileInfo &entry : entries)
+            fileNames << entry.filePath();
+    }
+
+    QMimeDatabase db;
+
+    QBENCHMARK {
+        if (batch) {
+            const QList<QMimeType> mimeTypes = db.mimeTypesForFiles(fileNames, mode);
+            QCOMPARE(mimeTypes.size(), fileNames.size());
+        } else {
+            QList<QMimeType> mimeTypes;
+            for (const QString &fileName : std::as_const(fileNames))
+                mimeTypes << db.mimeTypeForFile(fileName, mode);
+            QCOMPARE(mimeTypes.size(), fileNames.size());
+        }
+    }
+}
+
 QTEST_MAIN(tst_QMimeDatabase)
 
 #include "tst_bench_qmimedatabase.moc"
@@ -0,0 +1,110 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QBuffer>
+#include <QXmlStreamReader>
+
+#include <QTest>
+
+using namespace Qt::StringLiterals;
+
+class tst_QXmlStream : public QObject
+{
+    Q_OBJECT
+private slots:
+    void readAll_data();
+    void readAll();
+    void readDevice_data() { readAll_data(); }
+    void readDevice();
+    void readAttributes();
+};
+
+static QByteArray textDocument(int elements, int textLength)
+{
+    const QByteArray text = QByteArray("Lorem ipsum dolor sit amet, consectetur adipiscing elit. ")
+                                    .repeated(textLength / 57 + 1).left(textLength);
+    QByteArray doc = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<feed>\n";
+    for (int i = 0; i < elements; ++i) {
+        doc += "    <entry id=\"" + QByteArray::number(i) + "\">\n        <title>";
+        doc += text;
+        doc += "</title>\n        <summary>";
+        doc += text;
+        doc += " &amp; more</summary>\n    </entry>\n";
+    }
+    doc += "</feed>\n";
+    return doc;
+}
+
+static QByteArray attributeDocument(int elements)
+{
+    QByteArray doc = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<records>\n";
+    for (int i = 0; i < elements; ++i) {
+        doc += "  <record name=\"item number " + QByteArray::number(i)
+             + "\" description=\"a rather long attribute value describing the record\""
+               " path=\"/usr/share/applications/some-application.desktop\"/>\n";
+    }
+    doc += "</records>\n";
+    return doc;
+}
+
+void tst_QXmlStream::readAll_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("short-text") << textDocument(10000, 16);
+    QTest::newRow("medium-text") << textDocument(2000, 256);
+    QTest::newRow("long-text") << textDocument(100, 16384);
+    QTest::newRow("attributes") << attributeDocument(10000);
+}
+
+void tst_QXmlStream::readAll()
+{
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        QXmlStreamReader reader(data);
+        qsizetype characters = 0;
+        while (!reader.atEnd()) {
+            if (reader.readNext() == QXmlStreamReader::Characters)
+                characters += reader.text().size();
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QVERIFY(characters > 0);
+    }
+}
+
+void tst_QXmlStream::readDevice()
+{
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QXmlStreamReader reader(&buffer);
+        while (!reader.atEnd())
+            reader.readNext();
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    }
+}
+
+void tst_QXmlStream::readAttributes()
+{
+    const QByteArray data = attributeDocument(10000);
+
+    QBENCHMARK {
+        QXmlStreamReader reader(data);
+        qsizetype length = 0;
+        while (reader.readNextStartElement()) {
+            while (reader.readNextStartElement()) {
+                length += reader.attributes().value("description"_L1).size();
+                reader.skipCurrentElement();
+            }
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QCOMPARE(length, qsizetype(10000 * 51));
+    }
+}
+
+QTEST_MAIN(tst_QXmlStream)
+
+#include "tst_bench_qxmlstream.moc"
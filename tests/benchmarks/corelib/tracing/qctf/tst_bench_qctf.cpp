@@ -0,0 +1,111 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThread>
+
+#include <private/qctf_p.h>
+
+#include <memory>
+#include <vector>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+// What tracegen generates for a tracepoint with an int argument
+TRACEPOINT_PROVIDER(qtbench);
+TRACEPOINT_PROVIDER(qtbenchfiltered);
+TRACEPOINT_EVENT(qtbench, qtbench_event, QStringLiteral("int32_t value;"), sizeof(qint32), false);
+TRACEPOINT_EVENT(qtbenchfiltered, qtbenchfiltered_event, QStringLiteral("int32_t value;"),
+                 sizeof(qint32), false);
+
+class tst_QCtf : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void traceEvent_data();
+    void traceEvent();
+    void traceFilteredEvent();
+    void dump();
+
+private:
+    QTemporaryDir m_location;
+};
+
+void tst_QCtf::initTestCase()
+{
+    QVERIFY(m_location.isValid());
+    QFile session(m_location.filePath(u"session.json"_s));
+    QVERIFY(session.open(QIODevice::WriteOnly));
+    session.write(R"({ "bench": [ "qtbench" ] })");
+    session.close();
+
+    // the trace library reads them when the first tracepoint is checked
+    qputenv("QTRACE_LOCATION", QFile::encodeName(m_location.path()));
+    qputenv("QTRACE_FLIGHT_RECORDER", "10");
+    if (!tracepoint_enabled(qtbench, qtbench_event))
+        QSKIP("The CTF tracing plugin could not be loaded");
+}
+
+void tst_QCtf::traceEvent_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void tst_QCtf::traceEvent()
+{
+    QFETCH(int, threadCount);
+    constexpr qint32 Iterations = 10000;
+
+    auto trace = [] {
+        for (qint32 i = 0; i < Iterations; ++i)
+            tracepoint(qtbench, qtbench_event, i);
+    };
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 1; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create(trace));
+            threads.back()->start();
+        }
+        trace();
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
+void tst_QCtf::traceFilteredEvent()
+{
+    QVERIFY(!tracepoint_enabled(qtbenchfiltered, qtbenchfiltered_event));
+    QBENCHMARK {
+        for (qint32 i = 0; i < 10000; ++i)
+            tracepoint(qtbenchfiltered, qtbenchfiltered_event, i);
+    }
+}
+
+void tst_QCtf::dump()
+{
+    for (qint32 i = 0; i < 100000; ++i)
+        tracepoint(qtbench, qtbench_event, i);
+
+    QBENCHMARK {
+        QVERIFY(_dump_flight_recorder());
+    }
+
+    const QDir ust(m_location.filePath(u"ust"_s));
+    QVERIFY(QFileInfo(ust.filePath(u"metadata"_s)).size() > 0);
+    QCOMPARE_GT(QFileInfo(ust.filePath(u"channel_0"_s)).size(), 0);
+}
+
+QTEST_MAIN(tst_QCtf)
+
+#include "tst_bench_qctf.moc"
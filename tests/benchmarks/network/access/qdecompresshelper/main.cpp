@@ -1,8 +1,11 @@
 // Copyright (C) 2020 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
+#include <QtNetwork/private/qcompressiondevice_p.h>
 #include <QtNetwork/private/qdecompresshelper_p.h>
 
+#include <QtCore/qbuffer.h>
+
 #include <QtTest/QTest>
 
 class tst_QDecompressHelper : public QObject
@@ -11,6 +14,10 @@ class tst_QDecompressHelper : public QObject
 private slots:
     void decompress_data();
     void decompress();
+    void decompressingDevice_data() { decompress_data(); }
+    void decompressingDevice();
+    void compressingDevice_data();
+    void compressingDevice();
 };
 
 void tst_QDecompressHelper::decompress_data()
@@ -67,6 +74,61 @@ void tst_QDecompressHelper::decompress()
     }
 }
 
+void tst_QDecompressHelper::decompressingDevice()
+{
+    QFETCH(QByteArray, encoding);
+    QFETCH(QString, fileName);
+
+    QFile file { fileName };
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray out(64 * 1024, Qt::Uninitialized);
+    QBENCHMARK {
+        file.seek(0);
+        QDecompressingDevice device(&file);
+        QVERIFY(device.setEncoding(encoding));
+        QVERIFY(device.open(QIODevice::ReadOnly));
+
+        qint64 bytes = 0;
+        qint64 bytesRead;
+        while ((bytesRead = device.read(out.data(), out.size())) > 0)
+            bytes += bytesRead;
+
+        QCOMPARE(bytes, 50 * 1024 * 1024);
+    }
+}
+
+void tst_QDecompressHelper::compressingDevice_data()
+{
+    QTest::addColumn<QByteArray>("encoding");
+
+    QTest::addRow("deflate") << QByteArray("deflate");
+    QTest::addRow("gzip") << QByteArray("gzip");
+#if QT_CONFIG(zstd)
+    QTest::addRow("zstandard") << QByteArray("zstd");
+#endif
+}
+
+void tst_QDecompressHelper::compressingDevice()
+{
+    QFETCH(QByteArray, encoding);
+
+    QByteArray data;
+    for (int i = 0; data.size() < 16 * 1024 * 1024; ++i)
+        data += "entry " + QByteArray::number(i) + ": " + QByteArray::number(i * 2654435761u, 16) + '\n';
+
+    QBENCHMARK {
+        QBuffer sink;
+        QVERIFY(sink.open(QIODevice::WriteOnly));
+        QCompressingDevice device(&sink);
+        QVERIFY(device.setEncoding(encoding));
+        QVERIFY(device.open(QIODevice::WriteOnly));
+        for (qsizetype pos = 0; pos < data.size(); pos += 64 * 1024)
+            device.write(data.constData() + pos, qMin(qsizetype(64 * 1024), data.size() - pos));
+        device.close();
+        QVERIFY(sink.size() > 0);
+    }
+}
+
 QTEST_MAIN(tst_QDecompressHelper)
 
 #include "main.moc"